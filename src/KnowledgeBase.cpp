@@ -1,5 +1,9 @@
 #include "KnowledgeBase.hpp"
 
+#include <algorithm>
+#include <functional>
+#include <sstream>
+#include <unordered_set>
 #include <base-logging/Logging.hpp>
 
 #include <factpp/Kernel.h>
@@ -14,6 +18,22 @@ using namespace owlapi::model;
 
 namespace owlapi {
 
+namespace {
+
+/// 64 bit FNV-1a hash, which -- unlike std::hash -- is stable across
+/// builds, so that it can be used for persisted data
+uint64_t fnv1a(const char* data, size_t size, uint64_t hash = 14695981039346656037ULL)
+{
+    for(size_t i = 0; i < size; ++i)
+    {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+} // end anonymous namespace
+
 std::map<KnowledgeBase::PropertyType, std::string> KnowledgeBase::PropertyTypeTxt = {
     { KnowledgeBase::UNKNOWN_PROPERTY_TYPE, "UNKNOWN PROPERTY TYPE"},
     { KnowledgeBase::OBJECT, "OBJECT"},
@@ -66,75 +86,100 @@ const TExpressionManager* KnowledgeBase::getExpressionManager() const
     return mKernel->getExpressionManager();
 }
 
-ClassExpression KnowledgeBase::getClass(const IRI& klass) const
+ClassExpression KnowledgeBase::tryGetClass(const IRI& klass) const
 {
     IRIClassExpressionMap::const_iterator cit = mClasses.find(klass);
     if(cit == mClasses.end())
     {
-        throw std::invalid_argument("KnowledgeBase::getClass: Class '" + klass.toString() + "' does not exist");
+        return ClassExpression();
     }
-
     return cit->second;
 }
 
+ClassExpression KnowledgeBase::getClass(const IRI& klass) const
+{
+    ClassExpression expression = tryGetClass(klass);
+    if(!expression.get())
+    {
+        throw std::invalid_argument("KnowledgeBase::getClass: Class '" + klass.toString() + "' does not exist");
+    }
+    return expression;
+}
+
 ClassExpression KnowledgeBase::getClassLazy(const IRI& klass)
 {
-    try {
-        return getClass(klass);
-    } catch(const std::invalid_argument& e)
+    ClassExpression expression = tryGetClass(klass);
+    if(!expression.get())
     {
-        TDLConceptExpression* f_class = getExpressionManager()->Concept(klass.toString());
-        ClassExpression expression(f_class);
+        TDLConceptExpression* f_expression = getExpressionManager()->Concept(klass.toString());
+        expression = ClassExpression(f_expression);
         mClasses[klass] = expression;
-        return expression;
     }
+    return expression;
 }
 
-InstanceExpression KnowledgeBase::getInstance(const IRI& instance) const
+InstanceExpression KnowledgeBase::tryGetInstance(const IRI& instance) const
 {
     IRIInstanceExpressionMap::const_iterator cit = mInstances.find(instance);
     if(cit == mInstances.end())
     {
-        throw std::invalid_argument("KnowledgeBase::getInstance: Instance '" + instance.toString() + "' does not exist");
+        return InstanceExpression();
     }
-
     return cit->second;
 }
 
+InstanceExpression KnowledgeBase::getInstance(const IRI& instance) const
+{
+    InstanceExpression expression = tryGetInstance(instance);
+    if(!expression.get())
+    {
+        throw std::invalid_argument("KnowledgeBase::getInstance: Instance '" + instance.toString() + "' does not exist");
+    }
+    return expression;
+}
+
 InstanceExpression KnowledgeBase::getInstanceLazy(const IRI& instance)
 {
-    try {
-        return getInstance(instance);
-    } catch(const std::invalid_argument& e)
+    InstanceExpression expression = tryGetInstance(instance);
+    if(!expression.get())
     {
-        TDLIndividualExpression* f_individual = getExpressionManager()->Individual(instance.toString());
-        InstanceExpression expression(f_individual);
+        TDLIndividualExpression* f_expression = getExpressionManager()->Individual(instance.toString());
+        expression = InstanceExpression(f_expression);
         mInstances[instance] = expression;
-        return expression;
     }
+    return expression;
 }
 
-ObjectPropertyExpression KnowledgeBase::getObjectProperty(const IRI& property) const
+ObjectPropertyExpression KnowledgeBase::tryGetObjectProperty(const IRI& property) const
 {
     IRIObjectPropertyExpressionMap::const_iterator cit = mObjectProperties.find(property);
     if(cit == mObjectProperties.end())
     {
-        throw std::invalid_argument("KnowledgeBase::getObjectProperty: ObjectProperty '" + property.toString() + "' does not exist");
+        return ObjectPropertyExpression();
     }
     return cit->second;
 }
 
+ObjectPropertyExpression KnowledgeBase::getObjectProperty(const IRI& property) const
+{
+    ObjectPropertyExpression expression = tryGetObjectProperty(property);
+    if(!expression.get())
+    {
+        throw std::invalid_argument("KnowledgeBase::getObjectProperty: ObjectProperty '" + property.toString() + "' does not exist");
+    }
+    return expression;
+}
+
 ObjectPropertyExpression KnowledgeBase::getObjectPropertyLazy(const IRI& property)
 {
-    try {
-        return getObjectProperty(property);
-    } catch(const std::invalid_argument& e)
+    ObjectPropertyExpression expression = tryGetObjectProperty(property);
+    if(!expression.get())
     {
-        TDLObjectRoleExpression* f_property = getExpressionManager()->ObjectRole(property.toString());
-        ObjectPropertyExpression expression(f_property);
+        TDLObjectRoleExpression* f_expression = getExpressionManager()->ObjectRole(property.toString());
+        expression = ObjectPropertyExpression(f_expression);
         mObjectProperties[property] = expression;
-        return expression;
     }
+    return expression;
 }
 
 IRIList KnowledgeBase::getObjectPropertyDomain(const IRI& property, bool direct) const
@@ -161,31 +206,44 @@ IRIList KnowledgeBase::getObjectPropertyRange(const IRI& property, bool direct)
     return getResult(actor);
 }
 
-DataPropertyExpression KnowledgeBase::getDataProperty(const IRI& property) const
+DataPropertyExpression KnowledgeBase::tryGetDataProperty(const IRI& property) const
 {
     IRIDataPropertyExpressionMap::const_iterator cit = mDataProperties.find(property);
     if(cit == mDataProperties.end())
     {
-        throw std::invalid_argument("KnowledgeBase::getDataProperty: DataProperty '" + property.toString() + "' does not exist");
+        return DataPropertyExpression();
     }
     return cit->second;
 }
 
+DataPropertyExpression KnowledgeBase::getDataProperty(const IRI& property) const
+{
+    DataPropertyExpression expression = tryGetDataProperty(property);
+    if(!expression.get())
+    {
+        throw std::invalid_argument("KnowledgeBase::getDataProperty: DataProperty '" + property.toString() + "' does not exist");
+    }
+    return expression;
+}
+
 DataPropertyExpression KnowledgeBase::getDataPropertyLazy(const IRI& property)
 {
-    try {
-        return getDataProperty(property);
-    } catch(const std::invalid_argument& e)
+    DataPropertyExpression expression = tryGetDataProperty(property);
+    if(!expression.get())
     {
-        TDLDataRoleExpression* f_property = getExpressionManager()->DataRole(property.toString());
-        DataPropertyExpression expression(f_property);
+        TDLDataRoleExpression* f_expression = getExpressionManager()->DataRole(property.toString());
+        expression = DataPropertyExpression(f_expression);
         mDataProperties[property] = expression;
-        return expression;
     }
+    return expression;
 }
 
 KnowledgeBase::KnowledgeBase()
     : mKernel(new ReasoningKernel())
+    , mRevision(0)
+    , mEqualityRevision(0)
+    , mSameAsIndexRevision(0)
+    , mTaxonomyRevision(0)
 {
     mKernel->setVerboseOutput(false);
     mKernel->newKB();
@@ -269,6 +327,224 @@ bool KnowledgeBase::isRealized()
     return mKernel->isKBRealised();
 }
 
+void KnowledgeBase::buildSubsumptionIndex()
+{
+    classify();
+
+    std::map<IRI, IRIList> ancestors;
+    std::map<IRI, IRIList> equivalents;
+
+    IRIList klasses = allClasses();
+    IRIClassExpressionMap::const_iterator cit = mClasses.begin();
+    for(; cit != mClasses.end(); ++cit)
+    {
+        const IRI& klass = cit->first;
+
+        Actor equivalentActor;
+        equivalentActor.needConcepts();
+        mKernel->getEquivalentConcepts(cit->second.get(), equivalentActor);
+        IRIList& equivalentClasses = equivalents[klass];
+        equivalentClasses = getResult(equivalentActor);
+
+        if(std::find(equivalentClasses.begin(), equivalentClasses.end(), vocabulary::OWL::Nothing()) != equivalentClasses.end())
+        {
+            // unsatisfiable class is subsumed by all classes
+            ancestors[klass] = klasses;
+            continue;
+        }
+
+        Actor ancestorActor;
+        ancestorActor.needConcepts();
+        mKernel->getSupConcepts(cit->second.get(), false, ancestorActor);
+        ancestors[klass] = getResult(ancestorActor);
+    }
+
+    mSubsumptionIndex = make_shared<reasoner::SubsumptionIndex>(ancestors, equivalents);
+    LOG_DEBUG_S << "owlapi::KnowledgeBase::buildSubsumptionIndex: indexed " << mSubsumptionIndex->size() << " classes";
+}
+
+void KnowledgeBase::clearSubsumptionIndex()
+{
+    mSubsumptionIndex.reset();
+}
+
+bool KnowledgeBase::hasSubsumptionIndex() const
+{
+    return mSubsumptionIndex && mKernel->isKBClassified();
+}
+
+bool KnowledgeBase::useSubsumptionIndex()
+{
+    if(!mSubsumptionIndex)
+    {
+        return false;
+    }
+
+    if(!mKernel->isKBClassified())
+    {
+        // knowledge base has been modified since the index has been built
+        LOG_DEBUG_S << "owlapi::KnowledgeBase: dropping outdated subsumption index";
+        clearSubsumptionIndex();
+        return false;
+    }
+    return true;
+}
+
+bool KnowledgeBase::hasSameAsIndex() const
+{
+    // Adding axioms can only add equalities (and retraction drops the
+    // index), so that the index of a realised knowledge base remains valid
+    // as long as no axiom affecting equality has been added
+    return mSameAsIndex && mSameAsIndexRevision == mEqualityRevision;
+}
+
+bool KnowledgeBase::useSameAsIndex()
+{
+    if(hasSameAsIndex())
+    {
+        return true;
+    }
+
+    realize();
+
+    // Each reasoner query yields the complete set of aliases, so that
+    // aliases of a queried instance do not need to be queried again
+    std::map<IRI, IRIList> sameAs;
+    std::unordered_set<IRI> indexed;
+    for(const IRI& instance : allInstances())
+    {
+        if(indexed.count(instance))
+        {
+            continue;
+        }
+
+        Actor actor;
+        actor.needIndividuals();
+        mKernel->getSameAs(getInstance(instance).get(), actor);
+        IRIList& aliases = sameAs[instance];
+        aliases = getResult(actor);
+        indexed.insert(instance);
+        indexed.insert(aliases.begin(), aliases.end());
+    }
+
+    mSameAsIndex = make_shared<reasoner::SameAsIndex>(sameAs);
+    mSameAsIndexRevision = mEqualityRevision;
+    LOG_DEBUG_S << "owlapi::KnowledgeBase::useSameAsIndex: indexed " << mSameAsIndex->size() << " instances";
+    return true;
+}
+
+uint64_t KnowledgeBase::getContentHash() const
+{
+    // Hash each axiom separately and sort the hashes, so that the
+    // result does not depend on the order of the axioms
+    std::istringstream lines(toString(representation::LISP));
+    std::vector<uint64_t> hashes;
+    std::string line;
+    while(std::getline(lines, line))
+    {
+        if(!line.empty())
+        {
+            hashes.push_back(fnv1a(line.data(), line.size()));
+        }
+    }
+    std::sort(hashes.begin(), hashes.end());
+    return fnv1a(reinterpret_cast<const char*>(hashes.data()), hashes.size()*sizeof(uint64_t));
+}
+
+reasoner::Taxonomy::Ptr KnowledgeBase::computeTaxonomy()
+{
+    using reasoner::Taxonomy;
+
+    uint64_t key = getContentHash();
+    clearTaxonomy();
+    classify();
+    realize();
+
+    Taxonomy::Ptr taxonomy = make_shared<Taxonomy>(key);
+    // Entities which cannot be queried, e.g. properties which have not been
+    // registered as roles, remain unknown to the taxonomy
+    auto add = [&taxonomy](Taxonomy::Relation relation, const IRI& iri, std::function<IRIList()> query)
+    {
+        try {
+            taxonomy->set(relation, iri, query());
+        } catch(const std::exception& e)
+        {
+            LOG_DEBUG_S << "owlapi::KnowledgeBase::computeTaxonomy: no result for '" << iri << "': " << e.what();
+        }
+    };
+
+    for(const IRI& klass : allClasses())
+    {
+        add(Taxonomy::SUB_CLASSES, klass, [this, &klass]() { return allSubClassesOf(klass, false); });
+        add(Taxonomy::DIRECT_SUB_CLASSES, klass, [this, &klass]() { return allSubClassesOf(klass, true); });
+        add(Taxonomy::ANCESTORS, klass, [this, &klass]() { return allAncestorsOf(klass, false); });
+        add(Taxonomy::DIRECT_ANCESTORS, klass, [this, &klass]() { return allAncestorsOf(klass, true); });
+        add(Taxonomy::EQUIVALENT_CLASSES, klass, [this, &klass]() { return allEquivalentClasses(klass); });
+    }
+    for(const IRI& instance : allInstances())
+    {
+        add(Taxonomy::TYPES, instance, [this, &instance]() { return typesOf(instance, false); });
+        add(Taxonomy::DIRECT_TYPES, instance, [this, &instance]() { return typesOf(instance, true); });
+    }
+    for(const IRI& property : allObjectProperties())
+    {
+        add(Taxonomy::SUB_OBJECT_PROPERTIES, property, [this, &property]() { return allSubObjectProperties(property, false); });
+        add(Taxonomy::DIRECT_SUB_OBJECT_PROPERTIES, property, [this, &property]() { return allSubObjectProperties(property, true); });
+        add(Taxonomy::ANCESTOR_OBJECT_PROPERTIES, property, [this, &property]() { return allAncestorObjectProperties(property, false); });
+        add(Taxonomy::DIRECT_ANCESTOR_OBJECT_PROPERTIES, property, [this, &property]() { return allAncestorObjectProperties(property, true); });
+    }
+    for(const IRI& property : allDataProperties())
+    {
+        add(Taxonomy::SUB_DATA_PROPERTIES, property, [this, &property]() { return allSubDataProperties(property, false); });
+        add(Taxonomy::DIRECT_SUB_DATA_PROPERTIES, property, [this, &property]() { return allSubDataProperties(property, true); });
+        add(Taxonomy::ANCESTOR_DATA_PROPERTIES, property, [this, &property]() { return allAncestorDataProperties(property, false); });
+        add(Taxonomy::DIRECT_ANCESTOR_DATA_PROPERTIES, property, [this, &property]() { return allAncestorDataProperties(property, true); });
+    }
+
+    LOG_DEBUG_S << "owlapi::KnowledgeBase::computeTaxonomy: computed " << taxonomy->size() << " entries";
+    return taxonomy;
+}
+
+bool KnowledgeBase::setTaxonomy(const reasoner::Taxonomy::Ptr& taxonomy)
+{
+    if(!taxonomy)
+    {
+        throw std::invalid_argument("owlapi::KnowledgeBase::setTaxonomy: no taxonomy given");
+    }
+
+    if(taxonomy->getKey() != getContentHash())
+    {
+        LOG_INFO_S << "owlapi::KnowledgeBase::setTaxonomy: taxonomy does not match the content of the knowledge base";
+        clearTaxonomy();
+        return false;
+    }
+
+    mTaxonomy = taxonomy;
+    mTaxonomyRevision = mRevision;
+    return true;
+}
+
+void KnowledgeBase::clearTaxonomy()
+{
+    mTaxonomy.reset();
+}
+
+bool KnowledgeBase::hasTaxonomy() const
+{
+    // The taxonomy is only valid for the revision of the knowledge base
+    // it has been set for, i.e. for the content its key has been checked against
+    return mTaxonomy && mTaxonomyRevision == mRevision;
+}
+
+const IRIList* KnowledgeBase::findInTaxonomy(reasoner::Taxonomy::Relation relation, const IRI& iri) const
+{
+    if(!hasTaxonomy())
+    {
+        return NULL;
+    }
+    return mTaxonomy->find(relation, iri);
+}
+
 bool KnowledgeBase::isClassSatisfiable(const IRI& klass)
 {
     ClassExpression e_klass = getClass(klass);
@@ -289,7 +565,7 @@ DataPropertyExpression KnowledgeBase::dataProperty(const IRI& property)
 Axiom KnowledgeBase::transitiveProperty(const IRI& property)
 {
     ObjectPropertyExpression e_property = getObjectPropertyLazy(property);
-    return Axiom( mKernel->setTransitive(e_property.get()) );
+    return record( mKernel->setTransitive(e_property.get()) );
 }
 
 bool KnowledgeBase::isTransitiveProperty(const IRI& property)
@@ -305,12 +581,12 @@ Axiom KnowledgeBase::functionalProperty(const IRI& property, PropertyType type)
         case OBJECT:
         {
             ObjectPropertyExpression e_property = getObjectPropertyLazy(property);
-            return Axiom( mKernel->setOFunctional(e_property.get()) );
+            return record( mKernel->setOFunctional(e_property.get()) );
         }
         case DATA:
         {
             DataPropertyExpression e_property = getDataPropertyLazy(property);
-            return Axiom( mKernel->setDFunctional(e_property.get()) );
+            return record( mKernel->setDFunctional(e_property.get()) );
         }
         default:
             throw std::invalid_argument("KnowledgeBase::functionalProperty: Functional property can only be created for object or data property");
@@ -319,28 +595,28 @@ Axiom KnowledgeBase::functionalProperty(const IRI& property, PropertyType type)
 
 bool KnowledgeBase::isFunctionalProperty(const IRI& property)
 {
-    try {
-        ObjectPropertyExpression e_property = getObjectProperty(property);
-        return mKernel->isFunctional(e_property.get());
-    } catch(const std::invalid_argument& e)
-    {
-        // Not a known object property
-    } catch(const EFaCTPlusPlus& e)
+    ObjectPropertyExpression e_oProperty = tryGetObjectProperty(property);
+    if(e_oProperty.get())
     {
-        // Known object property, but not registered as role
-        return false;
+        try {
+            return mKernel->isFunctional(e_oProperty.get());
+        } catch(const EFaCTPlusPlus& e)
+        {
+            // Known object property, but not registered as role
+            return false;
+        }
     }
 
-    try {
-        DataPropertyExpression e_property = getDataProperty(property);
-        return mKernel->isFunctional(e_property.get());
-    } catch(const std::invalid_argument& e)
-    {
-        // Not a known object property
-    } catch(const EFaCTPlusPlus& e)
+    DataPropertyExpression e_dProperty = tryGetDataProperty(property);
+    if(e_dProperty.get())
     {
-        // Known object property, but not registered as role
-        return false;
+        try {
+            return mKernel->isFunctional(e_dProperty.get());
+        } catch(const EFaCTPlusPlus& e)
+        {
+            // Known data property, but not registered as role
+            return false;
+        }
     }
 
     LOG_INFO_S << "KnowledgeBase::isFunctionalProperty: Property '" << property.toString() << "' is not a known data or object property";
@@ -350,7 +626,7 @@ bool KnowledgeBase::isFunctionalProperty(const IRI& property)
 Axiom KnowledgeBase::inverseFunctionalProperty(const IRI& property)
 {
     ObjectPropertyExpression e_property = getObjectPropertyLazy(property);
-    return Axiom( mKernel->setInverseFunctional(e_property.get()) );
+    return record( mKernel->setInverseFunctional(e_property.get()) );
 }
 
 bool KnowledgeBase::isInverseFunctionalProperty(const IRI& property)
@@ -362,7 +638,7 @@ bool KnowledgeBase::isInverseFunctionalProperty(const IRI& property)
 Axiom KnowledgeBase::reflexiveProperty(const IRI& property)
 {
     ObjectPropertyExpression e_property = getObjectPropertyLazy(property);
-    return Axiom( mKernel->setReflexive(e_property.get()) );
+    return record( mKernel->setReflexive(e_property.get()) );
 }
 
 bool KnowledgeBase::isReflexiveProperty(const IRI& property)
@@ -374,7 +650,7 @@ bool KnowledgeBase::isReflexiveProperty(const IRI& property)
 Axiom KnowledgeBase::irreflexiveProperty(const IRI& property)
 {
     ObjectPropertyExpression e_property = getObjectPropertyLazy(property);
-    return Axiom( mKernel->setIrreflexive(e_property.get()) );
+    return record( mKernel->setIrreflexive(e_property.get()) );
 }
 
 bool KnowledgeBase::isIrreflexiveProperty(const IRI& property)
@@ -386,7 +662,7 @@ bool KnowledgeBase::isIrreflexiveProperty(const IRI& property)
 Axiom KnowledgeBase::symmetricProperty(const IRI& property)
 {
     ObjectPropertyExpression e_property = getObjectPropertyLazy(property);
-    return Axiom( mKernel->setSymmetric(e_property.get()) );
+    return record( mKernel->setSymmetric(e_property.get()) );
 }
 
 bool KnowledgeBase::isSymmetricProperty(const IRI& property)
@@ -398,7 +674,7 @@ bool KnowledgeBase::isSymmetricProperty(const IRI& property)
 Axiom KnowledgeBase::asymmetricProperty(const IRI& property)
 {
     ObjectPropertyExpression e_property = getObjectPropertyLazy(property);
-    return Axiom( mKernel->setAsymmetric(e_property.get()) );
+    return record( mKernel->setAsymmetric(e_property.get()) );
 }
 
 bool KnowledgeBase::isAsymmetricProperty(const IRI& property)
@@ -415,7 +691,7 @@ Axiom KnowledgeBase::equalClasses(const IRIList& klasses)
         ClassExpression e_class = getClassLazy(iri);
         getExpressionManager()->addArg(e_class.get());
     }
-    return Axiom(mKernel->equalConcepts());
+    return record(mKernel->equalConcepts());
 }
 
 Axiom KnowledgeBase::equalObjectProperties(const IRIList& properties)
@@ -426,7 +702,7 @@ Axiom KnowledgeBase::equalObjectProperties(const IRIList& properties)
         ObjectPropertyExpression e_property = getObjectPropertyLazy(iri);
         getExpressionManager()->addArg(e_property.get());
     }
-    return Axiom(mKernel->equalORoles());
+    return record(mKernel->equalORoles());
 }
 
 Axiom KnowledgeBase::equalDataProperties(const IRIList& properties)
@@ -437,7 +713,7 @@ Axiom KnowledgeBase::equalDataProperties(const IRIList& properties)
         DataPropertyExpression e_property = getDataPropertyLazy(iri);
         getExpressionManager()->addArg(e_property.get());
     }
-    return Axiom(mKernel->equalORoles());
+    return record(mKernel->equalORoles());
 }
 
 Axiom KnowledgeBase::subClassOf(const IRI& subclass, const IRI& parentClass)
@@ -449,31 +725,27 @@ Axiom KnowledgeBase::subClassOf(const IRI& subclass, const IRI& parentClass)
 Axiom KnowledgeBase::subClassOf(const ClassExpression& subclass, const IRI& parentClass)
 {
     ClassExpression e_parentClass = getClassLazy(parentClass);
-    return Axiom( mKernel->impliesConcepts(subclass.get(), e_parentClass.get()) );
+    return record( mKernel->impliesConcepts(subclass.get(), e_parentClass.get()) );
 }
 
 Axiom KnowledgeBase::subClassOf(const IRI& subclass, const ClassExpression& parentClass)
 {
     ClassExpression e_subclass = getClassLazy(subclass);
-    return Axiom( mKernel->impliesConcepts(e_subclass.get(), parentClass.get()) );
+    return record( mKernel->impliesConcepts(e_subclass.get(), parentClass.get()) );
 }
 
 Axiom KnowledgeBase::subPropertyOf(const IRI& subProperty, const IRI& parentProperty)
 {
-    try {
-        ObjectPropertyExpression e_property = getObjectProperty(parentProperty);
-        return subObjectPropertyOf(subProperty, e_property);
-    } catch(const std::exception& e)
+    ObjectPropertyExpression e_oProperty = tryGetObjectProperty(parentProperty);
+    if(e_oProperty.get())
     {
-        // not an object property
+        return subObjectPropertyOf(subProperty, e_oProperty);
     }
 
-    try {
-        DataPropertyExpression e_property = getDataProperty(parentProperty);
-        return subDataPropertyOf(subProperty, e_property);
-    } catch(const std::exception& e)
+    DataPropertyExpression e_dProperty = tryGetDataProperty(parentProperty);
+    if(e_dProperty.get())
     {
-        // not an object property
+        return subDataPropertyOf(subProperty, e_dProperty);
     }
 
     throw std::invalid_argument("owlapi::KnowledgeBase::subPropertyOf: "
@@ -484,13 +756,13 @@ Axiom KnowledgeBase::subObjectPropertyOf(const IRI& subProperty, const ObjectPro
 {
     ObjectPropertyExpression e_property = getObjectPropertyLazy(subProperty);
     //TDLAxiom* impliesORoles ( TORoleComplexExpr* R, TORoleExpr* S )
-    return Axiom( mKernel->impliesORoles(e_property.get(), parentProperty.get()));
+    return record( mKernel->impliesORoles(e_property.get(), parentProperty.get()));
 }
 
 Axiom KnowledgeBase::subDataPropertyOf(const IRI& subProperty, const DataPropertyExpression& parentProperty)
 {
     DataPropertyExpression e_property = getDataPropertyLazy(subProperty);
-    return Axiom( mKernel->impliesDRoles(e_property.get(), parentProperty.get()) );
+    return record( mKernel->impliesDRoles(e_property.get(), parentProperty.get()) );
 }
 
 Axiom KnowledgeBase::equals(const IRI& klass, const IRI& otherKlass)
@@ -507,7 +779,7 @@ Axiom KnowledgeBase::equals(const reasoner::factpp::ClassExpression& klass,
     getExpressionManager()->addArg(klass.get());
     getExpressionManager()->addArg(otherklass.get());
 
-    return Axiom( mKernel->equalConcepts() );
+    return record( mKernel->equalConcepts() );
 
 }
 
@@ -580,7 +852,7 @@ Axiom KnowledgeBase::alias(const IRI& alias, const ClassExpression& expression)
     getExpressionManager()->newArgList();
     getExpressionManager()->addArg(e_aliasClass.get());
     getExpressionManager()->addArg(expression.get());
-    return Axiom( mKernel->equalConcepts() );
+    return record( mKernel->equalConcepts() );
 }
 
 Axiom KnowledgeBase::alias(const IRI& aliasName, const IRI& iri, EntityType type)
@@ -597,7 +869,7 @@ Axiom KnowledgeBase::alias(const IRI& aliasName, const IRI& iri, EntityType type
             getExpressionManager()->newArgList();
             getExpressionManager()->addArg(e_aliasInstance.get());
             getExpressionManager()->addArg(e_instance.get());
-            return Axiom( mKernel->processSame() );
+            return record( mKernel->processSame() );
         }
         case CLASS:
         {
@@ -638,11 +910,12 @@ Axiom KnowledgeBase::disjoint(const IRIList& klassesOrInstances, KnowledgeBase::
     if(type == CLASS)
     {
         TDLAxiom* axiom = mKernel->disjointConcepts();
-        return Axiom(axiom);
+        return record(axiom);
     } else if(type == INSTANCE)
     {
+        // different individuals cannot entail that instances are the same
         TDLAxiom* axiom = mKernel->processDifferent();
-        return Axiom(axiom);
+        return record(axiom, false);
     }
 
     throw std::runtime_error("owlapi::KnowledgeBase::disjoint requires either list of classes or instances");
@@ -656,7 +929,7 @@ Axiom KnowledgeBase::disjointObjectProperties(const IRIList& properties)
         ObjectPropertyExpression e_property = getObjectPropertyLazy(iri);
         getExpressionManager()->addArg(e_property.get());
     }
-    return Axiom(mKernel->disjointORoles());
+    return record(mKernel->disjointORoles());
 }
 
 Axiom KnowledgeBase::disjointDataProperties(const IRIList& properties)
@@ -667,7 +940,7 @@ Axiom KnowledgeBase::disjointDataProperties(const IRIList& properties)
         DataPropertyExpression e_property = getDataPropertyLazy(iri);
         getExpressionManager()->addArg(e_property.get());
     }
-    return Axiom(mKernel->disjointORoles());
+    return record(mKernel->disjointORoles());
 }
 
 Axiom KnowledgeBase::disjointUnion(const IRI& klass, const IRIList& disjointClasses)
@@ -681,7 +954,7 @@ Axiom KnowledgeBase::disjointUnion(const IRI& klass, const IRIList& disjointClas
 
     ClassExpression e_class = getClass(klass);
     TDLAxiom* axiom = mKernel->disjointUnion(e_class.get());
-    return Axiom(axiom);
+    return record(axiom);
 }
 
 Axiom KnowledgeBase::instanceOf(const IRI& individual, const IRI& klass)
@@ -693,7 +966,7 @@ Axiom KnowledgeBase::instanceOf(const IRI& individual, const IRI& klass)
 Axiom KnowledgeBase::instanceOf(const IRI& individual, const ClassExpression& e_class)
 {
     InstanceExpression e_instance = getInstanceLazy(individual);
-    return Axiom( mKernel->instanceOf(e_instance.get(), e_class.get()) );
+    return record( mKernel->instanceOf(e_instance.get(), e_class.get()) );
 }
 
 Axiom KnowledgeBase::relatedTo(const IRI& instance, const IRI& relationProperty, const IRI& otherInstance, bool isTrue)
@@ -705,9 +978,9 @@ Axiom KnowledgeBase::relatedTo(const IRI& instance, const IRI& relationProperty,
 
     if(isTrue)
     {
-        return Axiom( mKernel->relatedTo(e_instance.get(), e_relation.get(), e_otherInstance.get()) );
+        return record( mKernel->relatedTo(e_instance.get(), e_relation.get(), e_otherInstance.get()) );
     } else {
-        return Axiom( mKernel->relatedToNot(e_instance.get(), e_relation.get(), e_otherInstance.get()) );
+        return record( mKernel->relatedToNot(e_instance.get(), e_relation.get(), e_otherInstance.get()) );
     }
 }
 
@@ -720,14 +993,14 @@ Axiom KnowledgeBase::domainOf(const IRI& property, const IRI& domain, PropertyTy
             ObjectPropertyExpression e_role = getObjectPropertyLazy(property);
             ClassExpression e_domain = getClassLazy(domain);
 
-            return Axiom( mKernel->setODomain(e_role.get(), e_domain.get()) );
+            return record( mKernel->setODomain(e_role.get(), e_domain.get()) );
         }
         case DATA:
         {
             DataPropertyExpression e_role = getDataPropertyLazy(property);
             ClassExpression e_domain = getClassLazy(domain);
 
-            return Axiom( mKernel->setDDomain(e_role.get(), e_domain.get()) );
+            return record( mKernel->setDDomain(e_role.get(), e_domain.get()) );
         }
         default:
         {
@@ -740,20 +1013,20 @@ Axiom KnowledgeBase::objectRangeOf(const IRI& property, const IRI& range)
 {
     ObjectPropertyExpression e_role = getObjectProperty(property);
     ClassExpression e_range = getClassLazy(range);
-    return Axiom( mKernel->setORange(e_role.get(), e_range.get()) );
+    return record( mKernel->setORange(e_role.get(), e_range.get()) );
 }
 
 Axiom KnowledgeBase::objectRangeOf(const IRI& property, const ClassExpression& expression)
 {
     ObjectPropertyExpression e_role = getObjectProperty(property);
-    return Axiom( mKernel->setORange(e_role.get(), expression.get()) );
+    return record( mKernel->setORange(e_role.get(), expression.get()) );
 }
 
 reasoner::factpp::Axiom KnowledgeBase::dataRangeOf(const IRI& property,
         reasoner::factpp::DataRange& range)
 {
     DataPropertyExpression e_role = getDataProperty(property);
-    return Axiom( mKernel->setDRange(e_role.get(), range.get()) );
+    return record( mKernel->setDRange(e_role.get(), range.get()) );
 }
 
 Axiom KnowledgeBase::valueOf(const IRI& individual, const IRI& property, const DataValue& dataValue)
@@ -761,26 +1034,22 @@ Axiom KnowledgeBase::valueOf(const IRI& individual, const IRI& property, const D
     // Make sure the database remains consistent when handling functional
     // properties, i.e. you cannot associate two valueOf statement with a
     // functional property
-    std::pair<IRI,IRI> key(individual, property);
-    if(isFunctionalProperty(property))
+    if(mValueOfAxioms.find(individual, property) && isFunctionalProperty(property))
     {
-        DataValueMap::iterator it = mValueOfAxioms.find(key);
-        if(it != mValueOfAxioms.end())
+        Axiom::List list = mValueOfAxioms.take(individual, property);
+        Axiom::List::const_iterator cit = list.begin();
+        for(; cit != list.end(); ++cit)
         {
-            Axiom::List& list = it->second;
-            Axiom::List::const_iterator cit = list.begin();
-            for(; cit != list.end(); ++cit)
-            {
-                LOG_DEBUG_S << "Retracting existing value: " << individual << " " << property;
-                retract(*cit);
-            }
-            mValueOfAxioms.erase(it);
+            LOG_DEBUG_S << "Retracting existing value: " << individual << " " << property;
+            retractValue(*cit);
         }
     }
 
     TDLAxiom* tdlAxiom = mKernel->valueOf( getInstance(individual).get(), getDataProperty(property).get(), dataValue.get());
-    Axiom axiom(tdlAxiom);
-    mValueOfAxioms[key].push_back(axiom);
+    // Without support for keys, data values cannot entail that instances
+    // are the same
+    Axiom axiom = record(tdlAxiom, false);
+    mValueOfAxioms.add(individual, property, axiom);
 
     return axiom;
 }
@@ -806,29 +1075,34 @@ DataTypeName KnowledgeBase::dataType(const IRI& dataType)
 }
 
 DataValue KnowledgeBase::dataValue(const std::string& value, const std::string& dataType)
+{
+    return createDataValue(value, IRI(dataType));
+}
+
+DataValue KnowledgeBase::dataValue(const owlapi::model::OWLLiteral::Ptr& literal)
+{
+    // use the interned datatype of the literal to avoid parsing the IRI again
+    return createDataValue(literal->getValue(), literal->getDatatypeIRI());
+}
+
+DataValue KnowledgeBase::createDataValue(const std::string& value, const IRI& dataType)
 {
     IRIDataTypeMap::const_iterator cit = mDataTypes.find(dataType);
     if(cit == mDataTypes.end())
     {
-        throw std::invalid_argument("owlapi::KnowledgeBase::dataValue: dataType '" + dataType + "' is unknown");
+        throw std::invalid_argument("owlapi::KnowledgeBase::dataValue: dataType '" + dataType.toString() + "' is unknown");
     }
 
-    DataTypeName dataTypeName = cit->second;
-    const TDLDataValue* dataValue = getExpressionManager()->DataValue(value, dataTypeName.get());
+    const TDLDataValue* dataValue = getExpressionManager()->DataValue(value, cit->second.get());
     return DataValue(dataValue);
 }
 
-DataValue KnowledgeBase::dataValue(const owlapi::model::OWLLiteral::Ptr& literal)
-{
-    return dataValue(literal->getValue(), literal->getType());
-}
-
 Axiom KnowledgeBase::inverseOf(const IRI& base, const IRI& inverse)
 {
     ObjectPropertyExpression e_role = getObjectPropertyLazy(base);
     ObjectPropertyExpression e_inverse = getObjectPropertyLazy(inverse);
 
-    return Axiom( mKernel->setInverseRoles(e_role.get(), e_inverse.get()) );
+    return record( mKernel->setInverseRoles(e_role.get(), e_inverse.get()) );
 }
 
 ClassExpression KnowledgeBase::objectOneOf(const IRI& id,
@@ -936,7 +1210,7 @@ reasoner::factpp::DataRange KnowledgeBase::dataOneOf(const owlapi::model::OWLLit
     getExpressionManager()->newArgList();
     for(const owlapi::model::OWLLiteral::Ptr& literal : literals)
     {
-        DataValue dValue = dataValue(literal->getValue(), literal->getType());
+        DataValue dValue = dataValue(literal);
         getExpressionManager()->addArg(dValue.get());
     }
     return reasoner::factpp::DataRange( getExpressionManager()->DataOneOf() );
@@ -955,7 +1229,7 @@ reasoner::factpp::DataRange KnowledgeBase::dataTypeRestriction(const owlapi::mod
     for(const OWLFacetRestriction& fr : restriction->getFacetRestrictions())
     {
         const OWLLiteral::Ptr& literal = fr.getFacetValue();
-        DataValue dValue = dataValue(literal->getValue(), literal->getType());
+        DataValue dValue = dataValue(literal);
         const TDLFacetExpression* facetExpression;
 
         switch(fr.getFacet().getFacetType())
@@ -979,7 +1253,7 @@ reasoner::factpp::DataRange KnowledgeBase::dataTypeRestriction(const owlapi::mod
         // TDLDataTypeExpression
         if(!dataTypeRestriction)
         {
-            DataTypeName dataTypeName = dataType(literal->getType());
+            DataTypeName dataTypeName = dataType(literal->getDatatypeIRI());
             dataTypeRestriction = getExpressionManager()->RestrictedType(dataTypeName.get(), facetExpression);
         } else {
             dataTypeRestriction = getExpressionManager()->RestrictedType(dataTypeRestriction, facetExpression);
@@ -1296,6 +1570,12 @@ ClassExpression KnowledgeBase::objectPropertyRestriction(
 
 bool KnowledgeBase::isSubClassOf(const IRI& subclass, const IRI& parentClass)
 {
+    if(useSubsumptionIndex() && mSubsumptionIndex->contains(subclass)
+            && mSubsumptionIndex->contains(parentClass))
+    {
+        return mSubsumptionIndex->isSubClassOf(subclass, parentClass);
+    }
+
     try {
         ClassExpression e_class = getClass(subclass);
         return isSubClassOf( e_class, parentClass );
@@ -1350,6 +1630,11 @@ bool KnowledgeBase::isRelatedTo(const IRI& instance, const IRI& relationProperty
 
 bool KnowledgeBase::isSameInstance(const IRI& instance, const IRI& otherInstance) const
 {
+    if(hasSameAsIndex() && mSameAsIndex->contains(instance) && mSameAsIndex->contains(otherInstance))
+    {
+        return mSameAsIndex->isSameInstance(instance, otherInstance);
+    }
+
     InstanceExpression e_instance = getInstance(instance);
     InstanceExpression e_otherInstance = getInstance(otherInstance);
     return mKernel->isSameIndividuals(e_instance.get(), e_otherInstance.get());
@@ -1373,6 +1658,16 @@ IRIList KnowledgeBase::allClasses(bool excludeBottomClass) const
 
 IRIList KnowledgeBase::allSubClassesOf(const IRI& klass, bool direct)
 {
+    if(const IRIList* result = findInTaxonomy(direct ? reasoner::Taxonomy::DIRECT_SUB_CLASSES : reasoner::Taxonomy::SUB_CLASSES, klass))
+    {
+        return *result;
+    }
+
+    if(!direct && useSubsumptionIndex() && mSubsumptionIndex->contains(klass))
+    {
+        return mSubsumptionIndex->getSubClasses(klass, vocabulary::OWL::Nothing());
+    }
+
     ClassExpression e_class = getClass(klass);
 
     Actor actor;
@@ -1384,13 +1679,11 @@ IRIList KnowledgeBase::allSubClassesOf(const IRI& klass, bool direct)
 
 IRIList KnowledgeBase::allAncestorsOf(const IRI& klass, bool direct)
 {
-    ClassExpression e_class = getClass(klass);
-
-    Actor actor;
-    actor.needConcepts();
-    mKernel->getSupConcepts(e_class.get(), direct, actor);
+    if(const IRIList* result = findInTaxonomy(direct ? reasoner::Taxonomy::DIRECT_ANCESTORS : reasoner::Taxonomy::ANCESTORS, klass))
+    {
+        return *result;
+    }
 
-    IRIList directClassAncestors = getResult(actor);
     IRIList punningBasedAncestors;
     try {
         punningBasedAncestors = typesOf(klass);
@@ -1398,13 +1691,30 @@ IRIList KnowledgeBase::allAncestorsOf(const IRI& klass, bool direct)
     {
         /// ignore if there is no instance for punning
     }
-    IRISet ancestors(directClassAncestors.begin(), directClassAncestors.end());
-    for(const IRI& ancestor : ancestors)
+
+    IRISet ancestors;
+    if(!direct && useSubsumptionIndex() && mSubsumptionIndex->contains(klass))
     {
-        IRIList equivalenctClasses = allEquivalentClasses(ancestor);
-        punningBasedAncestors.insert(punningBasedAncestors.end(),
-                equivalenctClasses.begin(), equivalenctClasses.end());
+        // the index already accounts for all equivalent classes of the
+        // ancestors
+        IRIList classAncestors = mSubsumptionIndex->getAncestors(klass);
+        ancestors.insert(classAncestors.begin(), classAncestors.end());
+    } else {
+        ClassExpression e_class = getClass(klass);
 
+        Actor actor;
+        actor.needConcepts();
+        mKernel->getSupConcepts(e_class.get(), direct, actor);
+
+        IRIList directClassAncestors = getResult(actor);
+        ancestors.insert(directClassAncestors.begin(), directClassAncestors.end());
+        for(const IRI& ancestor : ancestors)
+        {
+            IRIList equivalenctClasses = allEquivalentClasses(ancestor);
+            punningBasedAncestors.insert(punningBasedAncestors.end(),
+                    equivalenctClasses.begin(), equivalenctClasses.end());
+
+        }
     }
     ancestors.insert(punningBasedAncestors.begin(), punningBasedAncestors.end());
     return IRIList(ancestors.begin(), ancestors.end());
@@ -1412,6 +1722,11 @@ IRIList KnowledgeBase::allAncestorsOf(const IRI& klass, bool direct)
 
 IRIList KnowledgeBase::allEquivalentClasses(const IRI& klass)
 {
+    if(const IRIList* result = findInTaxonomy(reasoner::Taxonomy::EQUIVALENT_CLASSES, klass))
+    {
+        return *result;
+    }
+
     ClassExpression e_class = getClass(klass);
 
     Actor actor;
@@ -1445,29 +1760,49 @@ IRIList KnowledgeBase::allInstances() const
 IRIList KnowledgeBase::allInstancesOf(const IRI& klass, bool direct)
 {
     ClassExpression e_class = getClass(klass);
-    IRIList instances;
 
     Actor actor;
     actor.needIndividuals();
     mKernel->getInstances(e_class.get(), actor);
+    IRIList instances = getResult(actor);
+    if(!direct || instances.empty())
+    {
+        return instances;
+    }
 
-    Actor::Array1D result;
-    actor.getFoundData(result);
-    Actor::Array1D::const_iterator cit = result.begin();
-    for(; cit != result.end(); ++cit)
+    // Fact does seem to fail at extracting direct instances, so remove
+    // the instances of all direct subclasses, which requires a query per
+    // subclass instead of a query per instance
+    std::unordered_set<IRI> indirectInstances;
+    for(const IRI& subclass : allSubClassesOf(klass, true))
     {
-        // Fact does seem to fail at extracting direct instances
-        const ClassifiableEntry* entry = *cit;
-        IRI instanceName = IRI::create(entry->getName());
-        if(direct && ! (typeOf(instanceName) == klass) )
-        {
-            continue;
-        }
-        instances.push_back(instanceName);
+        IRIList subclassInstances = allInstancesOf(subclass);
+        indirectInstances.insert(subclassInstances.begin(), subclassInstances.end());
     }
+    instances.erase(std::remove_if(instances.begin(), instances.end(),
+                [&indirectInstances](const IRI& instance)
+                {
+                    return indirectInstances.count(instance);
+                }), instances.end());
     return instances;
 }
 
+void KnowledgeBase::retainInstancesOf(IRIList& individuals, const IRI& klass)
+{
+    if(klass.empty() || individuals.empty())
+    {
+        return;
+    }
+
+    IRIList instances = allInstancesOf(klass);
+    std::unordered_set<IRI> instanceSet(instances.begin(), instances.end());
+    individuals.erase(std::remove_if(individuals.begin(), individuals.end(),
+                [&instanceSet](const IRI& individual)
+                {
+                    return !instanceSet.count(individual);
+                }), individuals.end());
+}
+
 IRIList KnowledgeBase::allRelatedInstances(const IRI& individual, const IRI& relationProperty, const IRI& klass)
 {
     IRIList individuals;
@@ -1482,17 +1817,14 @@ IRIList KnowledgeBase::allRelatedInstances(const IRI& individual, const IRI& rel
         for(; cit != relatedIndividuals.end(); ++cit)
         {
             const TNamedEntry* entry = *cit;
-            IRI iri( entry->getName() );
-
-            if( klass.empty() || isInstanceOf(iri, klass) )
-            {
-                individuals.push_back(iri);
-            }
+            individuals.push_back( IRI(entry->getName()) );
         }
+        retainInstancesOf(individuals, klass);
     } catch(const std::exception& e)
     {
         LOG_WARN_S << "'" << individual << "' not related to any via '" << relationProperty << "': " << e.what();
         // There is no such relation defined, thus return an empty list
+        individuals.clear();
     }
     return individuals;
 }
@@ -1522,17 +1854,14 @@ IRIList KnowledgeBase::allInverseRelatedInstances(const IRI& individual, const I
         for(; cit != relatedIndividuals.end(); ++cit)
         {
             const TNamedEntry* entry = *cit;
-            IRI iri( entry->getName() );
-
-            if( klass.empty() || isInstanceOf(iri, klass) )
-            {
-                individuals.push_back(iri);
-            }
+            individuals.push_back( IRI(entry->getName()) );
         }
+        retainInstancesOf(individuals, klass);
     } catch(const std::exception& e)
     {
         LOG_WARN_S << "'" << individual << "' not related to any via '" << relationProperty << "': " << e.what();
         // There is no such relation defined, thus return an empty list
+        individuals.clear();
     }
     return individuals;
 }
@@ -1556,6 +1885,11 @@ IRIList KnowledgeBase::allObjectProperties() const
 
 IRIList KnowledgeBase::allAncestorObjectProperties(const IRI& property, bool direct)
 {
+    if(const IRIList* result = findInTaxonomy(direct ? reasoner::Taxonomy::DIRECT_ANCESTOR_OBJECT_PROPERTIES : reasoner::Taxonomy::ANCESTOR_OBJECT_PROPERTIES, property))
+    {
+        return *result;
+    }
+
     ObjectPropertyExpression e_role = getObjectProperty(property);
 
     Actor actor;
@@ -1576,6 +1910,11 @@ IRIList KnowledgeBase::allAncestorObjectProperties(const IRI& property, bool dir
 
 IRIList KnowledgeBase::allSubObjectProperties(const IRI& propertyRelation, bool direct)
 {
+    if(const IRIList* result = findInTaxonomy(direct ? reasoner::Taxonomy::DIRECT_SUB_OBJECT_PROPERTIES : reasoner::Taxonomy::SUB_OBJECT_PROPERTIES, propertyRelation))
+    {
+        return *result;
+    }
+
     ObjectPropertyExpression e_relation = getObjectProperty(propertyRelation);
 
     Actor actor;
@@ -1672,6 +2011,11 @@ IRIList KnowledgeBase::allDataProperties() const
 
 IRIList KnowledgeBase::allAncestorDataProperties(const IRI& property, bool direct)
 {
+    if(const IRIList* result = findInTaxonomy(direct ? reasoner::Taxonomy::DIRECT_ANCESTOR_DATA_PROPERTIES : reasoner::Taxonomy::ANCESTOR_DATA_PROPERTIES, property))
+    {
+        return *result;
+    }
+
     DataPropertyExpression e_role = getDataProperty(property);
 
     Actor actor;
@@ -1692,6 +2036,11 @@ IRIList KnowledgeBase::allAncestorDataProperties(const IRI& property, bool direc
 
 IRIList KnowledgeBase::allSubDataProperties(const IRI& propertyRelation, bool direct)
 {
+    if(const IRIList* result = findInTaxonomy(direct ? reasoner::Taxonomy::DIRECT_SUB_DATA_PROPERTIES : reasoner::Taxonomy::SUB_DATA_PROPERTIES, propertyRelation))
+    {
+        return *result;
+    }
+
     DataPropertyExpression e_relation = getDataProperty(propertyRelation);
     IRIList relations;
 
@@ -1742,6 +2091,11 @@ IRIList KnowledgeBase::getDataPropertyDomain(const IRI& property, bool direct) c
 
 IRIList KnowledgeBase::typesOf(const IRI& instance, bool direct) const
 {
+    if(const IRIList* result = findInTaxonomy(direct ? reasoner::Taxonomy::DIRECT_TYPES : reasoner::Taxonomy::TYPES, instance))
+    {
+        return *result;
+    }
+
     InstanceExpression e_instance = getInstance(instance);
 
     Actor actor;
@@ -1760,6 +2114,11 @@ IRI KnowledgeBase::typeOf(const IRI& instance) const
 
 IRIList KnowledgeBase::getSameAs(const IRI& aliasOrInstance)
 {
+    if(useSameAsIndex() && mSameAsIndex->contains(aliasOrInstance))
+    {
+        return mSameAsIndex->getSameAs(aliasOrInstance);
+    }
+
     InstanceExpression e_instance = getInstance(aliasOrInstance);
 
     Actor actor;
@@ -1780,42 +2139,50 @@ IRIList KnowledgeBase::getSameAs(const IRI& aliasOrInstance)
 
 IRIList KnowledgeBase::uniqueList(const IRIList& individuals)
 {
-    IRIList base = individuals;
-    IRIList unique = individuals;
-    IRIList blacklist;
-
-    IRIList::const_iterator bit = base.begin();
-
-    for(; bit != base.end(); ++bit)
+    IRIList unique;
+    std::unordered_set<IRI> aliases;
+    for(const IRI& individual : individuals)
     {
-        IRI individual = *bit;
-        if( blacklist.end() != std::find(blacklist.begin(), blacklist.end(), individual) )
+        if(aliases.count(individual))
         {
-            LOG_DEBUG_S << "In blacklist: " << individual;
+            LOG_DEBUG_S << "Remove " << individual << " since its an alias";
             continue;
         }
 
-        IRIList::iterator uit = unique.begin();
-        for(; uit != unique.end();)
-        {
-            IRI otherIndividual = *uit;
-            if(individual != otherIndividual && isSameInstance(individual, otherIndividual) )
-            {
-                LOG_DEBUG_S << "Remove " << *uit << " since its an alias";
-                unique.erase(uit);
-                blacklist.push_back(otherIndividual);
-            } else {
-                ++uit;
-            }
-        }
+        unique.push_back(individual);
+        IRIList sameAs = getSameAs(individual);
+        aliases.insert(individual);
+        aliases.insert(sameAs.begin(), sameAs.end());
     }
-
     return unique;
 }
 
+Axiom KnowledgeBase::record(TDLAxiom* axiom, bool affectsEquality)
+{
+    ++mRevision;
+    if(affectsEquality)
+    {
+        ++mEqualityRevision;
+    }
+    return Axiom(axiom);
+}
+
+void KnowledgeBase::retractValue(const Axiom& a)
+{
+    mKernel->retract(const_cast<TDLAxiom*>(a.get()));
+    ++mRevision;
+    clearSubsumptionIndex();
+    clearTaxonomy();
+}
+
 void KnowledgeBase::retract(const Axiom& a)
 {
     mKernel->retract(const_cast<TDLAxiom*>(a.get()));
+    ++mRevision;
+    ++mEqualityRevision;
+    clearSubsumptionIndex();
+    mSameAsIndex.reset();
+    clearTaxonomy();
 }
 
 void KnowledgeBase::retractRelated(const owlapi::model::OWLAxiom::Ptr& a)
@@ -1839,40 +2206,102 @@ void KnowledgeBase::addReference(const owlapi::model::OWLAxiom::Ptr& modelAxiom,
 
 bool KnowledgeBase::assertAndAddRelation(const IRI& instance, const IRI& relation, const IRI& otherInstance)
 {
-    if( isRelatedTo(instance, relation, otherInstance) )
+    InstanceRelation candidate = { instance, relation, otherInstance };
+    return assertAndAddRelations(InstanceRelation::List(1, candidate)).front();
+}
+
+std::vector<bool> KnowledgeBase::assertAndAddRelations(const InstanceRelation::List& relations)
+{
+    std::vector<bool> added(relations.size(), false);
+
+    // Check all relations before modifying the knowledge base, so that
+    // a single realisation is required
+    std::vector<size_t> candidates;
+    candidates.reserve(relations.size());
+    for(size_t i = 0; i < relations.size(); ++i)
     {
-        return true;
-    } else {
-        // seems to be unknown, or false so try add
-        Axiom a = relatedTo(instance, relation, otherInstance);
-        try {
-            refresh();
-            LOG_DEBUG_S << "'" << instance << "' '" << relation << "' '" << otherInstance << " is true -- added to db";
-            return true;
-        } catch(const std::exception& e)
+        const InstanceRelation& r = relations[i];
+        if(isRelatedTo(r.instance, r.relation, r.otherInstance))
         {
-            // ok, that relation has already be added to the knowledge database
-            retract(a);
-            LOG_DEBUG_S << "'" << instance << "' '" << relation << "' '" << otherInstance << " is false";
-            return false;
+            added[i] = true;
+        } else {
+            candidates.push_back(i);
         }
     }
+
+    if(!candidates.empty())
+    {
+        addConsistentRelations(relations, candidates.begin(), candidates.end(), added);
+    }
+    return added;
 }
 
-DataValue KnowledgeBase::getDataValue(const IRI& instance, const IRI& dataProperty)
+void KnowledgeBase::addConsistentRelations(const InstanceRelation::List& relations,
+        std::vector<size_t>::const_iterator first,
+        std::vector<size_t>::const_iterator last,
+        std::vector<bool>& added)
 {
-    // Iterate over all axioms and filter the relevant one
-    const AxiomVec& axioms = mKernel->getOntology().getAxioms();
-    for(TDLAxiom* axiom : axioms)
+    Axiom::List axioms;
+    for(std::vector<size_t>::const_iterator it = first; it != last; ++it)
+    {
+        const InstanceRelation& r = relations[*it];
+        axioms.push_back( relatedTo(r.instance, r.relation, r.otherInstance) );
+    }
+
+    if(tryRefresh())
     {
-        TDLAxiomValueOf* valueAxiom = dynamic_cast<TDLAxiomValueOf*>(axiom);
+        for(std::vector<size_t>::const_iterator it = first; it != last; ++it)
+        {
+            const InstanceRelation& r = relations[*it];
+            LOG_DEBUG_S << "'" << r.instance << "' '" << r.relation << "' '" << r.otherInstance << " is true -- added to db";
+            added[*it] = true;
+        }
+        return;
+    }
+
+    for(const Axiom& axiom : axioms)
+    {
+        retract(axiom);
+    }
+
+    if(last - first == 1)
+    {
+        const InstanceRelation& r = relations[*first];
+        LOG_DEBUG_S << "'" << r.instance << "' '" << r.relation << "' '" << r.otherInstance << " is false";
+        return;
+    }
 
-        InstanceExpression instanceExpression = getInstance(instance);
-        DataPropertyExpression dataPropertyExpression = getDataProperty(dataProperty);
+    // Keeping the order of the relations, so that the result equals
+    // the one of adding them one by one
+    std::vector<size_t>::const_iterator middle = first + (last - first)/2;
+    addConsistentRelations(relations, first, middle, added);
+    addConsistentRelations(relations, middle, last, added);
+}
+
+bool KnowledgeBase::tryRefresh()
+{
+    try {
+        refresh();
+        return true;
+    } catch(const std::exception& e)
+    {
+        return false;
+    }
+}
 
-        if(valueAxiom && valueAxiom->isUsed() && dataPropertyExpression.get() == valueAxiom->getAttribute() && instanceExpression.get() == valueAxiom->getIndividual())
+DataValue KnowledgeBase::getDataValue(const IRI& instance, const IRI& dataProperty)
+{
+    const Axiom::List* axioms = mValueOfAxioms.find(instance, dataProperty);
+    if(axioms)
+    {
+        for(const Axiom& axiom : *axioms)
         {
-            return DataValue( valueAxiom->getValue());
+            // Axioms might have been retracted in the meantime
+            const TDLAxiomValueOf* valueAxiom = dynamic_cast<const TDLAxiomValueOf*>(axiom.get());
+            if(valueAxiom && valueAxiom->isUsed())
+            {
+                return DataValue( valueAxiom->getValue());
+            }
         }
     }
 
@@ -1953,13 +2382,8 @@ owlapi::model::IRISet KnowledgeBase::getRelatedDataProperties(const IRI& instanc
 {
     owlapi::model::IRISet dataProperties;
 
-    for(const DataValueMap::value_type v : mValueOfAxioms)
-    {
-        if(v.first.first == instance)
-        {
-            dataProperties.insert(v.first.second);
-        }
-    }
+    IRIList properties = mValueOfAxioms.getProperties(instance);
+    dataProperties.insert(properties.begin(), properties.end());
     return dataProperties;
 
     // Factpp has the user API for requesting data property relations, but
@@ -8,8 +8,12 @@
 #include <factpp/Actor.h>
 #include "OWLApi.hpp"
 #include "reasoner/factpp/Types.hpp"
+#include "reasoner/SubsumptionIndex.hpp"
+#include "reasoner/SameAsIndex.hpp"
+#include "reasoner/Taxonomy.hpp"
 #include "model/OWLDataRange.hpp"
 #include "model/OWLObjectOneOf.hpp"
+#include "model/PropertyValueIndex.hpp"
 
 namespace owlapi {
 
@@ -32,7 +36,7 @@ typedef std::map<IRI, reasoner::factpp::InstanceExpression > IRIInstanceExpressi
 typedef std::map<IRI, reasoner::factpp::ObjectPropertyExpression > IRIObjectPropertyExpressionMap;
 typedef std::map<IRI, reasoner::factpp::DataPropertyExpression > IRIDataPropertyExpressionMap;
 typedef std::map<IRI, reasoner::factpp::DataTypeName > IRIDataTypeMap;
-typedef std::map< std::pair<IRI, IRI>, reasoner::factpp::Axiom::List> DataValueMap;
+typedef owlapi::model::PropertyValueIndex<reasoner::factpp::Axiom> DataValueMap;
 typedef std::map<owlapi::model::OWLDataRange::Ptr, reasoner::factpp::DataRange> DataRangeMap;
 
 typedef std::map<owlapi::model::OWLAxiom::Ptr, reasoner::factpp::Axiom::List> ReferencedAxiomsMap;
@@ -57,18 +61,110 @@ class KnowledgeBase
     IRIDataTypeMap mDataTypes;
     DataRangeMap mDataRanges;
 
+    /// valueOf axioms by individual and data property
     DataValueMap mValueOfAxioms;
     ReferencedAxiomsMap mReferencedAxiomsMap;
 
+    /// Revision of the content, increased with every told or retracted axiom
+    uint64_t mRevision;
+    /// Revision of the equality of instances, only increased by axioms
+    /// which might change which instances refer to the same individual
+    uint64_t mEqualityRevision;
+
+    /// Optional index of the classified class hierarchy
+    reasoner::SubsumptionIndex::Ptr mSubsumptionIndex;
+
+    /// Equivalence classes of instances, computed on demand once the
+    /// knowledge base has been realised
+    reasoner::SameAsIndex::Ptr mSameAsIndex;
+    /// Equality revision of the knowledge base when the sameAs index has
+    /// been built
+    uint64_t mSameAsIndexRevision;
+
+    /// Optional precomputed taxonomy, e.g. restored from file
+    reasoner::Taxonomy::Ptr mTaxonomy;
+    /// Revision of the knowledge base when the taxonomy has been set
+    uint64_t mTaxonomyRevision;
+
     bool hasClass(const IRI& klass) const { return mClasses.count(klass); }
 
     bool hasInstance(const IRI& instance) const { return mInstances.count(instance); }
 
     IRIList getResult(const Actor& actor, const IRI& filter = IRI()) const;
 
+    /**
+     * Wrap an axiom which has been told to the kernel and increase the
+     * revision of the knowledge base
+     * \param affectsEquality False for axioms which cannot entail that
+     * instances refer to the same individual, e.g. data property assertions,
+     * so that the sameAs index remains valid
+     */
+    reasoner::factpp::Axiom record(TDLAxiom* axiom, bool affectsEquality = true);
+
+    /**
+     * Retract a data property assertion, which keeps the sameAs index valid
+     * \see retract
+     */
+    void retractValue(const reasoner::factpp::Axiom& axiom);
+
+    /**
+     * Create a data value of a registered datatype
+     * \throw std::invalid_argument if the datatype is unknown
+     */
+    reasoner::factpp::DataValue createDataValue(const std::string& value, const IRI& dataType);
+
+    /**
+     * Check whether the subsumption index can be used, and drop it if it is
+     * outdated
+     */
+    bool useSubsumptionIndex();
+
+    /**
+     * Check whether the sameAs index can be used
+     * \details The index is (re)built if it does not exist or is
+     * outdated, which requires realising the knowledge base
+     */
+    bool useSameAsIndex();
+
+    /**
+     * Check whether a sameAs index for the current state of the
+     * knowledge base exists
+     * \details Axioms which cannot change the equality of instances, i.e.
+     * data property assertions and different individuals, do not invalidate
+     * the index; instances which are not part of the index are answered by
+     * the reasoner
+     */
+    bool hasSameAsIndex() const;
+
+    /**
+     * Remove all individuals which are not an instance of the given class,
+     * using a single instance query for the class
+     * \param klass Filter class, an empty IRI retains all individuals
+     */
+    void retainInstancesOf(IRIList& individuals, const IRI& klass);
+
+    /**
+     * Find the answer to a query in the taxonomy
+     * \return NULL if there is no valid taxonomy or if it does not contain
+     * the answer
+     */
+    const IRIList* findInTaxonomy(reasoner::Taxonomy::Relation relation, const IRI& iri) const;
+
 public:
     typedef shared_ptr<KnowledgeBase> Ptr;
 
+    /**
+     * Relation between two instances
+     */
+    struct InstanceRelation
+    {
+        typedef std::vector<InstanceRelation> List;
+
+        IRI instance;
+        IRI relation;
+        IRI otherInstance;
+    };
+
     enum PropertyType { UNKNOWN_PROPERTY_TYPE, OBJECT, DATA, END_PROPERTY_TYPE };
     enum EntityType { UNKNOWN_ENTITY_TYPE, CLASS, INSTANCE, OBJECT_PROPERTY, DATA_PROPERTY, END_ENTITY_TYPE };
 
@@ -104,6 +200,62 @@ public:
 
     bool isRealized();
 
+    /**
+     * Classify the knowledge base and build an index of the resulting class
+     * hierarchy, so that subsumption queries (isSubClassOf, allSubClassesOf,
+     * allAncestorsOf) are answered without involving the reasoner
+     * \details The index is ignored as soon as the knowledge base is no longer
+     * classified, i.e. after it has been modified, and it is dropped when axioms
+     * are retracted. Call this function again to rebuild it.
+     */
+    void buildSubsumptionIndex();
+
+    /**
+     * Drop the subsumption index
+     */
+    void clearSubsumptionIndex();
+
+    /**
+     * Check if a valid subsumption index is available
+     */
+    bool hasSubsumptionIndex() const;
+
+    /**
+     * Compute a hash of the content of the knowledge base, i.e. of all
+     * axioms, which is independent of the order in which the axioms have
+     * been added
+     */
+    uint64_t getContentHash() const;
+
+    /**
+     * Classify and realize the knowledge base and collect the class
+     * hierarchy, the types of all instances and the property hierarchy
+     * \details The resulting taxonomy can be written to file and reused via
+     * setTaxonomy for a knowledge base with the same content
+     */
+    reasoner::Taxonomy::Ptr computeTaxonomy();
+
+    /**
+     * Answer hierarchy queries (allSubClassesOf, allAncestorsOf,
+     * allEquivalentClasses, typesOf and the property hierarchy) from the
+     * given taxonomy instead of the reasoner
+     * \details The taxonomy is only used if its key matches the content hash
+     * of this knowledge base. It is ignored as soon as the knowledge base
+     * is modified, so that reasoning is deferred until then.
+     * \return true if the taxonomy is used, false if it does not match
+     */
+    bool setTaxonomy(const reasoner::Taxonomy::Ptr& taxonomy);
+
+    /**
+     * Drop the taxonomy
+     */
+    void clearTaxonomy();
+
+    /**
+     * Check if a valid taxonomy is available
+     */
+    bool hasTaxonomy() const;
+
     bool isClassSatisfiable(const IRI& klass);
 
     // ROLES (PROPERTIES)
@@ -673,6 +825,14 @@ public:
      */
     reasoner::factpp::ClassExpression getClassLazy(const IRI& klass);
 
+    /**
+     * Get ClassExpression for given IRI if it exists
+     * \param klass
+     * \return ClassExpression, which holds a NULL pointer if the class does
+     * not exist
+     */
+    reasoner::factpp::ClassExpression tryGetClass(const IRI& klass) const;
+
     /**
      * Retrieve all known classes
      * \return list of all classes
@@ -720,9 +880,25 @@ public:
      */
     reasoner::factpp::InstanceExpression getInstanceLazy(const IRI& instance);
 
+    /**
+     * Get InstanceExpression for a given IRI if it exists
+     * \param instance Identifier of instance
+     * \return InstanceExpression, which holds a NULL pointer if the instance
+     * does not exist
+     */
+    reasoner::factpp::InstanceExpression tryGetInstance(const IRI& instance) const;
+
     reasoner::factpp::ObjectPropertyExpression getObjectProperty(const IRI& property) const;
     reasoner::factpp::ObjectPropertyExpression getObjectPropertyLazy(const IRI& property);
 
+    /**
+     * Get object property if it exists
+     * \param property Name of property
+     * \return ObjectPropertyExpression, which holds a NULL pointer if the
+     * property is not known
+     */
+    reasoner::factpp::ObjectPropertyExpression tryGetObjectProperty(const IRI& property) const;
+
     /**
      * Get property domain
      * \param property Name of property
@@ -752,6 +928,14 @@ public:
      */
     reasoner::factpp::DataPropertyExpression getDataPropertyLazy(const IRI& property);
 
+    /**
+     * Get data property if it exists
+     * \param property Name of property
+     * \return DataPropertyExpression, which holds a NULL pointer if the
+     * property is not known
+     */
+    reasoner::factpp::DataPropertyExpression tryGetDataProperty(const IRI& property) const;
+
     /**
      * Retrieve all known instances
      * \return list of all instances
@@ -925,6 +1109,18 @@ public:
      */
     bool assertAndAddRelation(const IRI& instance, const IRI& relation, const IRI& otherInstance);
 
+    /**
+     * Test relations, i.e. add each relation which keeps the knowledge base
+     * consistent
+     * \details The result is the same as calling assertAndAddRelation for
+     * each relation in the given order. All relations are tested together,
+     * so that a single realisation is required when they are consistent.
+     * Otherwise, the relations are bisected to isolate the inconsistent ones.
+     * \return flag per relation, true if the relation holds or has been
+     * added, false if it would make the knowledge base inconsistent
+     */
+    std::vector<bool> assertAndAddRelations(const InstanceRelation::List& relations);
+
     /**
      * Retrieve data value associated with instance
      * \return data value
@@ -979,6 +1175,22 @@ public:
      * Cleanup all axiom that have been marked for retraction
      */
     void cleanup();
+
+private:
+    /**
+     * Check whether the knowledge base is consistent by refreshing it
+     */
+    bool tryRefresh();
+
+    /**
+     * Add the given relations and keep those which are consistent with the
+     * knowledge base, by bisecting a range which turns out inconsistent
+     * \param added flag per relation, set for relations which have been kept
+     */
+    void addConsistentRelations(const InstanceRelation::List& relations,
+            std::vector<size_t>::const_iterator first,
+            std::vector<size_t>::const_iterator last,
+            std::vector<bool>& added);
 };
 
 } // namespace owlapi
@@ -16,6 +16,8 @@ public:
 
     virtual ~FileBackend() {}
 
+    using query::SparqlInterface::query;
+
     /**
      * Query the filebackend
      * \param query The query string, sparql
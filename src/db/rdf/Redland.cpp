@@ -2,6 +2,7 @@
 #include "../../io/RedlandReader.hpp"
 #include <iostream>
 #include <sstream>
+#include <unordered_map>
 #include <boost/algorithm/string.hpp>
 
 namespace owlapi {
@@ -39,6 +40,21 @@ std::vector<std::string> Redland::getSupportedQueryFormats() const
 query::Results Redland::query(const std::string& query, const query::Bindings& bindings) const
 {
     query::Results results;
+    // Each distinct term is converted only once
+    shared_ptr<query::TermList> terms = make_shared<query::TermList>();
+    std::unordered_map<std::string, query::Results::TermIndex> termIndices;
+    auto getTermIndex = [&terms, &termIndices](const std::string& term) -> query::Results::TermIndex
+    {
+        std::unordered_map<std::string, query::Results::TermIndex>::const_iterator cit = termIndices.find(term);
+        if(cit != termIndices.end())
+        {
+            return cit->second;
+        }
+        query::Results::TermIndex idx = terms->size();
+        terms->push_back(term.empty() ? owlapi::model::IRI() : owlapi::model::IRI(term));
+        termIndices[term] = idx;
+        return idx;
+    };
 
     const unsigned char* query_string = (const unsigned char*) query.c_str();
     librdf_query* rdfQuery = librdf_new_query(mpReader->getWorld(), "sparql", NULL, query_string,
@@ -46,6 +62,7 @@ query::Results Redland::query(const std::string& query, const query::Bindings& b
 
 
     librdf_query_results* rdfResults = librdf_model_query_execute(mpReader->getModel(), rdfQuery);
+    bool initialized = false;
     while( !librdf_query_results_finished(rdfResults))
     {
         const char** names = NULL;
@@ -56,10 +73,20 @@ query::Results Redland::query(const std::string& query, const query::Bindings& b
         }
         if(names)
         {
-            query::Row row;
+            if(!initialized)
+            {
+                query::Bindings variables;
+                for(int i = 0; names[i]; ++i)
+                {
+                    variables.push_back( query::Variable(names[i], false) );
+                }
+                results = query::Results(variables, terms);
+                initialized = true;
+            }
+
+            std::vector<query::Results::TermIndex> row(results.getVariables().size(), query::Results::UNBOUND);
             for(int i = 0; names[i]; ++i)
             {
-                query::Variable variable(names[i], false);
                 librdf_node* node = values[i];
                 if(node == NULL)
                 {
@@ -73,10 +100,7 @@ query::Results Redland::query(const std::string& query, const query::Bindings& b
                     {
                         librdf_uri* uri = librdf_node_get_uri(node);
                         unsigned char* uriStr = librdf_uri_to_string(uri);
-
-                        owlapi::model::IRI valueIri((const char*) uriStr);
-                        row[variable] = valueIri;
-
+                        row[i] = getTermIndex( std::string((const char*) uriStr) );
                         librdf_free_memory(uriStr);
                         break;
                     }
@@ -85,8 +109,8 @@ query::Results Redland::query(const std::string& query, const query::Bindings& b
                         unsigned char* valueStr = librdf_node_get_literal_value(node);
                         if(valueStr == NULL || strlen((const char*) valueStr) == 0)
                         {
-                            row[variable] = owlapi::model::IRI();
-                            continue;
+                            row[i] = getTermIndex( std::string() );
+                            break;
                         }
                         std::string literalValue((const char*) valueStr);
                         librdf_uri* uri = librdf_node_get_literal_value_datatype_uri(node);
@@ -97,17 +121,13 @@ query::Results Redland::query(const std::string& query, const query::Bindings& b
                             literalValue.append((const char*) uriStr);
                             librdf_free_memory(uriStr);
                         }
-
-                        owlapi::model::IRI valueIri(literalValue);
-                        row[variable] = valueIri;
-
+                        row[i] = getTermIndex(literalValue);
                         break;
                     }
                     case LIBRDF_NODE_TYPE_BLANK:
                     {
                         unsigned char* valueStr = librdf_node_get_blank_identifier(node);
-                        owlapi::model::IRI valueIri((const char*) valueStr);
-                        row[variable] = valueIri;
+                        row[i] = getTermIndex( std::string((const char*) valueStr) );
                         break;
                     }
                     default:
@@ -115,7 +135,7 @@ query::Results Redland::query(const std::string& query, const query::Bindings& b
                 }
                 librdf_free_node(values[i]);
             }
-            results.rows.push_back(row);
+            results.addRow(row);
         }
 
         librdf_query_results_next(rdfResults);
@@ -240,6 +240,9 @@ WhereClause::WhereClause(Query* query)
 WhereClause& WhereClause::triple(const db::query::Variable& subject, const db::query::Variable& predicate, const db::query::Variable& object)
 {
     mExpressionList.push_back(subject.getQueryName() + " " + predicate.getQueryName() + " " + object.getQueryName() + " .");
+
+    TriplePattern pattern = { subject, predicate, object };
+    mTriplePatterns.push_back(pattern);
     return *this;
 }
 
@@ -17,11 +17,22 @@ namespace filter {
     enum Option { UNKNOWN_OPTION = 0x00, IGNORE_CASE = 0x01 };
 }
 
+/**
+ * Triple pattern as part of a basic graph pattern
+ */
+struct TriplePattern
+{
+    db::query::Variable subject;
+    db::query::Variable predicate;
+    db::query::Variable object;
+};
+
 class WhereClause
 {
     Query* mQuery;
     std::vector<std::string> mExpressionList;
     std::vector<std::string> mMinusExpressionList;
+    std::vector<TriplePattern> mTriplePatterns;
 
 public:
     WhereClause(Query* query);
@@ -38,6 +49,17 @@ public:
      */
     Query& endWhere();
 
+    /**
+     * Get the triple patterns, i.e. the basic graph pattern of this clause
+     */
+    const std::vector<TriplePattern>& getTriplePatterns() const { return mTriplePatterns; }
+
+    /**
+     * Check if this clause consists of triple patterns only, so that it can
+     * be evaluated without a SPARQL engine
+     */
+    bool isBasicGraphPattern() const { return mMinusExpressionList.empty(); }
+
     std::string toString() const;
 };
 
@@ -101,6 +123,11 @@ public:
      */
     WhereClause& beginWhere() { return mWhere; }
 
+    /**
+     * Get the where part of the query
+     */
+    const WhereClause& getWhereClause() const { return mWhere; }
+
     /**
      * Retrieve bindings of this query, i.e. extracted from the select part
      */
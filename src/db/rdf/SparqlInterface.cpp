@@ -1,5 +1,6 @@
 #include "SparqlInterface.hpp"
 #include <sstream>
+#include <limits>
 #include <boost/regex.hpp>
 #include <base-logging/Logging.hpp>
 
@@ -18,19 +19,83 @@ Variable Subject() { return Any("s"); }
 Variable Object() { return Any("o"); }
 Variable Predicate() { return Any("p"); }
 
+const Results::TermIndex Results::UNBOUND = std::numeric_limits<Results::TermIndex>::max();
+
+Results::Results()
+    : mNumberOfRows(0)
+{}
+
+Results::Results(const Bindings& variables, const shared_ptr<const TermList>& terms)
+    : mVariables(variables)
+    , mColumns(variables.size())
+    , mNumberOfRows(0)
+    , mTerms(terms)
+{}
+
+void Results::addRow(const std::vector<TermIndex>& row)
+{
+    if(row.size() != mColumns.size())
+    {
+        throw std::invalid_argument("owlapi::db::query::Results::addRow: row has"
+                " an invalid number of columns");
+    }
+    for(size_t c = 0; c < mColumns.size(); ++c)
+    {
+        mColumns[c].push_back(row[c]);
+    }
+    ++mNumberOfRows;
+}
+
+bool Results::getColumn(const Variable& variable, size_t& column) const
+{
+    for(size_t c = 0; c < mVariables.size(); ++c)
+    {
+        if(mVariables[c] == variable)
+        {
+            column = c;
+            return true;
+        }
+    }
+    return false;
+}
+
+const owlapi::model::IRI* Results::get(size_t row, size_t column) const
+{
+    TermIndex idx = mColumns[column][row];
+    if(idx == UNBOUND)
+    {
+        return NULL;
+    }
+    return &(*mTerms)[idx];
+}
+
+Row Results::getRow(size_t row) const
+{
+    Row rowMap;
+    for(size_t c = 0; c < mColumns.size(); ++c)
+    {
+        const owlapi::model::IRI* term = get(row, c);
+        if(term)
+        {
+            rowMap[ mVariables[c] ] = *term;
+        }
+    }
+    return rowMap;
+}
+
 std::string Results::toString() const
 {
     std::stringstream txt;
-    std::vector<Row>::const_iterator rit = rows.begin();
-    int count = 0;
-    for(; rit != rows.end(); ++rit)
+    for(size_t r = 0; r < size(); ++r)
     {
-        Row::const_iterator cit = rit->begin();
-
-        txt << "--- #" << count++ << " ---" << std::endl;
-        for(; cit != rit->end(); ++cit)
+        txt << "--- #" << r << " ---" << std::endl;
+        for(size_t c = 0; c < mColumns.size(); ++c)
         {
-            txt << "    " << cit->first << ": " << cit->second << std::endl;
+            const owlapi::model::IRI* term = get(r, c);
+            if(term)
+            {
+                txt << "    " << mVariables[c] << ": " << *term << std::endl;
+            }
         }
     }
 
@@ -39,44 +104,51 @@ std::string Results::toString() const
 
 ResultsIterator::ResultsIterator(const Results& results)
     : mResults(results)
+    , mRow(0)
     , mInitialized(false)
 {
-    mRowIterator = mResults.rows.begin();
 }
 
 bool ResultsIterator::next()
 {
     if(mInitialized)
     {
-        ++mRowIterator;
+        ++mRow;
     } else {
         mInitialized = true;
     }
 
-    return mRowIterator != mResults.rows.end();
+    return mRow < mResults.size();
 }
 
-owlapi::model::IRI ResultsIterator::operator[](const Variable& variable) const
+const owlapi::model::IRI& ResultsIterator::operator[](const Variable& variable) const
 {
-    // Retrieve row that matches the requested variable
-    Row::iterator cit =  mRowIterator->find(variable);
-    if( mRowIterator->end() != cit)
+    // Retrieve the column that matches the requested variable
+    size_t column;
+    if(mResults.getColumn(variable, column))
     {
-        return cit->second;
+        const owlapi::model::IRI* term = mResults.get(mRow, column);
+        if(term)
+        {
+            return *term;
+        }
     }
 
     // For error handling
     std::string bindings;
-    cit = mRowIterator->begin();
-    for(; cit != mRowIterator->end(); ++cit)
+    for(const Variable& v : mResults.getVariables())
     {
-        Variable variable = cit->first;
-        bindings += variable.getQueryName() + ",";
+        bindings += v.getQueryName() + ",";
     }
     std::string msg = "owlapi::db::query::ResultsIterator: unknown binding for '" + variable.getQueryName() + "' known are: " + bindings;
     throw std::runtime_error(msg);
 }
 
+Results SparqlInterface::query(const rdf::sparql::Query& query) const
+{
+    return this->query(query.toString(), query.getBindings());
+}
+
 Results SparqlInterface::findAll(const Variable& subject, const Variable& predicate, const Variable& object) const
 {
     using namespace owlapi::db::rdf::sparql;
@@ -2,14 +2,22 @@
 #define OWLAPI_DB_QUERY_SPARQL_INTERFACE_HPP
 
 #include <vector>
+#include <deque>
 #include <map>
 #include <string>
 #include <stdexcept>
+#include <owlapi/SharedPtr.hpp>
 #include <owlapi/db/rdf/Variable.hpp>
 #include <owlapi/Vocabulary.hpp>
 
 namespace owlapi {
 namespace db {
+namespace rdf {
+namespace sparql {
+class Query;
+}
+}
+
 namespace query {
 
 /**
@@ -21,21 +29,92 @@ extern Variable Predicate();
 extern Variable Any(const std::string& label);
 
 typedef std::map<Variable, owlapi::model::IRI> Row;
-struct Results
+
+/**
+ * List of terms referred to by query results
+ * \details Appending terms does not move existing ones, so that a list can
+ * grow while results and iterators refer to its entries
+ */
+typedef std::deque<owlapi::model::IRI> TermList;
+
+/**
+ * \class Results
+ * \brief Columnar result set of a query
+ * \details Results store one column per variable. Each cell refers to an
+ * entry of a term list, which can be shared with the database, so that
+ * results do not require any IRI to be constructed.
+ */
+class Results
 {
-    std::vector<Row> rows;
+public:
+    typedef uint32_t TermIndex;
+
+    /// Index of cells without a binding
+    static const TermIndex UNBOUND;
+
+    Results();
+
+    /**
+     * Create an empty result set
+     * \param variables Ungrounded variables, one column per variable
+     * \param terms Term list the cells refer to
+     */
+    Results(const Bindings& variables, const shared_ptr<const TermList>& terms);
+
+    /**
+     * Append a row
+     * \param row Index into the term list per column, or UNBOUND
+     */
+    void addRow(const std::vector<TermIndex>& row);
+
+    /**
+     * Get the number of rows
+     */
+    size_t size() const { return mNumberOfRows; }
+
+    bool empty() const { return size() == 0; }
+
+    /**
+     * Get the variables, i.e. the columns of this result set
+     */
+    const Bindings& getVariables() const { return mVariables; }
+
+    /**
+     * Get the column of a variable
+     * \return true if the variable is part of the result set, false otherwise
+     */
+    bool getColumn(const Variable& variable, size_t& column) const;
+
+    /**
+     * Get the term of a cell
+     * \return NULL if the cell has no binding
+     */
+    const owlapi::model::IRI* get(size_t row, size_t column) const;
+
+    /**
+     * Get a row as map, i.e. copying all bound terms
+     */
+    Row getRow(size_t row) const;
+
     std::string toString() const;
 
-    bool empty() { return rows.empty(); }
+private:
+    Bindings mVariables;
+    std::vector< std::vector<TermIndex> > mColumns;
+    size_t mNumberOfRows;
+    shared_ptr<const TermList> mTerms;
 };
 
 /**
  * \class ResultIterator
+ * \brief Iterate over the rows of a result set
+ * \details The iterator refers to the result set, which has to outlive the
+ * iterator
  */
 class ResultsIterator
 {
-    Results mResults;
-    std::vector<Row>::iterator mRowIterator;
+    const Results& mResults;
+    size_t mRow;
 
     bool mInitialized;
 
@@ -44,7 +123,11 @@ public:
 
     bool next();
 
-    owlapi::model::IRI operator[](const Variable& name) const;
+    /**
+     * Get the term bound to a variable in the current row
+     * \throw std::runtime_error if the variable has no binding
+     */
+    const owlapi::model::IRI& operator[](const Variable& name) const;
 };
 
 /**
@@ -81,11 +164,19 @@ public:
      */
     virtual Results query(const std::string& query, const Bindings& bindings) const { throw std::runtime_error("owlapi::db::query::SparqlInterface not implemented"); }
 
+    /**
+     * Send a programmatically created query to the underlying database
+     * \details The default implementation serializes the query and forwards
+     * it to the string based query function
+     * \param query The query
+     */
+    virtual Results query(const rdf::sparql::Query& query) const;
+
     /**
      * Retrieve results when matching the given triple definition
      * \return Results List of Rows
      */
-    Results findAll(const Variable& subject, const Variable& predicate, const Variable& object) const;
+    virtual Results findAll(const Variable& subject, const Variable& predicate, const Variable& object) const;
 };
 
 } // end namespace query
@@ -0,0 +1,328 @@
+#include "TripleStore.hpp"
+#include <algorithm>
+#include <limits>
+#include <boost/functional/hash.hpp>
+
+namespace owlapi {
+namespace db {
+
+const uint32_t TripleStore::NO_TERM = std::numeric_limits<uint32_t>::max();
+
+size_t TripleStore::TripleHash::operator()(const Triple& triple) const
+{
+    size_t seed = 0;
+    boost::hash_combine(seed, triple.subject);
+    boost::hash_combine(seed, triple.predicate);
+    boost::hash_combine(seed, triple.object);
+    return seed;
+}
+
+TripleStore::TripleStore()
+    : mTerms(make_shared<query::TermList>())
+{}
+
+TripleStore::TermId TripleStore::getOrCreateTerm(const std::string& term)
+{
+    std::unordered_map<std::string, TermId>::const_iterator cit = mTermIds.find(term);
+    if(cit != mTermIds.end())
+    {
+        return cit->second;
+    }
+
+    TermId id = mTerms->size();
+    if(id == NO_TERM)
+    {
+        throw std::runtime_error("owlapi::db::TripleStore::getOrCreateTerm: maximum number of terms exceeded");
+    }
+    if(term.empty())
+    {
+        // Empty literals are represented by an empty IRI
+        mTerms->push_back(model::IRI());
+    } else {
+        mTerms->push_back(model::IRI(term));
+    }
+    mTermIds[term] = id;
+    return id;
+}
+
+bool TripleStore::add(const std::string& subject, const std::string& predicate, const std::string& object)
+{
+    Triple triple;
+    triple.subject = getOrCreateTerm(subject);
+    triple.predicate = getOrCreateTerm(predicate);
+    triple.object = getOrCreateTerm(object);
+    return add(triple);
+}
+
+bool TripleStore::add(const Triple& triple)
+{
+    TermId numberOfTerms = mTerms->size();
+    if(triple.subject >= numberOfTerms || triple.predicate >= numberOfTerms || triple.object >= numberOfTerms)
+    {
+        throw std::invalid_argument("owlapi::db::TripleStore::add: triple refers to an unknown term");
+    }
+
+    if(!mTripleSet.insert(triple).second)
+    {
+        return false;
+    }
+
+    uint32_t idx = mTriples.size();
+    mTriples.push_back(triple);
+    mSubjectIndex[triple.subject].push_back(idx);
+    mPredicateIndex[triple.predicate].push_back(idx);
+    mObjectIndex[triple.object].push_back(idx);
+    return true;
+}
+
+bool TripleStore::add(const model::IRI& subject, const model::IRI& predicate, const model::IRI& object)
+{
+    return add(subject.toString(), predicate.toString(), object.toString());
+}
+
+void TripleStore::reserve(size_t numberOfTerms, size_t numberOfTriples)
+{
+    mTermIds.reserve(numberOfTerms);
+    mTriples.reserve(numberOfTriples);
+    mTripleSet.reserve(numberOfTriples);
+}
+
+void TripleStore::clear()
+{
+    // Existing results keep referring to the previous terms
+    mTerms = make_shared<query::TermList>();
+    mTermIds.clear();
+    mTriples.clear();
+    mTripleSet.clear();
+    mSubjectIndex.clear();
+    mPredicateIndex.clear();
+    mObjectIndex.clear();
+}
+
+bool TripleStore::findTerm(const query::Variable& variable, TermId& id) const
+{
+    std::string term = variable.toString();
+    // Variables mark blank nodes with a prefix, see query::Variable
+    if(term.compare(0, 2, "_:") == 0)
+    {
+        term = term.substr(2);
+    }
+
+    std::unordered_map<std::string, TermId>::const_iterator cit = mTermIds.find(term);
+    if(cit == mTermIds.end())
+    {
+        return false;
+    }
+    id = cit->second;
+    return true;
+}
+
+query::Results TripleStore::findAll(const query::Variable& subject, const query::Variable& predicate, const query::Variable& object) const
+{
+    rdf::sparql::TriplePattern pattern = { subject, predicate, object };
+    query::Bindings bindings;
+    bindings.push_back(subject);
+    bindings.push_back(predicate);
+    bindings.push_back(object);
+    return evaluate(std::vector<rdf::sparql::TriplePattern>(1, pattern), bindings);
+}
+
+query::Results TripleStore::query(const rdf::sparql::Query& query) const
+{
+    const rdf::sparql::WhereClause& where = query.getWhereClause();
+    if(!where.isBasicGraphPattern())
+    {
+        throw std::invalid_argument("owlapi::db::TripleStore::query: only queries"
+                " consisting of a basic graph pattern are supported");
+    }
+    return evaluate(where.getTriplePatterns(), query.getBindings());
+}
+
+query::Results TripleStore::evaluate(const std::vector<rdf::sparql::TriplePattern>& triplePatterns,
+        const query::Bindings& bindings) const
+{
+    // Compile the patterns, mapping variables to a dense index
+    std::unordered_map<model::IRI, uint32_t> variables;
+    std::vector<Pattern> patterns;
+    bool satisfiable = true;
+    for(const rdf::sparql::TriplePattern& triplePattern : triplePatterns)
+    {
+        const query::Variable* terms[3] = { &triplePattern.subject, &triplePattern.predicate, &triplePattern.object };
+        Pattern pattern;
+        for(size_t i = 0; i < 3; ++i)
+        {
+            const query::Variable& term = *terms[i];
+            Slot& slot = pattern.slots[i];
+            if(term.isGrounded())
+            {
+                slot.isVariable = false;
+                if(!findTerm(term, slot.value))
+                {
+                    // A pattern with an unknown term cannot match
+                    satisfiable = false;
+                }
+            } else {
+                slot.isVariable = true;
+                std::unordered_map<model::IRI, uint32_t>::const_iterator cit = variables.find(term);
+                if(cit == variables.end())
+                {
+                    slot.value = variables.size();
+                    variables[term] = slot.value;
+                } else {
+                    slot.value = cit->second;
+                }
+            }
+        }
+        patterns.push_back(pattern);
+    }
+
+    // Order the patterns such that each pattern shares as many bound slots
+    // as possible with its predecessors
+    std::vector<bool> bound(variables.size(), false);
+    std::vector<Pattern> ordered;
+    while(!patterns.empty())
+    {
+        size_t best = 0;
+        int bestScore = -1;
+        for(size_t p = 0; p < patterns.size(); ++p)
+        {
+            int score = 0;
+            for(const Slot& slot : patterns[p].slots)
+            {
+                if(!slot.isVariable || bound[slot.value])
+                {
+                    ++score;
+                }
+            }
+            if(score > bestScore)
+            {
+                best = p;
+                bestScore = score;
+            }
+        }
+        for(const Slot& slot : patterns[best].slots)
+        {
+            if(slot.isVariable)
+            {
+                bound[slot.value] = true;
+            }
+        }
+        ordered.push_back(patterns[best]);
+        patterns.erase(patterns.begin() + best);
+    }
+
+    // Only ungrounded variables which are part of the pattern are reported
+    query::Bindings selectedVariables;
+    std::vector<uint32_t> selection;
+    for(const query::Variable& variable : bindings)
+    {
+        if(variable.isGrounded())
+        {
+            continue;
+        }
+        std::unordered_map<model::IRI, uint32_t>::const_iterator cit = variables.find(variable);
+        if(cit == variables.end()
+                || std::find(selection.begin(), selection.end(), cit->second) != selection.end())
+        {
+            continue;
+        }
+        selectedVariables.push_back(variable);
+        selection.push_back(cit->second);
+    }
+
+    query::Results results(selectedVariables, mTerms);
+    if(satisfiable)
+    {
+        std::vector<TermId> binding(variables.size(), NO_TERM);
+        match(ordered, 0, binding, selection, results);
+    }
+    return results;
+}
+
+const TripleStore::TripleIndexList* TripleStore::getCandidates(const Pattern& pattern, const std::vector<TermId>& binding) const
+{
+    const TermIndex* indexes[3] = { &mSubjectIndex, &mPredicateIndex, &mObjectIndex };
+    static const TripleIndexList empty;
+
+    const TripleIndexList* candidates = NULL;
+    for(size_t i = 0; i < 3; ++i)
+    {
+        const Slot& slot = pattern.slots[i];
+        TermId term = slot.isVariable ? binding[slot.value] : slot.value;
+        if(term == NO_TERM)
+        {
+            continue;
+        }
+
+        TermIndex::const_iterator cit = indexes[i]->find(term);
+        if(cit == indexes[i]->end())
+        {
+            return &empty;
+        }
+        if(!candidates || cit->second.size() < candidates->size())
+        {
+            candidates = &cit->second;
+        }
+    }
+    return candidates;
+}
+
+void TripleStore::match(const std::vector<Pattern>& patterns, size_t depth,
+        std::vector<TermId>& binding,
+        const std::vector<uint32_t>& selection,
+        query::Results& results) const
+{
+    if(depth == patterns.size())
+    {
+        std::vector<query::Results::TermIndex> row;
+        row.reserve(selection.size());
+        for(uint32_t variable : selection)
+        {
+            row.push_back(binding[variable]);
+        }
+        results.addRow(row);
+        return;
+    }
+
+    const Pattern& pattern = patterns[depth];
+    const TripleIndexList* candidates = getCandidates(pattern, binding);
+    size_t numberOfCandidates = candidates ? candidates->size() : mTriples.size();
+
+    for(size_t c = 0; c < numberOfCandidates; ++c)
+    {
+        const Triple& triple = mTriples[ candidates ? (*candidates)[c] : c ];
+        const TermId terms[3] = { triple.subject, triple.predicate, triple.object };
+
+        // Variables which have been bound by this triple
+        uint32_t assigned[3];
+        size_t numberOfAssigned = 0;
+        bool matches = true;
+        for(size_t i = 0; i < 3 && matches; ++i)
+        {
+            const Slot& slot = pattern.slots[i];
+            if(!slot.isVariable)
+            {
+                matches = slot.value == terms[i];
+            } else if(binding[slot.value] == NO_TERM)
+            {
+                binding[slot.value] = terms[i];
+                assigned[numberOfAssigned++] = slot.value;
+            } else {
+                matches = binding[slot.value] == terms[i];
+            }
+        }
+
+        if(matches)
+        {
+            match(patterns, depth + 1, binding, selection, results);
+        }
+
+        for(size_t a = 0; a < numberOfAssigned; ++a)
+        {
+            binding[ assigned[a] ] = NO_TERM;
+        }
+    }
+}
+
+} // end namespace db
+} // end namespace owlapi
@@ -0,0 +1,184 @@
+#ifndef OWLAPI_DB_TRIPLE_STORE_HPP
+#define OWLAPI_DB_TRIPLE_STORE_HPP
+
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "Sparql.hpp"
+
+namespace owlapi {
+namespace db {
+
+/**
+ * \class TripleStore
+ * \brief Compact in-memory table of RDF triples
+ * \details Every distinct term is stored only once and triples refer to terms
+ * by a numeric id. Triples are indexed by subject, predicate and object, so
+ * that findAll and basic graph pattern queries can be answered without a
+ * SPARQL engine.
+ * Query results share the term table of the store, so that no IRI is
+ * constructed while querying.
+ * Terms follow the conversion of the Redland backend: resources are
+ * represented by their URI, literals as value^^datatype and blank nodes by
+ * their identifier. Unlike in SPARQL, a grounded blank node in a pattern
+ * refers to this very node and does not act as a variable.
+ */
+class TripleStore : public query::SparqlInterface
+{
+public:
+    typedef shared_ptr<TripleStore> Ptr;
+    typedef uint32_t TermId;
+
+    struct Triple
+    {
+        TermId subject;
+        TermId predicate;
+        TermId object;
+
+        bool operator==(const Triple& other) const
+        {
+            return subject == other.subject && predicate == other.predicate && object == other.object;
+        }
+    };
+
+    TripleStore();
+
+    virtual ~TripleStore() {}
+
+    /**
+     * Add a triple
+     * \return true if the triple has been added, false if it was already known
+     */
+    bool add(const std::string& subject, const std::string& predicate, const std::string& object);
+
+    /**
+     * Add a triple
+     * \return true if the triple has been added, false if it was already known
+     */
+    bool add(const model::IRI& subject, const model::IRI& predicate, const model::IRI& object);
+
+    /**
+     * Add a term
+     * \return id of the (existing or added) term
+     */
+    TermId addTerm(const std::string& term) { return getOrCreateTerm(term); }
+
+    /**
+     * Add a triple of known terms
+     * \return true if the triple has been added, false if it was already known
+     * \throw std::invalid_argument if the triple refers to an unknown term
+     */
+    bool add(const Triple& triple);
+
+    /**
+     * Get the term of a given id
+     */
+    const model::IRI& getTerm(TermId id) const { return mTerms->at(id); }
+
+    /**
+     * Get all triples in the order they have been added
+     */
+    const std::vector<Triple>& getTriples() const { return mTriples; }
+
+    /**
+     * Reserve memory for the given number of terms and triples
+     */
+    void reserve(size_t numberOfTerms, size_t numberOfTriples);
+
+    /**
+     * Remove all triples and terms
+     */
+    void clear();
+
+    /**
+     * Get the number of triples
+     */
+    size_t size() const { return mTriples.size(); }
+
+    /**
+     * Get the number of distinct terms
+     */
+    size_t getNumberOfTerms() const { return mTerms->size(); }
+
+    /**
+     * Retrieve results when matching the given triple definition
+     * \return Results List of rows, containing the ungrounded variables only
+     */
+    query::Results findAll(const query::Variable& subject, const query::Variable& predicate, const query::Variable& object) const;
+
+    /**
+     * Evaluate a query consisting of a basic graph pattern
+     * \throw std::invalid_argument if the query is not a basic graph pattern
+     */
+    query::Results query(const rdf::sparql::Query& query) const;
+
+    using query::SparqlInterface::query;
+
+private:
+    struct TripleHash
+    {
+        size_t operator()(const Triple& triple) const;
+    };
+
+    typedef std::vector<uint32_t> TripleIndexList;
+    typedef std::unordered_map<TermId, TripleIndexList> TermIndex;
+
+    /// Slot of a triple pattern: either a constant term or a variable
+    struct Slot
+    {
+        bool isVariable;
+        /// Term id for constants, variable index otherwise
+        uint32_t value;
+    };
+
+    struct Pattern
+    {
+        Slot slots[3];
+    };
+
+    static const uint32_t NO_TERM;
+
+    TermId getOrCreateTerm(const std::string& term);
+
+    /**
+     * Evaluate the conjunction of the given triple patterns
+     * \param bindings Variables to report in the result rows
+     */
+    query::Results evaluate(const std::vector<rdf::sparql::TriplePattern>& triplePatterns,
+            const query::Bindings& bindings) const;
+
+    /**
+     * Find the term id of a grounded variable
+     * \return true if the term is known, false otherwise
+     */
+    bool findTerm(const query::Variable& variable, TermId& id) const;
+
+    /**
+     * Get the list of candidate triples for the given pattern, using the
+     * most selective index of the bound slots
+     * \return NULL if all triples are candidates
+     */
+    const TripleIndexList* getCandidates(const Pattern& pattern, const std::vector<TermId>& binding) const;
+
+    void match(const std::vector<Pattern>& patterns, size_t depth,
+            std::vector<TermId>& binding,
+            const std::vector<uint32_t>& selection,
+            query::Results& results) const;
+
+    /// Terms indexed by their id, shared with the query results
+    shared_ptr<query::TermList> mTerms;
+    std::unordered_map<std::string, TermId> mTermIds;
+
+    std::vector<Triple> mTriples;
+    std::unordered_set<Triple, TripleHash> mTripleSet;
+
+    TermIndex mSubjectIndex;
+    TermIndex mPredicateIndex;
+    TermIndex mObjectIndex;
+};
+
+} // end namespace db
+} // end namespace owlapi
+#endif // OWLAPI_DB_TRIPLE_STORE_HPP
@@ -15,6 +15,7 @@ Variable::Variable(const IRI& iri)
     if(iri.toString().find("genid") != std::string::npos)
     {
         mPrefix = "_:" + mPrefix;
+        mId = model::IRIRegistry::intern(toString());
     }
 }
 
@@ -35,6 +36,7 @@ Variable::Variable(const std::string& name, bool grounded)
         } else {
             mPrefix = name;
         }
+        mId = model::IRIRegistry::intern(toString());
     }
 }
 
@@ -0,0 +1,196 @@
+#ifndef OWLAPI_IO_BINARY_IO_HPP
+#define OWLAPI_IO_BINARY_IO_HPP
+
+#include <stdint.h>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace owlapi {
+namespace io {
+
+// Helpers for the versioned binary file formats, i.e. ontology snapshots and
+// taxonomies. Values are written in native byte order; a file starts with an
+// 8 byte magic, the format version and a byte order mark, so that files
+// written with another version or byte order are rejected when reading.
+// Error messages are prefixed with the context given by the caller, e.g.
+// "owlapi::io::OWLOntologySnapshot::read".
+
+/// Marker to detect files which have been written with a different byte order
+const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+/**
+ * Read-only memory mapping of a file
+ */
+class MappedFile
+{
+public:
+    MappedFile(const std::string& filename, const std::string& context)
+        : mData(NULL)
+        , mSize(0)
+    {
+        int fd = open(filename.c_str(), O_RDONLY);
+        if(fd < 0)
+        {
+            throw std::runtime_error(context + ": failed to open '" + filename + "'");
+        }
+
+        struct stat fileStat;
+        if(fstat(fd, &fileStat) != 0)
+        {
+            close(fd);
+            throw std::runtime_error(context + ": failed to stat '" + filename + "'");
+        }
+
+        mSize = fileStat.st_size;
+        if(mSize != 0)
+        {
+            void* data = mmap(NULL, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+            if(data == MAP_FAILED)
+            {
+                close(fd);
+                throw std::runtime_error(context + ": failed to map '" + filename + "'");
+            }
+            mData = static_cast<const char*>(data);
+        }
+        close(fd);
+    }
+
+    ~MappedFile()
+    {
+        if(mData)
+        {
+            munmap(const_cast<char*>(mData), mSize);
+        }
+    }
+
+    const char* data() const { return mData; }
+    size_t size() const { return mSize; }
+
+private:
+    MappedFile(const MappedFile&);
+    MappedFile& operator=(const MappedFile&);
+
+    const char* mData;
+    size_t mSize;
+};
+
+/**
+ * Sequential, bounds checked reading from a buffer
+ */
+class BufferReader
+{
+public:
+    BufferReader(const char* data, size_t size, const std::string& filename,
+            const std::string& context)
+        : mPos(data)
+        , mEnd(data + size)
+        , mFilename(filename)
+        , mContext(context)
+    {}
+
+    template<typename T>
+    T read()
+    {
+        T value;
+        memcpy(&value, consume(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    std::string readString()
+    {
+        uint32_t length = read<uint32_t>();
+        return std::string(consume(length), length);
+    }
+
+    /**
+     * Read the number of elements that follow
+     * \param minElementSize Minimum number of bytes each element occupies
+     * \throw std::runtime_error if the remaining data cannot hold that many
+     * elements, so that a corrupt count does not cause a huge allocation
+     */
+    uint32_t readCount(size_t minElementSize)
+    {
+        uint32_t count = read<uint32_t>();
+        if(minElementSize != 0 && count > static_cast<size_t>(mEnd - mPos) / minElementSize)
+        {
+            throw std::runtime_error(mContext + ": invalid element count in '"
+                    + mFilename + "'");
+        }
+        return count;
+    }
+
+    const char* consume(size_t size)
+    {
+        if(static_cast<size_t>(mEnd - mPos) < size)
+        {
+            throw std::runtime_error(mContext + ": unexpected end of file '"
+                    + mFilename + "'");
+        }
+        const char* pos = mPos;
+        mPos += size;
+        return pos;
+    }
+
+    /**
+     * Read the file header and check magic, version and byte order
+     * \param type Name of the file type to report if the magic does not match
+     * \throw std::runtime_error if the header does not match
+     */
+    void readHeader(const char (&magic)[8], uint32_t version, const std::string& type)
+    {
+        if(memcmp(consume(sizeof(magic)), magic, sizeof(magic)) != 0)
+        {
+            throw std::runtime_error(mContext + ": '" + mFilename + "' is not a " + type);
+        }
+        uint32_t fileVersion = read<uint32_t>();
+        if(fileVersion != version)
+        {
+            throw std::runtime_error(mContext + ": '" + mFilename + "' has version "
+                    + std::to_string(fileVersion) + ", but version "
+                    + std::to_string(version) + " is required");
+        }
+        if(read<uint32_t>() != BYTE_ORDER_MARK)
+        {
+            throw std::runtime_error(mContext + ": '" + mFilename
+                    + "' has been written with a different byte order");
+        }
+    }
+
+private:
+    const char* mPos;
+    const char* mEnd;
+    std::string mFilename;
+    std::string mContext;
+};
+
+template<typename T>
+inline void writeValue(std::ofstream& out, const T& value)
+{
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+inline void writeString(std::ofstream& out, const std::string& value)
+{
+    writeValue<uint32_t>(out, value.size());
+    out.write(value.data(), value.size());
+}
+
+/**
+ * Write the file header, i.e. magic, version and byte order mark
+ */
+inline void writeHeader(std::ofstream& out, const char (&magic)[8], uint32_t version)
+{
+    out.write(magic, sizeof(magic));
+    writeValue(out, version);
+    writeValue(out, BYTE_ORDER_MARK);
+}
+
+} // end namespace io
+} // end namespace owlapi
+#endif // OWLAPI_IO_BINARY_IO_HPP
@@ -1,9 +1,16 @@
 #include "OWLOntologyIO.hpp"
 #include "RedlandWriter.hpp"
 #include "OWLOntologyReader.hpp"
+#include "OWLOntologySnapshot.hpp"
 #include <utilmm/configfile/pkgconfig.hh>
 #include <algorithm>
+#include <atomic>
+#include <exception>
 #include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <boost/filesystem.hpp>
 
 #include <owlapi/Vocabulary.hpp>
@@ -13,6 +20,70 @@ using namespace owlapi::model;
 namespace owlapi {
 namespace io {
 
+namespace {
+
+/**
+ * Get the canonical path of an ontology document
+ * \throw OWLOntologyNotFound if the file does not exist
+ */
+std::string getDocumentPath(const std::string& filename)
+{
+    if(!boost::filesystem::exists(filename))
+    {
+        throw OWLOntologyNotFound("owlapi::io::OWLOntologyIO::fromFile: file '"
+                + filename + "' does not exist");
+    }
+    return boost::filesystem::canonical(filename).string();
+}
+
+/**
+ * Call the given function for all indices in [0, count) using a pool of up
+ * to hardware_concurrency threads
+ * \throw the first exception raised by any of the calls
+ */
+void parallelFor(size_t count, const std::function<void (size_t)>& function)
+{
+    size_t numberOfThreads = std::min<size_t>(count, std::max(1u, std::thread::hardware_concurrency()));
+    std::atomic<size_t> next(0);
+    std::exception_ptr error;
+    std::mutex errorMutex;
+
+    auto worker = [&]()
+    {
+        for(size_t i = next++; i < count; i = next++)
+        {
+            try {
+                function(i);
+            } catch(...)
+            {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if(!error)
+                {
+                    error = std::current_exception();
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for(size_t t = 1; t < numberOfThreads; ++t)
+    {
+        threads.push_back( std::thread(worker) );
+    }
+    worker();
+    for(std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    if(error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+} // end anonymous namespace
+
 std::map<Format, std::string> FormatTxt =
 {
     { RDFXML, "rdfxml" },
@@ -77,6 +148,15 @@ owlapi::model::OWLOntology::Ptr OWLOntologyIO::load(owlapi::model::OWLOntology::
         const owlapi::model::IRI& ontologyIRI,
         bool isEmptyTopOntology
         )
+{
+    return load(ontology, ontologyIRI, isEmptyTopOntology, NULL);
+}
+
+owlapi::model::OWLOntology::Ptr OWLOntologyIO::load(owlapi::model::OWLOntology::Ptr& ontology,
+        const owlapi::model::IRI& ontologyIRI,
+        bool isEmptyTopOntology,
+        OWLOntologySnapshot* snapshot
+        )
 {
     using namespace owlapi::model;
 
@@ -125,56 +205,77 @@ owlapi::model::OWLOntology::Ptr OWLOntologyIO::load(owlapi::model::OWLOntology::
     std::map<IRI, IRISet> dependencies;
 
     // load declarations and imports
+    // The documents are discovered level by level: all documents of one level
+    // are parsed concurrently and their direct imports form the next level
     while(!unprocessed.empty())
     {
-        IRI iri = unprocessed.back();
-        unprocessed.pop_back();
-
-        // Check on inbuilt
-        std::string iriString = iri.toString();
-        if(strncmp(iriString.c_str(), vocabulary::OWL::IRIPrefix().toString().c_str(), iriString.size()) == 0)
-        {
-            LOG_INFO_S << "Skipping import of builtin vocabulary: " << iri;
-            continue;
-        } else if(strncmp(iriString.c_str(), vocabulary::RDF::IRIPrefix().toString().c_str(), iriString.size()) == 0)
+        IRIList pending;
+        for(const IRI& iri : unprocessed)
         {
-            LOG_INFO_S << "Skipping import of builtin vocabulary: " << iri;
-            continue;
-        } else if(strncmp(iriString.c_str(), vocabulary::RDFS::IRIPrefix().toString().c_str(), iriString.size()) == 0)
-        {
-            LOG_INFO_S << "Skipping import of builtin vocabulary: " << iri;
-            continue;
+            // Check on inbuilt
+            std::string iriString = iri.toString();
+            if(strncmp(iriString.c_str(), vocabulary::OWL::IRIPrefix().toString().c_str(), iriString.size()) == 0)
+            {
+                LOG_INFO_S << "Skipping import of builtin vocabulary: " << iri;
+                continue;
+            } else if(strncmp(iriString.c_str(), vocabulary::RDF::IRIPrefix().toString().c_str(), iriString.size()) == 0)
+            {
+                LOG_INFO_S << "Skipping import of builtin vocabulary: " << iri;
+                continue;
+            } else if(strncmp(iriString.c_str(), vocabulary::RDFS::IRIPrefix().toString().c_str(), iriString.size()) == 0)
+            {
+                LOG_INFO_S << "Skipping import of builtin vocabulary: " << iri;
+                continue;
+            }
+
+            if(processed.end() != std::find(processed.begin(), processed.end(), iri)
+                    || pending.end() != std::find(pending.begin(), pending.end(), iri))
+            {
+                // has already been processed
+                continue;
+            }
+
+            LOG_DEBUG_S << "Processing: " << iri;
+            pending.push_back(iri);
         }
+        unprocessed.clear();
 
-        if(processed.end() != std::find(processed.begin(), processed.end(), iri))
+        // Retrieval might require a download, so it is done sequentially
+        std::vector<std::string> filenames;
+        std::vector< std::unique_ptr<OWLOntologyReader> > importReaders;
+        for(const IRI& iri : pending)
         {
-            // has already been processed, but to satisfy earlier dependency
-            // requests append this iri if requested
-            processed.push_back(iri);
-            continue;
+            filenames.push_back( retrieve(iri) );
+            importReaders.push_back( std::unique_ptr<OWLOntologyReader>(new OWLOntologyReader()) );
         }
 
-        LOG_DEBUG_S << "Processing: " << iri;
-
-        std::string filename = retrieve(iri);
+        parallelFor(pending.size(), [&filenames, &importReaders](size_t i)
+                {
+                    importReaders[i]->read(filenames[i]);
+                });
 
-        OWLOntologyReader* importReader = new OWLOntologyReader();
-        OWLOntology::Ptr importedOntology = importReader->open(filename);
-        importedOntology->setIRI(iri);
+        for(size_t i = 0; i < pending.size(); ++i)
+        {
+            OWLOntology::Ptr importedOntology = importReaders[i]->createOntology();
+            importedOntology->setIRI(pending[i]);
 
-        // load the individual ontology to identity direct imports
-        importReader->loadImports(importedOntology, true /*directImport*/);
-        iri = importedOntology->getIRI();
+            // load the individual ontology to identity direct imports
+            importReaders[i]->loadImports(importedOntology, true /*directImport*/);
+            IRI iri = importedOntology->getIRI();
 
-        IRIList directImports = importedOntology->getDirectImportsDocuments();
-        dependencies[iri] = IRISet(directImports.begin(), directImports.end());
+            IRIList directImports = importedOntology->getDirectImportsDocuments();
+            dependencies[iri] = IRISet(directImports.begin(), directImports.end());
 
-        unprocessed.insert(unprocessed.begin(), directImports.begin(), directImports.end());
-        unprocessed.push_back(iri);
+            unprocessed.insert(unprocessed.end(), directImports.begin(), directImports.end());
 
-        readersMap[importedOntology] = importReader;
-        // register IRI and ontology
-        processed.push_back(iri);
+            readersMap[importedOntology] = importReaders[i].release();
+            // register IRI and ontology
+            processed.push_back(pending[i]);
+            if(iri != pending[i])
+            {
+                processed.push_back(iri);
+            }
+        }
     }
 
     // Process the imported ontologies in dependency order of import to
@@ -222,6 +323,10 @@ owlapi::model::OWLOntology::Ptr OWLOntologyIO::load(owlapi::model::OWLOntology::
         // Load the full ontology
         importReader->loadDeclarations(ontology, false);
         importReader->loadAxioms(ontology);
+        if(snapshot)
+        {
+            snapshot->addDocument(iri, importReader->getAbsolutePath(), importReader->getTripleStore());
+        }
         delete importReader;
 
         // Remove iri from list of dependencies
@@ -251,6 +356,10 @@ owlapi::model::OWLOntology::Ptr OWLOntologyIO::load(owlapi::model::OWLOntology::
         reader.loadAxioms(ontology);
     }
 
+    if(snapshot && !isEmptyTopOntology)
+    {
+        snapshot->addDocument(ontology->getIRI(), reader.getAbsolutePath(), reader.getTripleStore());
+    }
 
     LOG_INFO_S << "Processed all imports: " << loaded;
     return ontology;
@@ -258,14 +367,59 @@ owlapi::model::OWLOntology::Ptr OWLOntologyIO::load(owlapi::model::OWLOntology::
 
 owlapi::model::OWLOntology::Ptr OWLOntologyIO::fromFile(const std::string& filename)
 {
-    OWLOntologyReader reader;
-    owlapi::model::OWLOntology::Ptr ontology = reader.open(filename);
-    std::string absolutePath = boost::filesystem::canonical(filename).string();
-    ontology->setAbsolutePath(absolutePath);
+    // The document is parsed once by load
+    owlapi::model::OWLOntology::Ptr ontology = make_shared<owlapi::model::OWLOntology>();
+    ontology->setAbsolutePath(getDocumentPath(filename));
 
     return load(ontology,"",false);
 }
 
+owlapi::model::OWLOntology::Ptr OWLOntologyIO::fromFile(const std::string& filename,
+        const std::string& snapshotFilename)
+{
+    owlapi::model::OWLOntology::Ptr ontology = make_shared<owlapi::model::OWLOntology>();
+    ontology->setAbsolutePath(getDocumentPath(filename));
+
+    OWLOntologySnapshot snapshot;
+    load(ontology, "", false, &snapshot);
+    snapshot.write(snapshotFilename);
+    return ontology;
+}
+
+owlapi::model::OWLOntology::Ptr OWLOntologyIO::fromSnapshot(const std::string& snapshotFilename)
+{
+    OWLOntologySnapshot snapshot = OWLOntologySnapshot::read(snapshotFilename);
+    const OWLOntologySnapshot::DocumentList& documents = snapshot.getDocuments();
+    if(documents.empty())
+    {
+        throw std::runtime_error("owlapi::io::OWLOntologyIO::fromSnapshot: '"
+                + snapshotFilename + "' does not contain any document");
+    }
+
+    // The top-level document is stored last, preceded by the imports in
+    // dependency order
+    const OWLOntologySnapshot::Document& top = documents.back();
+    OWLOntologyReader reader;
+    reader.read(top.tripleStore, top.absolutePath);
+    owlapi::model::OWLOntology::Ptr ontology = reader.createOntology();
+    reader.loadImports(ontology, true /*directImport*/);
+
+    for(size_t i = 0; i + 1 < documents.size(); ++i)
+    {
+        OWLOntologyReader importReader;
+        importReader.read(documents[i].tripleStore, documents[i].absolutePath);
+
+        LOG_INFO_S << "Importing declarations from snapshot of '" << documents[i].iri
+            << "' into ontology " << ontology->getIRI();
+        importReader.loadDeclarations(ontology, false);
+        importReader.loadAxioms(ontology);
+    }
+
+    reader.loadDeclarations(ontology, true /*directImport*/);
+    reader.loadAxioms(ontology);
+    return ontology;
+}
+
 std::string OWLOntologyIO::getOntologiesDownloadDir()
 {
     if(msDownloadDir.empty())
@@ -8,6 +8,8 @@
 namespace owlapi {
 namespace io {
 
+class OWLOntologySnapshot;
+
 class OWLOntologyNotFound : public std::runtime_error
 {
 public:
@@ -69,6 +71,31 @@ public:
      */
     static owlapi::model::OWLOntology::Ptr fromFile(const std::string& filename);
 
+    /**
+     * Load an ontology from file and write a binary snapshot of the
+     * ontology document and all its imports
+     * \param filename File to load from
+     * \param snapshotFilename File to write the snapshot to
+     * \return OWLOntology::Ptr
+     * \see fromSnapshot
+     */
+    static owlapi::model::OWLOntology::Ptr fromFile(const std::string& filename,
+            const std::string& snapshotFilename);
+
+    /**
+     * Load an ontology from a binary snapshot, which requires neither RDF
+     * parsing nor retrieval of the imported documents
+     * \details The triple tables are restored from the snapshot, and the
+     * declarations and axioms are loaded from them just as for parsed
+     * documents. The reasoner's knowledge base cannot be serialized, so it has
+     * to be populated through the regular loading anyway
+     * \param snapshotFilename File the snapshot has been written to
+     * \return OWLOntology::Ptr
+     * \throw std::runtime_error if the snapshot cannot be read or has been
+     * written with an incompatible version
+     */
+    static owlapi::model::OWLOntology::Ptr fromSnapshot(const std::string& snapshotFilename);
+
     /**
      * Load an ontology by a given iri -- imported ontologies will be loaded as
      * well into the single ontology object
@@ -199,6 +226,16 @@ public:
     static owlapi::model::IRIList findCycle(const std::map<owlapi::model::IRI, owlapi::model::IRISet>& dependencies);
 
 private:
+    /**
+     * Load an ontology and optionally record all loaded documents
+     * \param snapshot Snapshot to add the documents to, or NULL
+     */
+    static owlapi::model::OWLOntology::Ptr load(owlapi::model::OWLOntology::Ptr&
+            ontology,
+            const owlapi::model::IRI& ontologyIRI,
+            bool isEmptyTopOntology,
+            OWLOntologySnapshot* snapshot);
+
     static std::string msDownloadDir;
 };
 
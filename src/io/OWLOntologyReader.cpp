@@ -8,7 +8,8 @@
 #include <iostream>
 
 #include "../model/OWLOntologyTell.hpp"
-#include "../db/rdf/Redland.hpp"
+#include "../db/rdf/TripleStore.hpp"
+#include "RedlandReader.hpp"
 #include "../db/rdf/Sparql.hpp"
 #include "../Vocabulary.hpp"
 #include "changes/AddEquivalentClasses.hpp"
@@ -46,7 +47,12 @@ OWLOntologyReader::OWLOntologyReader()
 
 OWLOntology::Ptr OWLOntologyReader::open(const std::string& filename)
 {
-    OWLOntology::Ptr ontology = make_shared<OWLOntology>();
+    read(filename);
+    return createOntology();
+}
+
+void OWLOntologyReader::read(const std::string& filename)
+{
     // check first if file is empty
     std::ifstream file(filename);
     if(file.peek() == std::ifstream::traits_type::eof())
@@ -56,9 +62,27 @@ OWLOntology::Ptr OWLOntologyReader::open(const std::string& filename)
                 " load and remove the current file.");
     }
 
-    mSparqlInterface = new db::Redland(filename);
+    // Stream the statements into a triple table, so that the loading
+    // queries do not require a SPARQL engine
+    db::TripleStore::Ptr tripleStore = make_shared<db::TripleStore>();
+    RedlandReader reader;
+    reader.read(filename, *tripleStore);
+    LOG_DEBUG_S << "Loaded " << tripleStore->size() << " triples with "
+        << tripleStore->getNumberOfTerms() << " distinct terms from '" << filename << "'";
+
+    read(tripleStore, boost::filesystem::absolute(filename).string());
+}
+
+void OWLOntologyReader::read(const shared_ptr<db::TripleStore>& tripleStore, const std::string& absolutePath)
+{
+    mTripleStore = tripleStore;
+    mSparqlInterface = mTripleStore.get();
+    mAbsolutePath = absolutePath;
+}
 
-    mAbsolutePath = boost::filesystem::absolute(filename).string();
+OWLOntology::Ptr OWLOntologyReader::createOntology() const
+{
+    OWLOntology::Ptr ontology = make_shared<OWLOntology>();
     ontology->setAbsolutePath(mAbsolutePath);
     return ontology;
 }
@@ -72,9 +96,7 @@ OWLOntology::Ptr OWLOntologyReader::fromFile(const std::string& filename)
 }
 
 OWLOntologyReader::~OWLOntologyReader()
-{
-    delete mSparqlInterface;
-}
+{}
 
 db::query::Results OWLOntologyReader::findAll(const db::query::Variable& subject, const db::query::Variable& predicate, const db::query::Variable& object) const
 {
@@ -668,7 +690,7 @@ void OWLOntologyReader::loadRestrictions(OWLOntology::Ptr& ontology)
            .endWhere();
 
     std::string queryTxt = customQuery.toString();
-    Results results = mSparqlInterface->query(customQuery.toString(),customQuery.getBindings());
+    Results results = mSparqlInterface->query(customQuery);
     ResultsIterator it(results);
 
     while(it.next())
@@ -778,7 +800,7 @@ void OWLOntologyReader::loadDataTypeRestrictions(OWLOntology::Ptr& ontology)
                .endWhere();
 
         //Results results = findAll(Subject(), vocabulary::OWL::withRestrictions(), Object());
-        Results results = mSparqlInterface->query(customQuery.toString(),customQuery.getBindings());
+        Results results = mSparqlInterface->query(customQuery);
         ResultsIterator it(results);
         while(it.next())
         {
@@ -844,7 +866,7 @@ void OWLOntologyReader::loadDataTypeRestrictions(OWLOntology::Ptr& ontology)
                    .triple(db::query::Subject(), predicate, db::query::Object())
                    .endWhere();
 
-            Results results = mSparqlInterface->query(customQuery.toString(),customQuery.getBindings());
+            Results results = mSparqlInterface->query(customQuery);
             ResultsIterator it(results);
             while(it.next())
             {
@@ -874,7 +896,7 @@ void OWLOntologyReader::loadDataTypeRestrictions(OWLOntology::Ptr& ontology)
                .endWhere();
 
         //Results results = findAll(Subject(), vocabulary::OWL::withRestrictions(), Object());
-        Results results = mSparqlInterface->query(customQuery.toString(),customQuery.getBindings());
+        Results results = mSparqlInterface->query(customQuery);
         //Results results = findAll(Subject(), vocabulary::OWL::onProperty(), Object());
         ResultsIterator it(results);
         while(it.next())
@@ -993,7 +1015,7 @@ void OWLOntologyReader::loadDataTypeRestrictions(OWLOntology::Ptr& ontology)
             }
             whereClause.endWhere();
 
-            Results results = mSparqlInterface->query(customQuery.toString(),customQuery.getBindings());
+            Results results = mSparqlInterface->query(customQuery);
             ResultsIterator it(results);
             while(it.next())
             {
@@ -1139,7 +1161,7 @@ void OWLOntologyReader::loadObjectRestrictions(OWLOntology::Ptr& ontology)
             }
             whereClause.endWhere();
 
-            Results results = mSparqlInterface->query(customQuery.toString(),customQuery.getBindings());
+            Results results = mSparqlInterface->query(customQuery);
             ResultsIterator it(results);
             while(it.next())
             {
@@ -1246,7 +1268,7 @@ void OWLOntologyReader::loadObjectRestrictions(OWLOntology::Ptr& ontology)
                    .triple(db::query::Subject(), predicate, db::query::Object())
                    .endWhere();
 
-            Results results = mSparqlInterface->query(customQuery.toString(),customQuery.getBindings());
+            Results results = mSparqlInterface->query(customQuery);
             ResultsIterator it(results);
             while(it.next())
             {
@@ -1321,7 +1343,7 @@ void OWLOntologyReader::loadObjectRestrictions(OWLOntology::Ptr& ontology)
             std::string queryTxt = customQuery.toString();
             LOG_DEBUG_S << queryTxt;
 
-            Results results = mSparqlInterface->query(customQuery.toString(),customQuery.getBindings());
+            Results results = mSparqlInterface->query(customQuery);
             //Results results = findAll(Subject(), vocabulary::OWL::onProperty(), Object());
             ResultsIterator it(results);
             while(it.next())
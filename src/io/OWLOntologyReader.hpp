@@ -5,6 +5,11 @@
 #include "../db/rdf/SparqlInterface.hpp"
 
 namespace owlapi {
+namespace db {
+
+class TripleStore;
+
+}
 namespace io {
 
 class OntologyChange;
@@ -27,6 +32,8 @@ namespace io {
  */
 class OWLOntologyReader
 {
+    /// Triple table of the parsed document
+    shared_ptr<db::TripleStore> mTripleStore;
     /// Pointer to the underlying query interfaces for SPARQL
     db::query::SparqlInterface* mSparqlInterface;
 
@@ -69,6 +76,32 @@ public:
      */
     owlapi::model::OWLOntology::Ptr open(const std::string& filename);
 
+    /**
+     * Parse a file without creating an ontology
+     * \details Parsing only affects this reader, so that different readers
+     * can parse concurrently
+     * \throw OWLOntologyNotFound if the file is empty
+     */
+    void read(const std::string& filename);
+
+    /**
+     * Use an already populated triple table, e.g. from a snapshot, instead
+     * of parsing a file
+     * \param tripleStore Triple table of the document
+     * \param absolutePath Path of the document the triples originate from
+     */
+    void read(const shared_ptr<db::TripleStore>& tripleStore, const std::string& absolutePath);
+
+    /**
+     * Get the triple table of the document that has been read
+     */
+    const shared_ptr<db::TripleStore>& getTripleStore() const { return mTripleStore; }
+
+    /**
+     * Create an ontology for the file that has been read
+     */
+    owlapi::model::OWLOntology::Ptr createOntology() const;
+
     /**
      * Only identify the imports
      */
@@ -0,0 +1,115 @@
+#include "OWLOntologySnapshot.hpp"
+#include "BinaryIO.hpp"
+#include <fstream>
+#include <stdexcept>
+#include <base-logging/Logging.hpp>
+
+namespace owlapi {
+namespace io {
+
+namespace {
+
+const char MAGIC[8] = { 'O', 'W', 'L', 'S', 'N', 'A', 'P', '\0' };
+const char* CONTEXT_READ = "owlapi::io::OWLOntologySnapshot::read";
+
+} // end anonymous namespace
+
+const uint32_t OWLOntologySnapshot::VERSION = 1;
+
+void OWLOntologySnapshot::addDocument(const model::IRI& iri, const std::string& absolutePath,
+        const db::TripleStore::Ptr& tripleStore)
+{
+    if(!tripleStore)
+    {
+        throw std::invalid_argument("owlapi::io::OWLOntologySnapshot::addDocument: no triples"
+                " given for '" + iri.toString() + "'");
+    }
+
+    Document document;
+    document.iri = iri;
+    document.absolutePath = absolutePath;
+    document.tripleStore = tripleStore;
+    mDocuments.push_back(document);
+}
+
+void OWLOntologySnapshot::write(const std::string& filename) const
+{
+    std::ofstream out(filename.c_str(), std::ios::binary | std::ios::trunc);
+    if(!out)
+    {
+        throw std::runtime_error("owlapi::io::OWLOntologySnapshot::write: failed to open '"
+                + filename + "'");
+    }
+
+    writeHeader(out, MAGIC, VERSION);
+    writeValue<uint32_t>(out, mDocuments.size());
+    for(const Document& document : mDocuments)
+    {
+        const db::TripleStore& store = *document.tripleStore;
+        writeString(out, document.iri.toString());
+        writeString(out, document.absolutePath);
+
+        writeValue<uint32_t>(out, store.getNumberOfTerms());
+        for(size_t i = 0; i < store.getNumberOfTerms(); ++i)
+        {
+            writeString(out, store.getTerm(i).toString());
+        }
+
+        writeValue<uint32_t>(out, store.size());
+        for(const db::TripleStore::Triple& triple : store.getTriples())
+        {
+            writeValue(out, triple.subject);
+            writeValue(out, triple.predicate);
+            writeValue(out, triple.object);
+        }
+    }
+
+    if(!out)
+    {
+        throw std::runtime_error("owlapi::io::OWLOntologySnapshot::write: failed to write '"
+                + filename + "'");
+    }
+}
+
+OWLOntologySnapshot OWLOntologySnapshot::read(const std::string& filename)
+{
+    MappedFile file(filename, CONTEXT_READ);
+    BufferReader reader(file.data(), file.size(), filename, CONTEXT_READ);
+    reader.readHeader(MAGIC, VERSION, "snapshot");
+
+    OWLOntologySnapshot snapshot;
+    // a document consists of at least two strings and two counts
+    uint32_t numberOfDocuments = reader.readCount(4*sizeof(uint32_t));
+    for(uint32_t d = 0; d < numberOfDocuments; ++d)
+    {
+        model::IRI iri(reader.readString());
+        std::string absolutePath = reader.readString();
+
+        db::TripleStore::Ptr store = make_shared<db::TripleStore>();
+        uint32_t numberOfTerms = reader.readCount(sizeof(uint32_t));
+        store->reserve(numberOfTerms, 0);
+        for(uint32_t i = 0; i < numberOfTerms; ++i)
+        {
+            store->addTerm(reader.readString());
+        }
+
+        uint32_t numberOfTriples = reader.readCount(3*sizeof(uint32_t));
+        store->reserve(numberOfTerms, numberOfTriples);
+        for(uint32_t i = 0; i < numberOfTriples; ++i)
+        {
+            db::TripleStore::Triple triple;
+            triple.subject = reader.read<uint32_t>();
+            triple.predicate = reader.read<uint32_t>();
+            triple.object = reader.read<uint32_t>();
+            store->add(triple);
+        }
+
+        LOG_DEBUG_S << "Restored " << store->size() << " triples of '" << iri
+            << "' from snapshot '" << filename << "'";
+        snapshot.addDocument(iri, absolutePath, store);
+    }
+    return snapshot;
+}
+
+} // end namespace io
+} // end namespace owlapi
@@ -0,0 +1,73 @@
+#ifndef OWLAPI_IO_OWL_ONTOLOGY_SNAPSHOT_HPP
+#define OWLAPI_IO_OWL_ONTOLOGY_SNAPSHOT_HPP
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "../model/IRI.hpp"
+#include "../db/rdf/TripleStore.hpp"
+
+namespace owlapi {
+namespace io {
+
+/**
+ * \class OWLOntologySnapshot
+ * \brief Versioned binary snapshot of the documents an ontology has been
+ * loaded from
+ * \details A snapshot stores the triple tables of all imported documents in
+ * dependency order, followed by the top-level document. Reading a snapshot
+ * maps the file into memory and restores the triple tables without RDF
+ * parsing, import resolution or download.
+ * The format uses native byte order; files written with a different version
+ * or byte order are rejected.
+ * \see OWLOntologyIO::fromSnapshot
+ */
+class OWLOntologySnapshot
+{
+public:
+    /// Version of the binary format, to be increased with any format change
+    static const uint32_t VERSION;
+
+    struct Document
+    {
+        /// IRI of the ontology
+        model::IRI iri;
+        /// Path the document has been loaded from
+        std::string absolutePath;
+        /// Triples of the document
+        db::TripleStore::Ptr tripleStore;
+    };
+
+    typedef std::vector<Document> DocumentList;
+
+    /**
+     * Append a document
+     */
+    void addDocument(const model::IRI& iri, const std::string& absolutePath,
+            const db::TripleStore::Ptr& tripleStore);
+
+    /**
+     * Get the documents in the order they have to be loaded
+     */
+    const DocumentList& getDocuments() const { return mDocuments; }
+
+    /**
+     * Write the snapshot to a file
+     * \throw std::runtime_error if the file cannot be written
+     */
+    void write(const std::string& filename) const;
+
+    /**
+     * Read a snapshot from a file
+     * \throw std::runtime_error if the file cannot be read or has an
+     * incompatible format
+     */
+    static OWLOntologySnapshot read(const std::string& filename);
+
+private:
+    DocumentList mDocuments;
+};
+
+} // end namespace io
+} // end namespace owlapi
+#endif // OWLAPI_IO_OWL_ONTOLOGY_SNAPSHOT_HPP
@@ -1,5 +1,6 @@
 #include "RedlandReader.hpp"
 #include "OWLOntologyIO.hpp"
+#include "../db/rdf/TripleStore.hpp"
 #include <raptor2.h>
 #include <cstdlib>
 
@@ -60,7 +61,46 @@ unsigned char* blankNodeHandler(void *user_data, unsigned char* user_bnodeid)
   return buffer;
 }
 
-int RedlandReader::msBlankNodeId = 0;
+/**
+ * Convert a raptor term following the conversion in db::Redland::query
+ */
+std::string termToString(const raptor_term* term)
+{
+    switch(term->type)
+    {
+        case RAPTOR_TERM_TYPE_URI:
+            return std::string((const char*) raptor_uri_as_string(term->value.uri));
+        case RAPTOR_TERM_TYPE_LITERAL:
+        {
+            const raptor_term_literal_value& literal = term->value.literal;
+            if(literal.string == NULL || literal.string_len == 0)
+            {
+                return std::string();
+            }
+            std::string literalValue((const char*) literal.string, literal.string_len);
+            if(literal.datatype)
+            {
+                literalValue.append("^^");
+                literalValue.append((const char*) raptor_uri_as_string(literal.datatype));
+            }
+            return literalValue;
+        }
+        case RAPTOR_TERM_TYPE_BLANK:
+            return std::string((const char*) term->value.blank.string, term->value.blank.string_len);
+        default:
+            return std::string();
+    }
+}
+
+void statementHandler(void* user_data, raptor_statement* statement)
+{
+    db::TripleStore* store = static_cast<db::TripleStore*>(user_data);
+    store->add(termToString(statement->subject),
+            termToString(statement->predicate),
+            termToString(statement->object));
+}
+
+std::atomic<int> RedlandReader::msBlankNodeId(0);
 
 ParsingFailed::ParsingFailed(const std::string& message)
     : std::runtime_error(message)
@@ -103,10 +143,27 @@ std::vector<std::string> RedlandReader::getSupportedFormats() const
 }
 
 void RedlandReader::read(const std::string& filename) const
+{
+    readAnyFormat(filename, [this, &filename](const std::string& format)
+            {
+                read(filename, format);
+            });
+}
+
+void RedlandReader::read(const std::string& filename, db::TripleStore& store) const
+{
+    readAnyFormat(filename, [this, &filename, &store](const std::string& format)
+            {
+                read(filename, format, store);
+            });
+}
+
+void RedlandReader::readAnyFormat(const std::string& filename,
+        const std::function<void (const std::string&)>& readFormat) const
 {
     Format guessedFormat = OWLOntologyIO::guessFormat(filename);
     try {
-        read(filename, FormatTxt[ guessedFormat ]);
+        readFormat(FormatTxt[ guessedFormat ]);
         return;
     } catch(const io::ParsingFailed& pf)
     {
@@ -120,7 +177,7 @@ void RedlandReader::read(const std::string& filename) const
         try {
             if(format == "ntriples")
                 continue;
-            read(filename, format);
+            readFormat(format);
             return;
         } catch(const io::ParsingFailed& pf)
         {
@@ -133,6 +190,23 @@ void RedlandReader::read(const std::string& filename) const
             + filename + "' tried all formats");
 }
 
+std::string RedlandReader::getParserName(const std::string& filename, const std::string& format) const
+{
+    if(!format.empty())
+    {
+        LOG_DEBUG_S << "Using format: " << format;
+        return format;
+    }
+
+    unsigned char* uri_string = raptor_uri_filename_to_uri_string(filename.c_str());
+    raptor_world* raptorWorld = librdf_world_get_raptor(mpWorld);
+    std::string parserName = raptor_world_guess_parser_name(raptorWorld, NULL, NULL, NULL, 0,
+            uri_string);
+    raptor_free_memory(uri_string);
+    LOG_INFO_S << "Guessed parser name: " << parserName;
+    return parserName;
+}
+
 void RedlandReader::read(const std::string& filename, const std::string& format) const
 {
     unsigned char* uri_string = raptor_uri_filename_to_uri_string(filename.c_str());
@@ -153,15 +227,7 @@ void RedlandReader::read(const std::string& filename, const std::string& format)
 
 
 
-    std::string parserName = format;
-    if(format.empty())
-    {
-        parserName = raptor_world_guess_parser_name(raptorWorld, NULL, NULL, NULL, 0,
-                uri_string);
-        LOG_INFO_S << "Guessed parser name: " << parserName;
-    } else {
-        LOG_DEBUG_S << "Using format: " << format;
-    }
+    std::string parserName = getParserName(filename, format);
 
     librdf_parser* p = librdf_new_parser(mpWorld, parserName.c_str(), NULL, NULL);
     if(!p)
@@ -185,6 +251,42 @@ void RedlandReader::read(const std::string& filename, const std::string& format)
     librdf_free_uri(base_uri);
 }
 
+void RedlandReader::read(const std::string& filename, const std::string& format, db::TripleStore& store) const
+{
+    raptor_world* raptorWorld = librdf_world_get_raptor(mpWorld);
+    raptor_world_set_generate_bnodeid_handler(raptorWorld, NULL, blankNodeHandler);
+    // librdf forwards the raptor log messages to this logger
+    librdf_world_set_logger(mpWorld,
+            NULL,
+            &rdfLogFunction);
+
+    std::string parserName = getParserName(filename, format);
+    raptor_parser* parser = raptor_new_parser(raptorWorld, parserName.c_str());
+    if(!parser)
+    {
+        throw ParsingFailed("owlapi::io::RedlandReader::read: reading '"
+                + filename + "' failed. Parser for format '" + parserName + "'"
+                " could not be created");
+    }
+    raptor_parser_set_statement_handler(parser, &store, statementHandler);
+
+    unsigned char* uri_string = raptor_uri_filename_to_uri_string(filename.c_str());
+    raptor_uri* uri = raptor_new_uri(raptorWorld, uri_string);
+    int status = raptor_parser_parse_file(parser, uri, uri);
+
+    raptor_free_uri(uri);
+    raptor_free_memory(uri_string);
+    raptor_free_parser(parser);
+
+    if(status != 0)
+    {
+        // Discard the statements of the partial parse
+        store.clear();
+        throw ParsingFailed("owlapi::io::RedlandReader::read: reading '"
+                + filename + "' failed for format: " + parserName);
+    }
+}
+
 
 } // end namespace io
 } // end namespace owlapi
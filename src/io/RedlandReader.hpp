@@ -2,10 +2,16 @@
 #define OWLAPI_IO_REDLAND_READER_HPP
 
 #include <stdexcept>
+#include <functional>
+#include <atomic>
 #include "OWLReader.hpp"
 #include <redland.h>
 
 namespace owlapi {
+namespace db {
+class TripleStore;
+}
+
 namespace io {
 
 class ParsingFailed : std::runtime_error
@@ -31,17 +37,35 @@ public:
     void read(const std::string& filename) const;
     void read(const std::string& filename, const std::string& format) const;
 
+    /**
+     * Stream all statements of a file into a triple store, bypassing the
+     * librdf model
+     * \throw ParsingFailed when filename cannot be parsed, the store will be
+     * cleared in this case
+     */
+    void read(const std::string& filename, db::TripleStore& store) const;
+    void read(const std::string& filename, const std::string& format, db::TripleStore& store) const;
+
     librdf_world* getWorld() { return mpWorld; }
     librdf_model* getModel() { return mpModel; }
 
     static int consumeBlankNodeId() { return ++msBlankNodeId; }
 
 private:
+    /**
+     * Try parsing with the guessed format first, then fall back to all
+     * supported formats
+     */
+    void readAnyFormat(const std::string& filename,
+            const std::function<void (const std::string&)>& readFormat) const;
+
+    std::string getParserName(const std::string& filename, const std::string& format) const;
+
     librdf_world* mpWorld;
     librdf_storage *mpStorage;
     librdf_model* mpModel;
 
-    static int msBlankNodeId;
+    static std::atomic<int> msBlankNodeId;
 };
 
 } // end namespace io
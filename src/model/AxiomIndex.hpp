@@ -0,0 +1,171 @@
+#ifndef OWLAPI_MODEL_AXIOM_INDEX_HPP
+#define OWLAPI_MODEL_AXIOM_INDEX_HPP
+
+#include <list>
+#include <string>
+#include <unordered_map>
+#include "OWLAxiom.hpp"
+
+namespace owlapi {
+namespace model {
+
+/**
+ * \class AxiomIndex
+ * \brief Set of axioms which keeps the insertion order
+ * \details Axioms are indexed by their structural hash, so that insertion,
+ * lookup and removal take constant time. Structurally equal axioms are
+ * stored only once, i.e. inserting a duplicate of a contained axiom has no
+ * effect.
+ * \see OWLAxiom::isStructurallyEqual
+ */
+template<typename AxiomT = OWLAxiom>
+class AxiomIndex
+{
+public:
+    typedef shared_ptr<AxiomT> AxiomPtr;
+    typedef std::list<AxiomPtr> List;
+    typedef typename List::const_iterator const_iterator;
+    typedef AxiomPtr value_type;
+
+    AxiomIndex() = default;
+
+    AxiomIndex(const AxiomIndex& other)
+    {
+        *this = other;
+    }
+
+    AxiomIndex& operator=(const AxiomIndex& other)
+    {
+        if(this != &other)
+        {
+            clear();
+            for(const AxiomPtr& axiom : other.mAxioms)
+            {
+                insert(axiom);
+            }
+        }
+        return *this;
+    }
+
+    /**
+     * Insert an axiom unless a structurally equal axiom is already contained
+     * \return the contained axiom, i.e. the given axiom if it has been
+     * inserted, otherwise the previously inserted duplicate
+     */
+    AxiomPtr insert(const AxiomPtr& axiom)
+    {
+        return insert(axiom, axiom->getStructuralHash());
+    }
+
+    /**
+     * Insert an axiom whose structural hash is already known, e.g. when the
+     * same axiom is inserted into several indexes
+     * \param structuralHash the result of axiom->getStructuralHash()
+     * \return the contained axiom
+     */
+    AxiomPtr insert(const AxiomPtr& axiom, size_t structuralHash)
+    {
+        typename Index::const_iterator it = lookup(*axiom, structuralHash);
+        if(it != mIndex.end())
+        {
+            return *it->second;
+        }
+        mAxioms.push_back(axiom);
+        mIndex.insert(std::make_pair(structuralHash, --mAxioms.end()));
+        return axiom;
+    }
+
+    /**
+     * Find the contained axiom which is structurally equal to the given one
+     * \return the contained axiom, or an empty pointer if there is none
+     */
+    AxiomPtr find(const OWLAxiom& axiom) const
+    {
+        typename Index::const_iterator it = lookup(axiom, axiom.getStructuralHash());
+        if(it == mIndex.end())
+        {
+            return AxiomPtr();
+        }
+        return *it->second;
+    }
+
+    /**
+     * Check whether a structurally equal axiom is contained
+     */
+    bool contains(const OWLAxiom& axiom) const { return static_cast<bool>(find(axiom)); }
+
+    /**
+     * Remove the axiom which is structurally equal to the given one
+     * \return true if an axiom has been removed, false if there was none
+     */
+    bool erase(const OWLAxiom& axiom)
+    {
+        return erase(axiom, axiom.getStructuralHash());
+    }
+
+    /**
+     * Remove the axiom which is structurally equal to the given one
+     * \param structuralHash the result of axiom.getStructuralHash()
+     * \return true if an axiom has been removed, false if there was none
+     */
+    bool erase(const OWLAxiom& axiom, size_t structuralHash)
+    {
+        typename Index::const_iterator it = lookup(axiom, structuralHash);
+        if(it == mIndex.end())
+        {
+            return false;
+        }
+        mAxioms.erase(it->second);
+        mIndex.erase(it);
+        return true;
+    }
+
+    const_iterator begin() const { return mAxioms.begin(); }
+    const_iterator end() const { return mAxioms.end(); }
+
+    size_t size() const { return mAxioms.size(); }
+    bool empty() const { return mAxioms.empty(); }
+
+    void clear()
+    {
+        mIndex.clear();
+        mAxioms.clear();
+    }
+
+private:
+    typedef std::unordered_multimap<size_t, typename List::iterator> Index;
+
+    typename Index::const_iterator lookup(const OWLAxiom& axiom, size_t hash) const
+    {
+        std::pair<typename Index::const_iterator, typename Index::const_iterator> range = mIndex.equal_range(hash);
+        // The structural key is only computed if another instance has the
+        // same hash
+        std::string key;
+        for(typename Index::const_iterator it = range.first; it != range.second; ++it)
+        {
+            const OWLAxiom* other = it->second->get();
+            if(other == &axiom)
+            {
+                return it;
+            }
+            if(key.empty())
+            {
+                key = axiom.getStructuralKey();
+            }
+            if(other->getStructuralKey() == key)
+            {
+                return it;
+            }
+        }
+        return mIndex.end();
+    }
+
+    /// Axioms in the order of insertion
+    List mAxioms;
+    /// Positions of the axioms by structural hash
+    Index mIndex;
+};
+
+} // end namespace model
+} // end namespace owlapi
+#endif // OWLAPI_MODEL_AXIOM_INDEX_HPP
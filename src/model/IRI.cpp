@@ -26,16 +26,19 @@ void IRI::setFromString(const std::string& s)
         mPrefix = s.substr(0,splitPos+1);
         mRemainder = s.substr(splitPos+1);
     }
+    mId = IRIRegistry::intern(s);
 }
 
 IRI::IRI()
     : mPrefix("")
     , mRemainder("")
+    , mId(IRIRegistry::EMPTY_ID)
 {}
 
 IRI::IRI(const char* s)
     : mPrefix("")
     , mRemainder("")
+    , mId(IRIRegistry::EMPTY_ID)
 {
     setFromString( std::string(s) );
 }
@@ -43,6 +46,7 @@ IRI::IRI(const char* s)
 IRI::IRI(const std::string& s)
     : mPrefix("")
     , mRemainder("")
+    , mId(IRIRegistry::EMPTY_ID)
 {
     setFromString(s);
 }
@@ -50,6 +54,7 @@ IRI::IRI(const std::string& s)
 IRI::IRI(const std::string& prefix, const std::string& remainder)
     : mPrefix(prefix)
     , mRemainder(remainder)
+    , mId(IRIRegistry::intern(prefix + remainder))
 {}
 
 bool IRI::isValid(const std::string& s)
@@ -196,6 +201,28 @@ std::string IRI::toEscapedString() const
     return iri;
 }
 
+bool IRI::operator<(const IRI& other) const
+{
+    if(mId == other.mId)
+    {
+        return false;
+    }
+
+    // compare prefix + remainder without constructing the full strings
+    size_t size = mPrefix.size() + mRemainder.size();
+    size_t otherSize = other.mPrefix.size() + other.mRemainder.size();
+    for(size_t i = 0; i < size && i < otherSize; ++i)
+    {
+        char c = i < mPrefix.size() ? mPrefix[i] : mRemainder[i - mPrefix.size()];
+        char otherC = i < other.mPrefix.size() ? other.mPrefix[i] : other.mRemainder[i - other.mPrefix.size()];
+        if(c != otherC)
+        {
+            return static_cast<unsigned char>(c) < static_cast<unsigned char>(otherC);
+        }
+    }
+    return size < otherSize;
+}
+
 std::string IRI::toString(const IRIList& iris, bool fragmentsOnly)
 {
     std::stringstream os;
@@ -225,11 +252,6 @@ std::string IRI::toString(const IRIList& iris, bool fragmentsOnly)
 }
 
 
-bool IRI::operator==(const IRI& other) const
-{
-    return mPrefix == other.mPrefix && mRemainder == other.mRemainder;
-}
-
 std::ostream& operator<<(std::ostream& os, const owlapi::model::IRI& iri)
 {
     os << iri.toString();
@@ -8,6 +8,7 @@
 #include <boost/serialization/string.hpp>
 #include <boost/functional/hash.hpp>
 #include "URI.hpp"
+#include "IRIRegistry.hpp"
 #include "OWLAnnotationValue.hpp"
 #include "OWLAnnotationSubject.hpp"
 #include <regex>
@@ -32,6 +33,8 @@ protected:
 
     std::string mPrefix;
     std::string mRemainder;
+    /// Interned id of the full IRI string, see IRIRegistry
+    IRIRegistry::Id mId;
 
     void setFromString(const std::string& s);
 
@@ -132,22 +135,38 @@ public:
 
     static IRIList getIntersection(const IRISet& a, const IRISet& b);
 
-    bool empty() const { return toString().empty(); }
+    /**
+     * Get the interned id of this IRI
+     * \see IRIRegistry
+     */
+    IRIRegistry::Id getId() const { return mId; }
+
+    bool empty() const { return mId == IRIRegistry::EMPTY_ID; }
 
     /**
      * Equals operator
      */
-    bool operator==(const IRI& other) const;
+    bool operator==(const IRI& other) const { return mId == other.mId; }
 
-    bool operator!=(const IRI& other) const { return !(*this == other); }
+    bool operator!=(const IRI& other) const { return mId != other.mId; }
 
-    bool operator<(const IRI& other) const { return toString() < other.toString(); }
+    /**
+     * Less than operator
+     * \details Lexical ordering of the string representation, so that the
+     * ordering does not depend on the order of interning; only the check for
+     * equality relies on the interned id
+     */
+    bool operator<(const IRI& other) const;
 
     template<class Archive>
     void serialize(Archive& ar, const unsigned int version)
     {
         ar & mPrefix;
         ar & mRemainder;
+        if(Archive::is_loading::value)
+        {
+            mId = IRIRegistry::intern(mPrefix + mRemainder);
+        }
     }
 
     OWLObject::Type getObjectType() const { return OWLObject::IRIType; }
@@ -185,7 +204,7 @@ struct hash<owlapi::model::IRI>
 {
     size_t operator()(const owlapi::model::IRI& iri) const
     {
-        return std::hash<std::string>()(iri.toString());
+        return std::hash<owlapi::model::IRIRegistry::Id>()(iri.getId());
     }
 };
 
@@ -195,8 +214,8 @@ struct hash< pair<owlapi::model::IRI, owlapi::model::IRI> >
     size_t operator()(const pair<owlapi::model::IRI, owlapi::model::IRI>& p) const
     {
         size_t seed = 0;
-        boost::hash_combine(seed, p.first.toString());
-        boost::hash_combine(seed, p.second.toString());
+        boost::hash_combine(seed, p.first.getId());
+        boost::hash_combine(seed, p.second.getId());
         return seed;
     }
 };
@@ -0,0 +1,67 @@
+#include "IRIRegistry.hpp"
+#include <limits>
+#include <stdexcept>
+
+namespace owlapi {
+namespace model {
+
+IRIRegistry::IRIRegistry()
+{
+    mStrings.push_back(std::string());
+    mIds[mStrings.back()] = EMPTY_ID;
+}
+
+IRIRegistry& IRIRegistry::getInstance()
+{
+    // function local static to allow usage during static initialization,
+    // e.g. for vocabulary IRIs
+    static IRIRegistry registry;
+    return registry;
+}
+
+IRIRegistry::Id IRIRegistry::intern(const std::string& iri)
+{
+    if(iri.empty())
+    {
+        return EMPTY_ID;
+    }
+
+    IRIRegistry& registry = getInstance();
+    std::lock_guard<std::mutex> lock(registry.mMutex);
+    std::unordered_map<std::string, Id>::const_iterator cit = registry.mIds.find(iri);
+    if(cit != registry.mIds.end())
+    {
+        return cit->second;
+    }
+
+    if(registry.mStrings.size() >= std::numeric_limits<Id>::max())
+    {
+        throw std::runtime_error("owlapi::model::IRIRegistry::intern: maximum number of IRIs exceeded");
+    }
+
+    Id id = static_cast<Id>(registry.mStrings.size());
+    registry.mStrings.push_back(iri);
+    registry.mIds[iri] = id;
+    return id;
+}
+
+const std::string& IRIRegistry::toString(Id id)
+{
+    IRIRegistry& registry = getInstance();
+    std::lock_guard<std::mutex> lock(registry.mMutex);
+    if(id >= registry.mStrings.size())
+    {
+        throw std::invalid_argument("owlapi::model::IRIRegistry::toString: unknown id '" + std::to_string(id) + "'");
+    }
+    return registry.mStrings[id];
+}
+
+size_t IRIRegistry::size()
+{
+    IRIRegistry& registry = getInstance();
+    std::lock_guard<std::mutex> lock(registry.mMutex);
+    return registry.mStrings.size();
+}
+
+} // end namespace model
+} // end namespace owlapi
@@ -0,0 +1,64 @@
+#ifndef OWLAPI_MODEL_IRI_REGISTRY_HPP
+#define OWLAPI_MODEL_IRI_REGISTRY_HPP
+
+#include <stdint.h>
+#include <string>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace owlapi {
+namespace model {
+
+/**
+ * \brief Global interning table for IRIs
+ * \details Each distinct IRI string is assigned a stable 32-bit id, so that
+ * IRIs can be compared, ordered and hashed as integers. Ids are never
+ * released during the lifetime of the process.
+ * The empty string is always mapped to id 0.
+ * All functions are thread-safe.
+ */
+class IRIRegistry
+{
+public:
+    typedef uint32_t Id;
+
+    /**
+     * Id of the empty IRI
+     */
+    static const Id EMPTY_ID = 0;
+
+    /**
+     * Get the id of a given IRI string, registering the string if it is not
+     * known yet
+     * \return id of the string
+     */
+    static Id intern(const std::string& iri);
+
+    /**
+     * Get the IRI string for a given id
+     * \return reference to the registered string, which remains valid for the
+     * lifetime of the process
+     * \throw std::invalid_argument if the id has not been assigned
+     */
+    static const std::string& toString(Id id);
+
+    /**
+     * Get the number of registered strings (including the empty string)
+     */
+    static size_t size();
+
+private:
+    IRIRegistry();
+
+    static IRIRegistry& getInstance();
+
+    std::mutex mMutex;
+    /// Storage of the interned strings, references remain valid on push_back
+    std::deque<std::string> mStrings;
+    std::unordered_map<std::string, Id> mIds;
+};
+
+} // end namespace model
+} // end namespace owlapi
+#endif // OWLAPI_MODEL_IRI_REGISTRY_HPP
@@ -1,5 +1,21 @@
 #include "OWLAxiom.hpp"
+#include <algorithm>
+#include <functional>
+#include <typeinfo>
 #include "../OWLApi.hpp"
+#include "OWLAnnotation.hpp"
+#include "OWLDisjointObjectPropertiesAxiom.hpp"
+#include "OWLDisjointDataPropertiesAxiom.hpp"
+#include "OWLEquivalentDataPropertiesAxiom.hpp"
+#include "OWLNaryBooleanExpression.hpp"
+#include "OWLObjectComplementOf.hpp"
+#include "OWLObjectOneOf.hpp"
+#include "OWLObjectHasValue.hpp"
+#include "OWLDataHasValue.hpp"
+#include "OWLQuantifiedObjectRestriction.hpp"
+#include "OWLQuantifiedDataRestriction.hpp"
+#include "OWLDataOneOf.hpp"
+#include "OWLDataTypeRestriction.hpp"
 
 #define VISIT_CASE_STATEMENT(X,Y) \
         case X: \
@@ -16,6 +32,367 @@
 namespace owlapi {
 namespace model {
 
+namespace {
+
+/**
+ * Writes the structural key of an axiom
+ * \details Strings are written with a length prefix, so that the key is
+ * unambiguous for arbitrary IRIs and literal values. Optionally, the entities
+ * which are encountered are collected.
+ * \see OWLAxiom::getStructuralKey, OWLAxiom::getSignature,
+ * OWLClassExpression::getStructuralKey
+ */
+class StructuralKeyWriter
+{
+public:
+    StructuralKeyWriter(OWLEntity::PtrList* signature = NULL)
+        : mpSignature(signature)
+    {}
+
+    const std::string& getKey() const { return mKey; }
+
+    void writeAxiom(const OWLAxiom& axiom)
+    {
+        writeToken(OWLAxiom::AxiomTypeTxt[axiom.getAxiomType()]);
+
+        if(const OWLDeclarationAxiom* declaration = dynamic_cast<const OWLDeclarationAxiom*>(&axiom))
+        {
+            OWLEntity::Ptr entity = declaration->getEntity();
+            if(entity)
+            {
+                addToSignature(entity);
+                writeToken(std::to_string(entity->getEntityType()));
+                writeIRI(entity->getIRI());
+            } else {
+                writeNull();
+            }
+        } else if(const OWLSubClassOfAxiom* subClassOf = dynamic_cast<const OWLSubClassOfAxiom*>(&axiom))
+        {
+            writeClass(subClassOf->getSubClass());
+            writeClass(subClassOf->getSuperClass());
+        } else if(const OWLEquivalentClassesAxiom* equivalentClasses = dynamic_cast<const OWLEquivalentClassesAxiom*>(&axiom))
+        {
+            writeSorted(equivalentClasses->getEquivalentClasses(), &StructuralKeyWriter::writeClass);
+        } else if(const OWLSubPropertyAxiom* subProperty = dynamic_cast<const OWLSubPropertyAxiom*>(&axiom))
+        {
+            writeProperty(subProperty->getSubProperty());
+            writeProperty(subProperty->getSuperProperty());
+        } else if(const OWLInverseObjectPropertiesAxiom* inverse = dynamic_cast<const OWLInverseObjectPropertiesAxiom*>(&axiom))
+        {
+            std::vector<OWLPropertyExpression::Ptr> properties = { inverse->getFirstProperty(), inverse->getSecondProperty() };
+            writeSorted(properties, &StructuralKeyWriter::writeProperty);
+        } else if(const OWLEquivalentObjectPropertiesAxiom* equivalent = dynamic_cast<const OWLEquivalentObjectPropertiesAxiom*>(&axiom))
+        {
+            writeSorted(equivalent->getProperties(), &StructuralKeyWriter::writeProperty);
+        } else if(const OWLDisjointObjectPropertiesAxiom* disjoint = dynamic_cast<const OWLDisjointObjectPropertiesAxiom*>(&axiom))
+        {
+            writeSorted(disjoint->getProperties(), &StructuralKeyWriter::writeProperty);
+        } else if(const OWLEquivalentDataPropertiesAxiom* equivalent = dynamic_cast<const OWLEquivalentDataPropertiesAxiom*>(&axiom))
+        {
+            writeSorted(equivalent->getProperties(), &StructuralKeyWriter::writeProperty);
+        } else if(const OWLDisjointDataPropertiesAxiom* disjoint = dynamic_cast<const OWLDisjointDataPropertiesAxiom*>(&axiom))
+        {
+            writeSorted(disjoint->getProperties(), &StructuralKeyWriter::writeProperty);
+        } else if(const OWLUnaryPropertyAxiom<OWLObjectPropertyAxiom>* unary = dynamic_cast<const OWLUnaryPropertyAxiom<OWLObjectPropertyAxiom>*>(&axiom))
+        {
+            writeProperty(unary->getProperty());
+            writePropertyDomainAndRange(axiom);
+        } else if(const OWLUnaryPropertyAxiom<OWLDataPropertyAxiom>* unary = dynamic_cast<const OWLUnaryPropertyAxiom<OWLDataPropertyAxiom>*>(&axiom))
+        {
+            writeProperty(unary->getProperty());
+            writePropertyDomainAndRange(axiom);
+        } else if(const OWLUnaryPropertyAxiom<OWLAnnotationAxiom>* unary = dynamic_cast<const OWLUnaryPropertyAxiom<OWLAnnotationAxiom>*>(&axiom))
+        {
+            writeProperty(unary->getProperty());
+            writePropertyDomainAndRange(axiom);
+        } else if(const OWLClassAssertionAxiom* classAssertion = dynamic_cast<const OWLClassAssertionAxiom*>(&axiom))
+        {
+            writeIndividual(classAssertion->getIndividual());
+            writeClass(classAssertion->getClassExpression());
+        } else if(const OWLPropertyAssertionAxiom* propertyAssertion = dynamic_cast<const OWLPropertyAssertionAxiom*>(&axiom))
+        {
+            writeIndividual(propertyAssertion->getSubject());
+            writeProperty(propertyAssertion->getProperty());
+            OWLPropertyAssertionObject::Ptr object = propertyAssertion->getObject();
+            if(OWLLiteral::Ptr literal = dynamic_pointer_cast<OWLLiteral>(object))
+            {
+                writeLiteral(literal);
+            } else if(OWLIndividual::Ptr individual = dynamic_pointer_cast<OWLIndividual>(object))
+            {
+                writeIndividual(individual);
+            } else {
+                writeIdentity(object.get());
+            }
+        } else if(const OWLAnnotationAssertionAxiom* annotationAssertion = dynamic_cast<const OWLAnnotationAssertionAxiom*>(&axiom))
+        {
+            OWLAnnotationSubject::Ptr subject = annotationAssertion->getSubject();
+            if(shared_ptr<IRI> iri = dynamic_pointer_cast<IRI>(subject))
+            {
+                writeIRI(*iri);
+            } else if(OWLIndividual::Ptr individual = dynamic_pointer_cast<OWLAnonymousIndividual>(subject))
+            {
+                writeIndividual(individual);
+            } else {
+                writeIdentity(subject.get());
+            }
+            writeProperty(annotationAssertion->getProperty());
+            writeAnnotationValue(annotationAssertion->annotationValue());
+        } else {
+            // e.g. disjoint classes, which do not retain their operands
+            writeIdentity(&axiom);
+        }
+
+        std::vector<std::string> annotations;
+        for(const OWLAnnotation& annotation : axiom.getAnnotations())
+        {
+            StructuralKeyWriter writer(mpSignature);
+            writer.writeAnnotationValue(annotation.annotationValue());
+            annotations.push_back(writer.getKey());
+        }
+        writeSet(annotations);
+    }
+
+    void writeClass(const OWLClassExpression::Ptr& ce)
+    {
+        if(!ce)
+        {
+            writeNull();
+            return;
+        }
+
+        writeToken(typeid(*ce).name());
+        if(OWLClass::Ptr klass = dynamic_pointer_cast<OWLClass>(ce))
+        {
+            addToSignature(klass);
+            writeIRI(klass->getIRI());
+        } else if(shared_ptr<OWLNaryBooleanExpression> booleanExpression = dynamic_pointer_cast<OWLNaryBooleanExpression>(ce))
+        {
+            writeSorted(booleanExpression->getOperands(), &StructuralKeyWriter::writeClass);
+        } else if(OWLObjectComplementOf::Ptr complementOf = dynamic_pointer_cast<OWLObjectComplementOf>(ce))
+        {
+            writeClass(complementOf->getOperand());
+        } else if(OWLObjectOneOf::Ptr oneOf = dynamic_pointer_cast<OWLObjectOneOf>(ce))
+        {
+            writeSorted(oneOf->getNamedIndividuals(), &StructuralKeyWriter::writeIndividual);
+        } else if(OWLCardinalityRestriction::Ptr restriction = dynamic_pointer_cast<OWLCardinalityRestriction>(ce))
+        {
+            writeProperty(restriction->getProperty());
+            writeToken(std::to_string(restriction->getCardinalityRestrictionType()));
+            writeToken(std::to_string(restriction->getCardinality()));
+            if(OWLObjectCardinalityRestriction::Ptr objectRestriction = dynamic_pointer_cast<OWLObjectCardinalityRestriction>(ce))
+            {
+                // The filler is optional and might be anonymous; only a named
+                // filler is added to the signature
+                writeClass(objectRestriction->getFiller());
+            } else if(OWLDataCardinalityRestriction::Ptr dataRestriction = dynamic_pointer_cast<OWLDataCardinalityRestriction>(ce))
+            {
+                writeDataRange(dataRestriction->getFiller());
+            }
+        } else if(OWLQuantifiedObjectRestriction::Ptr restriction = dynamic_pointer_cast<OWLQuantifiedObjectRestriction>(ce))
+        {
+            writeProperty(restriction->OWLObjectRestriction::getProperty());
+            writeClass(restriction->getFiller());
+        } else if(OWLQuantifiedDataRestriction::Ptr restriction = dynamic_pointer_cast<OWLQuantifiedDataRestriction>(ce))
+        {
+            writeProperty(restriction->OWLDataRestriction::getProperty());
+            writeDataRange(restriction->getFiller());
+        } else if(OWLObjectHasValue::Ptr hasValue = dynamic_pointer_cast<OWLObjectHasValue>(ce))
+        {
+            writeProperty(hasValue->OWLObjectRestriction::getProperty());
+            writeIndividual(hasValue->getFiller());
+        } else if(OWLDataHasValue::Ptr hasValue = dynamic_pointer_cast<OWLDataHasValue>(ce))
+        {
+            writeProperty(hasValue->OWLDataRestriction::getProperty());
+            writeLiteral(hasValue->getFiller());
+        } else {
+            writeIdentity(ce.get());
+        }
+    }
+
+    void writeProperty(const OWLPropertyExpression::Ptr& property)
+    {
+        if(!property)
+        {
+            writeNull();
+            return;
+        }
+
+        writeToken(typeid(*property).name());
+        if(shared_ptr<OWLInverseObjectProperty> inverse = dynamic_pointer_cast<OWLInverseObjectProperty>(property))
+        {
+            writeProperty(inverse->getInverse());
+        } else if(OWLNamedObject::Ptr namedProperty = dynamic_pointer_cast<OWLNamedObject>(property))
+        {
+            addToSignature(dynamic_pointer_cast<OWLEntity>(property));
+            writeIRI(namedProperty->getIRI());
+        } else {
+            writeIdentity(property.get());
+        }
+    }
+
+    void writeIndividual(const OWLIndividual::Ptr& individual)
+    {
+        if(!individual)
+        {
+            writeNull();
+            return;
+        }
+        if(OWLNamedIndividual::Ptr namedIndividual = dynamic_pointer_cast<OWLNamedIndividual>(individual))
+        {
+            addToSignature(namedIndividual);
+            mKey += 'N';
+        } else {
+            mKey += 'A';
+        }
+        writeIRI(individual->getReferenceID());
+    }
+
+    void writeLiteral(const OWLLiteral::Ptr& literal)
+    {
+        if(!literal)
+        {
+            writeNull();
+            return;
+        }
+        mKey += 'L';
+        writeToken(literal->getType());
+        writeToken(literal->getValue());
+    }
+
+    void writeDataRange(const OWLDataRange::Ptr& range)
+    {
+        if(!range)
+        {
+            writeNull();
+            return;
+        }
+
+        writeToken(typeid(*range).name());
+        if(OWLDataType::Ptr datatype = dynamic_pointer_cast<OWLDataType>(range))
+        {
+            addToSignature(datatype);
+            writeIRI(datatype->getIRI());
+        } else if(OWLDataOneOf::Ptr oneOf = dynamic_pointer_cast<OWLDataOneOf>(range))
+        {
+            writeSorted(oneOf->getLiterals(), &StructuralKeyWriter::writeLiteral);
+        } else if(OWLDataTypeRestriction::Ptr restriction = dynamic_pointer_cast<OWLDataTypeRestriction>(range))
+        {
+            writeIRI(restriction->getDataType().getIRI());
+            std::vector<std::string> facets;
+            for(const OWLFacetRestriction& facetRestriction : restriction->getFacetRestrictions())
+            {
+                StructuralKeyWriter writer(mpSignature);
+                writer.writeIRI(facetRestriction.getFacet().getIRI());
+                writer.writeLiteral(facetRestriction.getFacetValue());
+                facets.push_back(writer.getKey());
+            }
+            writeSet(facets);
+        } else {
+            writeIdentity(range.get());
+        }
+    }
+
+    void writeAnnotationValue(const OWLAnnotationValue::Ptr& value)
+    {
+        if(OWLLiteral::Ptr literal = dynamic_pointer_cast<OWLLiteral>(value))
+        {
+            writeLiteral(literal);
+        } else if(shared_ptr<IRI> iri = dynamic_pointer_cast<IRI>(value))
+        {
+            mKey += 'I';
+            writeIRI(*iri);
+        } else if(OWLIndividual::Ptr individual = dynamic_pointer_cast<OWLAnonymousIndividual>(value))
+        {
+            writeIndividual(individual);
+        } else if(value)
+        {
+            writeIdentity(value.get());
+        } else {
+            writeNull();
+        }
+    }
+
+private:
+    void addToSignature(const OWLEntity::Ptr& entity)
+    {
+        if(mpSignature && entity)
+        {
+            mpSignature->push_back(entity);
+        }
+    }
+
+    void writePropertyDomainAndRange(const OWLAxiom& axiom)
+    {
+        if(const OWLPropertyDomainAxiom<OWLClassExpression::Ptr>* domain = dynamic_cast<const OWLPropertyDomainAxiom<OWLClassExpression::Ptr>*>(&axiom))
+        {
+            writeClass(domain->getDomain());
+        } else if(const OWLPropertyDomainAxiom<IRI>* domain = dynamic_cast<const OWLPropertyDomainAxiom<IRI>*>(&axiom))
+        {
+            writeIRI(domain->getDomain());
+        } else if(const OWLPropertyRangeAxiom<OWLClassExpression::Ptr>* range = dynamic_cast<const OWLPropertyRangeAxiom<OWLClassExpression::Ptr>*>(&axiom))
+        {
+            writeClass(range->getRange());
+        } else if(const OWLPropertyRangeAxiom<OWLDataRange::Ptr>* range = dynamic_cast<const OWLPropertyRangeAxiom<OWLDataRange::Ptr>*>(&axiom))
+        {
+            writeDataRange(range->getRange());
+        } else if(const OWLPropertyRangeAxiom<IRI>* range = dynamic_cast<const OWLPropertyRangeAxiom<IRI>*>(&axiom))
+        {
+            writeIRI(range->getRange());
+        }
+    }
+
+    /**
+     * Write the operands of an n-ary axiom or expression independent of
+     * their order
+     */
+    template<typename List, typename Item>
+    void writeSorted(const List& list, void (StructuralKeyWriter::*write)(const Item&))
+    {
+        std::vector<std::string> keys;
+        for(const typename List::value_type& item : list)
+        {
+            StructuralKeyWriter writer(mpSignature);
+            (writer.*write)(item);
+            keys.push_back(writer.getKey());
+        }
+        writeSet(keys);
+    }
+
+    void writeSet(std::vector<std::string>& keys)
+    {
+        std::sort(keys.begin(), keys.end());
+        mKey += '{';
+        for(const std::string& key : keys)
+        {
+            writeToken(key);
+        }
+        mKey += '}';
+    }
+
+    void writeToken(const std::string& token)
+    {
+        mKey += std::to_string(token.size());
+        mKey += ':';
+        mKey += token;
+    }
+
+    void writeIRI(const IRI& iri) { writeToken(iri.toString()); }
+
+    void writeNull() { mKey += '0'; }
+
+    /// Parts which cannot be inspected are only equal to themselves
+    void writeIdentity(const void* object)
+    {
+        mKey += '@';
+        writeToken(std::to_string(reinterpret_cast<uintptr_t>(object)));
+    }
+
+    std::string mKey;
+    OWLEntity::PtrList* mpSignature;
+};
+
+} // end anonymous namespace
+
 std::map<OWLAxiom::AxiomType, std::string> OWLAxiom::AxiomTypeTxt = {
                 {UNKOWN,                            "UNKNOWN"},
                 {Declaration,                       "Declaration"},
@@ -130,6 +507,38 @@ void OWLAxiom::accept(OWLAxiomVisitor* visitor) const
     }
 }
 
+std::string OWLAxiom::getStructuralKey() const
+{
+    StructuralKeyWriter writer;
+    writer.writeAxiom(*this);
+    return writer.getKey();
+}
+
+OWLEntity::PtrList OWLAxiom::getSignature() const
+{
+    OWLEntity::PtrList signature;
+    StructuralKeyWriter writer(&signature);
+    writer.writeAxiom(*this);
+    return signature;
+}
+
+std::string OWLClassExpression::getStructuralKey(const OWLClassExpression::Ptr& expression)
+{
+    StructuralKeyWriter writer;
+    writer.writeClass(expression);
+    return writer.getKey();
+}
+
+size_t OWLAxiom::getStructuralHash() const
+{
+    return std::hash<std::string>()(getStructuralKey());
+}
+
+bool OWLAxiom::isStructurallyEqual(const OWLAxiom& other) const
+{
+    return this == &other || getStructuralKey() == other.getStructuralKey();
+}
+
 OWLAxiom::Ptr OWLAxiom::declare(const OWLEntity::Ptr& entity)
 {
     return make_shared<OWLDeclarationAxiom>(entity);
@@ -143,6 +143,33 @@ public:
 
     virtual std::string toString() const;
 
+    /**
+     * Get a canonical representation of the structure of this axiom
+     * \details The key comprises the axiom type, the referenced entities,
+     * expressions and literals as well as the annotations. The origin of the
+     * axiom is not part of its structure. Operands of n-ary axioms and
+     * expressions are sorted, since their order does not matter. Parts which
+     * cannot be inspected are represented by their identity.
+     */
+    std::string getStructuralKey() const;
+
+    /**
+     * Get the entities this axiom refers to
+     * \details An entity is listed once for each reference
+     */
+    OWLEntity::PtrList getSignature() const;
+
+    /**
+     * Get the hash of the structural key of this axiom
+     */
+    size_t getStructuralHash() const;
+
+    /**
+     * Check whether this axiom and the given one are structurally equal,
+     * i.e. have the same structural key
+     */
+    bool isStructurallyEqual(const OWLAxiom& other) const;
+
     static OWLAxiom::Ptr declare(const OWLEntity::Ptr& entity);
 
     /**
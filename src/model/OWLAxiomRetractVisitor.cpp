@@ -15,6 +15,9 @@ void OWLAxiomRetractVisitor::visit(const OWLDeclarationAxiom& axiom)
 
 void OWLAxiomRetractVisitor::visit(const OWLClassAssertionAxiom& axiom)
 {
+    mpOntology->invalidateQueryCache(axiom);
+    mpOntology->removeReferences(axiom);
+
     mpOntology->removeAxiomFromMap(mpOntology->mClassAssertionAxiomsByClass[axiom.getClassExpression()],
             &axiom);
     mpOntology->removeAxiomFromMap(mpOntology->mClassAssertionAxiomsByIndividual[axiom.getIndividual()],
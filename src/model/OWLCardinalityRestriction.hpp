@@ -56,8 +56,13 @@ public:
     /**
      * Set cardinality -- e.g. to allow incremental construction of restrictions
      * or reuse
+     * \throw std::runtime_error if this restriction is shared
      */
-    void setCardinality(uint32_t cardinality) { mCardinality = cardinality; }
+    void setCardinality(uint32_t cardinality)
+    {
+        requireUnshared("owlapi::model::OWLCardinalityRestriction::setCardinality");
+        mCardinality = cardinality;
+    }
 
     /**
      * Get the restriction type
@@ -92,7 +97,11 @@ public:
             const OWLDataRange::Ptr& range,
             CardinalityRestrictionType restrictionType);
 
-    void setCardinalityRestrictionType(OWLCardinalityRestriction::CardinalityRestrictionType type) { mCardinalityRestrictionType = type; }
+    void setCardinalityRestrictionType(OWLCardinalityRestriction::CardinalityRestrictionType type)
+    {
+        requireUnshared("owlapi::model::OWLCardinalityRestriction::setCardinalityRestrictionType");
+        mCardinalityRestrictionType = type;
+    }
 
     /**
      * Depending on the property type, narrow the internally used class to
@@ -3,11 +3,208 @@
 #include "OWLObjectCardinalityRestriction.hpp"
 #include "OWLDataCardinalityRestriction.hpp"
 
+#include "OWLProperty.hpp"
+
+#include <unordered_map>
+#include <boost/functional/hash.hpp>
 #include <base-logging/Logging.hpp>
 
 namespace owlapi {
 namespace model {
 
+namespace {
+
+/**
+ * Restrictions overlap if they refer to the same property and
+ * qualification, join operations additionally require the same cardinality
+ * type
+ */
+struct RestrictionKey
+{
+    IRI property;
+    const OWLClassExpression* qualification;
+    OWLCardinalityRestriction::CardinalityRestrictionType type;
+
+    bool operator==(const RestrictionKey& other) const
+    {
+        return property == other.property
+            && qualification == other.qualification
+            && type == other.type;
+    }
+};
+
+struct RestrictionKeyHash
+{
+    size_t operator()(const RestrictionKey& key) const
+    {
+        size_t seed = 0;
+        boost::hash_combine(seed, key.property.getId());
+        boost::hash_combine(seed, key.qualification);
+        boost::hash_combine(seed, static_cast<int>(key.type));
+        return seed;
+    }
+};
+
+/**
+ * Plain representation of a restriction for the merge operations
+ */
+struct Bound
+{
+    OWLCardinalityRestriction::CardinalityRestrictionType type;
+    uint32_t cardinality;
+};
+
+/// Outcome of intersecting two overlapping bounds
+enum IntersectionResult { MERGED, DISJOINT, CONFLICT };
+
+/**
+ * Compute the key of an object cardinality restriction on a named property
+ * \param withType Whether the cardinality type is part of the key
+ * \return false if the restriction requires the generic pairwise handling
+ */
+bool getRestrictionKey(const OWLCardinalityRestriction::Ptr& restriction, bool withType, RestrictionKey& key)
+{
+    OWLObjectCardinalityRestriction::Ptr oRestriction = dynamic_pointer_cast<OWLObjectCardinalityRestriction>(restriction);
+    if(!oRestriction)
+    {
+        return false;
+    }
+    OWLProperty::Ptr property = dynamic_pointer_cast<OWLProperty>(restriction->getProperty());
+    if(!property)
+    {
+        return false;
+    }
+
+    key.property = property->getIRI();
+    key.qualification = oRestriction->getFiller().get();
+    key.type = withType ? restriction->getCardinalityRestrictionType() : OWLCardinalityRestriction::UNKNOWN;
+    return true;
+}
+
+Bound getBound(const OWLCardinalityRestriction::Ptr& restriction)
+{
+    Bound bound = { restriction->getCardinalityRestrictionType(), restriction->getCardinality() };
+    return bound;
+}
+
+/**
+ * Intersect the bounds of two overlapping object restrictions, following
+ * OWLObjectCardinalityRestriction::intersection
+ */
+IntersectionResult intersectBounds(const Bound& a, const Bound& b, Bound& result)
+{
+    typedef OWLCardinalityRestriction R;
+    if(a.type == b.type)
+    {
+        switch(a.type)
+        {
+            case R::MIN:
+                result.type = R::MIN;
+                result.cardinality = std::max(a.cardinality, b.cardinality);
+                return MERGED;
+            case R::MAX:
+                result.type = R::MAX;
+                result.cardinality = std::min(a.cardinality, b.cardinality);
+                return MERGED;
+            case R::EXACT:
+                result = a;
+                return a.cardinality == b.cardinality ? MERGED : CONFLICT;
+            default:
+                return CONFLICT;
+        }
+    }
+
+    const Bound* min = NULL;
+    const Bound* max = NULL;
+    const Bound* exact = NULL;
+    const Bound* other = NULL;
+    if(a.type == R::MIN && b.type == R::MAX)
+    {
+        min = &a; max = &b;
+    } else if(a.type == R::MAX && b.type == R::MIN)
+    {
+        min = &b; max = &a;
+    } else if(a.type == R::EXACT)
+    {
+        exact = &a; other = &b;
+    } else if(b.type == R::EXACT)
+    {
+        exact = &b; other = &a;
+    } else {
+        return DISJOINT;
+    }
+
+    if(min)
+    {
+        if(min->cardinality == max->cardinality)
+        {
+            result.type = R::EXACT;
+            result.cardinality = min->cardinality;
+            return MERGED;
+        }
+        return min->cardinality > max->cardinality ? CONFLICT : DISJOINT;
+    }
+
+    result = *exact;
+    switch(other->type)
+    {
+        case R::MIN:
+            return exact->cardinality >= other->cardinality ? MERGED : CONFLICT;
+        case R::MAX:
+            return exact->cardinality <= other->cardinality ? MERGED : CONFLICT;
+        default:
+            return CONFLICT;
+    }
+}
+
+/**
+ * Join the cardinalities of two restrictions of the same type
+ */
+uint32_t joinCardinalities(uint32_t a, uint32_t b, OWLCardinalityRestrictionOps::OperationType operationType)
+{
+    switch(operationType)
+    {
+        case OWLCardinalityRestrictionOps::SUM_OP:
+            return a + b;
+        case OWLCardinalityRestrictionOps::MIN_OP:
+            return std::min(a, b);
+        case OWLCardinalityRestrictionOps::MAX_OP:
+            return std::max(a, b);
+    }
+    return 0;
+}
+
+OWLCardinalityRestriction::Ptr createRestriction(const OWLCardinalityRestriction::Ptr& prototype, const Bound& bound)
+{
+    OWLObjectCardinalityRestriction::Ptr oRestriction = dynamic_pointer_cast<OWLObjectCardinalityRestriction>(prototype);
+    return OWLCardinalityRestriction::getInstance(prototype->getProperty(),
+            bound.cardinality,
+            oRestriction->getFiller(),
+            bound.type);
+}
+
+typedef std::unordered_map<RestrictionKey, std::vector<size_t>, RestrictionKeyHash> RestrictionIndex;
+
+/**
+ * Index restrictions by key, preserving their order for each key
+ */
+RestrictionIndex indexRestrictions(const std::vector<OWLCardinalityRestriction::Ptr>& restrictions, bool withType)
+{
+    RestrictionIndex index;
+    index.reserve(restrictions.size());
+    RestrictionKey key;
+    for(size_t i = 0; i < restrictions.size(); ++i)
+    {
+        if(getRestrictionKey(restrictions[i], withType, key))
+        {
+            index[key].push_back(i);
+        }
+    }
+    return index;
+}
+
+} // end anonymous namespace
+
 std::map<OWLCardinalityRestrictionOps::OperationType, std::string> OWLCardinalityRestrictionOps::OperationTypeTxt = {
     {SUM_OP, "SUM_OP"},
     {MIN_OP, "MIN_OP"},
@@ -35,50 +232,96 @@ OWLCardinalityRestriction::Ptr OWLCardinalityRestrictionOps::intersection(const
 
 std::vector<OWLCardinalityRestriction::Ptr> OWLCardinalityRestrictionOps::intersection(
         const std::vector<OWLCardinalityRestriction::Ptr>& a,
-        const std::vector<OWLCardinalityRestriction::Ptr>& _b
+        const std::vector<OWLCardinalityRestriction::Ptr>& b
 )
 {
     std::vector<OWLCardinalityRestriction::Ptr> restrictions;
-    std::vector<OWLCardinalityRestriction::Ptr> b = _b;
+    restrictions.reserve(a.size() + b.size());
 
-    std::vector<OWLCardinalityRestriction::Ptr>::const_iterator ait = a.begin();
-    for(; ait != a.end(); ++ait)
+    // Only restrictions with the same key can be intersected, so that only
+    // these candidates of b need to be checked
+    RestrictionIndex index = indexRestrictions(b, false);
+    std::vector<bool> merged(b.size(), false);
+
+    RestrictionKey key;
+    std::vector<size_t> allCandidates;
+    for(const OWLCardinalityRestriction::Ptr& aRestriction : a)
     {
-        LOG_DEBUG_S << "Try merging : " << (*ait)->toString();
-        bool intersectiond = false;
-        std::vector<OWLCardinalityRestriction::Ptr>::iterator bit = b.begin();
-        for(; bit != b.end(); ++bit)
+        const std::vector<size_t>* candidates = &allCandidates;
+        bool keyed = getRestrictionKey(aRestriction, false, key);
+        if(keyed)
+        {
+            RestrictionIndex::const_iterator cit = index.find(key);
+            candidates = cit == index.end() ? NULL : &cit->second;
+        } else if(allCandidates.size() != b.size())
         {
-            LOG_DEBUG_S << "   -- with : " << (*bit)->toString();
-            OWLCardinalityRestriction::Ptr aRestriction= *ait;
-            OWLCardinalityRestriction::Ptr bRestriction= *bit;
+            allCandidates.resize(b.size());
+            for(size_t i = 0; i < b.size(); ++i)
+            {
+                allCandidates[i] = i;
+            }
+        }
 
-            OWLCardinalityRestriction::Ptr restriction = intersection(aRestriction, bRestriction);
-            if(restriction)
+        OWLCardinalityRestriction::Ptr restriction;
+        if(candidates)
+        {
+            for(size_t i : *candidates)
             {
-                // merging succeeded
-                restrictions.push_back(restriction);
-
-                // assuming a compact representation of _a and _b, i.e. not multiple
-                // definitions of the same type in it we can skip checking the
-                // remaining
-                b.erase(bit);
-                LOG_DEBUG_S << "Merging succeeded: result is " << restriction->toString();
-                intersectiond = true;
-                break;
+                if(merged[i])
+                {
+                    continue;
+                }
+
+                Bound bound;
+                if(keyed)
+                {
+                    switch(intersectBounds(getBound(aRestriction), getBound(b[i]), bound))
+                    {
+                        case MERGED:
+                            restriction = createRestriction(aRestriction, bound);
+                            break;
+                        case DISJOINT:
+                            break;
+                        case CONFLICT:
+                            // report the incompatibility
+                            restriction = intersection(aRestriction, b[i]);
+                            break;
+                    }
+                } else {
+                    restriction = intersection(aRestriction, b[i]);
+                }
+
+                if(restriction)
+                {
+                    // assuming a compact representation of a and b, i.e. not multiple
+                    // definitions of the same type in it we can skip checking the
+                    // remaining
+                    merged[i] = true;
+                    break;
+                }
             }
         }
 
-        if(!intersectiond)
+        if(restriction)
         {
-            // seems like *ait did not get intersectiond, so add it to results
-            restrictions.push_back((*ait)->clone());
+            restrictions.push_back(restriction);
+        } else {
+            restrictions.push_back(aRestriction->clone());
         }
     }
-    // At this point the vector restrictions contains all intersectiond ones from a,
-    // but left one of b have still to be added
-    restrictions.insert(restrictions.begin(), b.begin(), b.end());
-    return restrictions;
+
+    // Remaining restrictions of b precede the intersected ones
+    std::vector<OWLCardinalityRestriction::Ptr> remaining;
+    remaining.reserve(b.size() + restrictions.size());
+    for(size_t i = 0; i < b.size(); ++i)
+    {
+        if(!merged[i])
+        {
+            remaining.push_back(b[i]);
+        }
+    }
+    remaining.insert(remaining.end(), restrictions.begin(), restrictions.end());
+    return remaining;
 }
 
 std::vector<OWLCardinalityRestriction::Ptr> OWLCardinalityRestrictionOps::compact(
@@ -86,17 +329,44 @@ std::vector<OWLCardinalityRestriction::Ptr> OWLCardinalityRestrictionOps::compac
         OperationType operationType
 )
 {
-    std::vector<OWLCardinalityRestriction::Ptr> compactRestrictions;
-    std::vector<OWLCardinalityRestriction::Ptr>::const_iterator cit = restrictions.begin();
-    for(; cit != restrictions.end(); ++cit)
+    // Accumulate the cardinalities per key in order of the first occurrence
+    std::unordered_map<RestrictionKey, size_t, RestrictionKeyHash> index;
+    index.reserve(restrictions.size());
+    std::vector< std::pair<OWLCardinalityRestriction::Ptr, Bound> > bounds;
+    bounds.reserve(restrictions.size());
+
+    RestrictionKey key;
+    for(const OWLCardinalityRestriction::Ptr& restriction : restrictions)
     {
-        std::vector<OWLCardinalityRestriction::Ptr> singleRestriction;
-        singleRestriction.push_back(*cit);
+        if(!getRestrictionKey(restriction, true, key) || key.type == OWLCardinalityRestriction::UNKNOWN)
+        {
+            // Generic handling, which reports unsupported restrictions
+            std::vector<OWLCardinalityRestriction::Ptr> compactRestrictions;
+            for(const OWLCardinalityRestriction::Ptr& r : restrictions)
+            {
+                std::vector<OWLCardinalityRestriction::Ptr> singleRestriction(1, r);
+                compactRestrictions = join(compactRestrictions, singleRestriction, operationType);
+            }
+            return compactRestrictions;
+        }
 
-        std::vector<OWLCardinalityRestriction::Ptr> merged = join(compactRestrictions, singleRestriction, operationType);
-        compactRestrictions = merged;
+        std::pair<std::unordered_map<RestrictionKey, size_t, RestrictionKeyHash>::iterator, bool> inserted =
+            index.insert(std::make_pair(key, bounds.size()));
+        if(inserted.second)
+        {
+            bounds.push_back(std::make_pair(restriction, getBound(restriction)));
+        } else {
+            Bound& bound = bounds[inserted.first->second].second;
+            bound.cardinality = joinCardinalities(bound.cardinality, restriction->getCardinality(), operationType);
+        }
     }
 
+    std::vector<OWLCardinalityRestriction::Ptr> compactRestrictions;
+    compactRestrictions.reserve(bounds.size());
+    for(const std::pair<OWLCardinalityRestriction::Ptr, Bound>& p : bounds)
+    {
+        compactRestrictions.push_back(createRestriction(p.first, p.second));
+    }
     return compactRestrictions;
 }
 
@@ -142,61 +412,74 @@ OWLCardinalityRestriction::Ptr OWLCardinalityRestrictionOps::join(const OWLCardi
 
 std::vector<OWLCardinalityRestriction::Ptr> OWLCardinalityRestrictionOps::join(
         const std::vector<OWLCardinalityRestriction::Ptr>& a,
-        const std::vector<OWLCardinalityRestriction::Ptr>& _b,
+        const std::vector<OWLCardinalityRestriction::Ptr>& b,
         OperationType operationType
 )
 {
     std::vector<OWLCardinalityRestriction::Ptr> restrictions;
-    std::vector<OWLCardinalityRestriction::Ptr> b = _b;
+    restrictions.reserve(a.size() + b.size());
+
+    // Only restrictions with the same key can be joined, so that only these
+    // candidates of b need to be checked
+    RestrictionIndex index = indexRestrictions(b, true);
+    std::vector<bool> joined(b.size(), false);
 
-    std::vector<OWLCardinalityRestriction::Ptr>::const_iterator ait = a.begin();
-    for(; ait != a.end(); ++ait)
+    RestrictionKey key;
+    for(const OWLCardinalityRestriction::Ptr& aRestriction : a)
     {
-        LOG_DEBUG_S << "Try joining: " << (*ait)->toString();
-        bool joined = false;
-        std::vector<OWLCardinalityRestriction::Ptr>::iterator bit = b.begin();
-        for(; bit != b.end(); ++bit)
+        OWLCardinalityRestriction::Ptr restriction;
+        if(getRestrictionKey(aRestriction, true, key) && key.type != OWLCardinalityRestriction::UNKNOWN)
         {
-            LOG_DEBUG_S << "   -- with : " << (*bit)->toString();
-            OWLCardinalityRestriction::Ptr aRestriction= *ait;
-            OWLCardinalityRestriction::Ptr bRestriction= *bit;
-
-            OWLCardinalityRestriction::Ptr restriction = join(aRestriction, bRestriction, operationType);
-            if(restriction)
+            RestrictionIndex::const_iterator cit = index.find(key);
+            if(cit != index.end())
             {
-                // merging succeeded
-                restrictions.push_back(restriction);
-
-                // assuming a compact representation of _a and _b, i.e. not multiple
-                // definitions of the same type in it we can skip checking the
-                // remaining
-                b.erase(bit);
-                LOG_DEBUG_S << "Joining succeeded: result is " << restriction->toString();
-                joined = true;
-                break;
-            } else {
-                LOG_DEBUG_S << "Joining failed";
+                for(size_t i : cit->second)
+                {
+                    if(!joined[i])
+                    {
+                        Bound bound = getBound(aRestriction);
+                        bound.cardinality = joinCardinalities(bound.cardinality, b[i]->getCardinality(), operationType);
+                        restriction = createRestriction(aRestriction, bound);
+                        // assuming a compact representation of a and b
+                        joined[i] = true;
+                        break;
+                    }
+                }
+            }
+        } else {
+            for(size_t i = 0; i < b.size(); ++i)
+            {
+                if(!joined[i])
+                {
+                    restriction = join(aRestriction, b[i], operationType);
+                    if(restriction)
+                    {
+                        joined[i] = true;
+                        break;
+                    }
+                }
             }
         }
 
-        if(!joined)
+        if(restriction)
         {
-            // seems like *ait did not get intersectiond, so add it to results
-            restrictions.push_back((*ait)->clone());
+            restrictions.push_back(restriction);
+        } else {
+            restrictions.push_back(aRestriction->clone());
         }
     }
-    // At this point the vector restrictions contains all intersectiond ones from a,
-    // but left one of b have still to be added
-    OWLCardinalityRestriction::PtrList::const_iterator bit = b.begin();
-    for(; bit != b.end(); ++bit)
+
+    for(size_t i = 0; i < b.size(); ++i)
     {
-        // make sure we create an indepenant result set
-        restrictions.push_back((*bit)->clone());
+        if(!joined[i])
+        {
+            // make sure we create an indepenant result set
+            restrictions.push_back(b[i]->clone());
+        }
     }
     return restrictions;
 }
 
-
 } // end namespace model
 } // end namespace owlapi
 
@@ -4,6 +4,32 @@
 namespace owlapi {
 namespace model {
 
+OWLClassExpression::OWLClassExpression()
+    : OWLPropertyRange()
+    , mShared(false)
+{}
+
+OWLClassExpression::OWLClassExpression(const OWLClassExpression& other)
+    : OWLPropertyRange(other)
+    , mShared(false)
+{}
+
+OWLClassExpression& OWLClassExpression::operator=(const OWLClassExpression& other)
+{
+    requireUnshared("owlapi::model::OWLClassExpression::operator=");
+    OWLPropertyRange::operator=(other);
+    return *this;
+}
+
+void OWLClassExpression::requireUnshared(const std::string& caller) const
+{
+    if(mShared)
+    {
+        throw std::runtime_error(caller + ": cannot modify a shared class expression"
+                " -- use a clone instead");
+    }
+}
+
 std::map<OWLClassExpression::ClassExpressionType, std::string> OWLClassExpression::TypeTxt =  {
     {ANONYMOUS, "ANONYMOUS"},
     {DATA_ALL_VALUES_FROM, "DATA_ALL_VALUES_FROM"},
@@ -18,7 +18,18 @@ namespace model {
  */
 class OWLClassExpression : public OWLPropertyRange //, SWRLPredicate
 {
+    friend class OWLClassExpressionPool;
+
 public:
+    OWLClassExpression();
+
+    /**
+     * Copies are never shared, even if the original is
+     */
+    OWLClassExpression(const OWLClassExpression& other);
+
+    OWLClassExpression& operator=(const OWLClassExpression& other);
+
     virtual ~OWLClassExpression() {}
 
     /// ClassExpressionType represents all subtypes
@@ -75,6 +86,33 @@ public:
      * \return stringified object
      */
     virtual std::string toString() const { return "ClassExpression: " + TypeTxt[getClassExpressionType()]; }
+
+    /**
+     * \brief Get a canonical string representation of the structure of a class
+     * expression
+     * \details Structurally equal expressions have the same key. Expressions
+     * whose structure cannot be represented are only equal to themselves.
+     */
+    static std::string getStructuralKey(const Ptr& expression);
+
+    /**
+     * Check whether this expression has been interned as canonical instance
+     * of an OWLClassExpressionPool
+     * \details Shared expressions must not be modified, use clone() to derive
+     * a modified expression
+     */
+    bool isShared() const { return mShared; }
+
+protected:
+    /**
+     * Ensure that this expression can be modified, to be called by setters
+     * \param caller Name of the modifying function for the error message
+     * \throw std::runtime_error if this expression is shared
+     */
+    void requireUnshared(const std::string& caller) const;
+
+private:
+    bool mShared;
 };
 
 } // end namespace model
@@ -0,0 +1,111 @@
+#include "OWLClassExpressionPool.hpp"
+#include <algorithm>
+
+namespace owlapi {
+namespace model {
+
+const size_t OWLClassExpressionPool::MIN_PURGE_SIZE = 64;
+
+OWLClassExpressionPool::OWLClassExpressionPool()
+    : mPurgeSize(MIN_PURGE_SIZE)
+{}
+
+OWLClassExpression::Ptr OWLClassExpressionPool::intern(const OWLClassExpression::Ptr& expression)
+{
+    if(!expression || !expression->isAnonymous() || isCanonical(expression.get()))
+    {
+        return expression;
+    }
+
+    std::string key = OWLClassExpression::getStructuralKey(expression);
+    ExpressionMap::iterator it = mExpressions.find(key);
+    if(it != mExpressions.end())
+    {
+        if(OWLClassExpression::Ptr canonical = it->second.lock())
+        {
+            return canonical;
+        }
+        // the previous canonical instance is no longer in use
+        it->second = expression;
+    } else {
+        mExpressions.insert(std::make_pair(key, WeakPtr(expression)));
+    }
+    mCanonical[expression.get()] = expression;
+    expression->mShared = true;
+
+    if(mCanonical.size() >= mPurgeSize)
+    {
+        purge();
+    }
+    return expression;
+}
+
+OWLClassExpression::Ptr OWLClassExpressionPool::find(const OWLClassExpression::Ptr& expression) const
+{
+    if(!expression || !expression->isAnonymous() || isCanonical(expression.get()))
+    {
+        return expression;
+    }
+
+    ExpressionMap::const_iterator cit = mExpressions.find(OWLClassExpression::getStructuralKey(expression));
+    if(cit == mExpressions.end())
+    {
+        return OWLClassExpression::Ptr();
+    }
+    return cit->second.lock();
+}
+
+bool OWLClassExpressionPool::isCanonical(const OWLClassExpression* expression) const
+{
+    // The address of an expired instance might have been reused
+    CanonicalMap::const_iterator cit = mCanonical.find(expression);
+    return cit != mCanonical.end() && !cit->second.expired();
+}
+
+size_t OWLClassExpressionPool::size() const
+{
+    size_t numberOfExpressions = 0;
+    for(const ExpressionMap::value_type& entry : mExpressions)
+    {
+        if(!entry.second.expired())
+        {
+            ++numberOfExpressions;
+        }
+    }
+    return numberOfExpressions;
+}
+
+void OWLClassExpressionPool::clear()
+{
+    mExpressions.clear();
+    mCanonical.clear();
+    mPurgeSize = MIN_PURGE_SIZE;
+}
+
+void OWLClassExpressionPool::purge()
+{
+    for(ExpressionMap::iterator it = mExpressions.begin(); it != mExpressions.end();)
+    {
+        if(it->second.expired())
+        {
+            it = mExpressions.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for(CanonicalMap::iterator it = mCanonical.begin(); it != mCanonical.end();)
+    {
+        if(it->second.expired())
+        {
+            it = mCanonical.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    // purge again only once the pool has doubled, which keeps the cost of
+    // purging constant per interned expression
+    mPurgeSize = std::max(MIN_PURGE_SIZE, 2*mCanonical.size());
+}
+
+} // end namespace model
+} // end namespace owlapi
@@ -0,0 +1,92 @@
+#ifndef OWLAPI_MODEL_OWL_CLASS_EXPRESSION_POOL_HPP
+#define OWLAPI_MODEL_OWL_CLASS_EXPRESSION_POOL_HPP
+
+#include <string>
+#include <unordered_map>
+#include "OWLClassExpression.hpp"
+
+namespace owlapi {
+namespace model {
+
+/**
+ * \class OWLClassExpressionPool
+ * \brief Hash-consing pool of class expressions
+ * \details The pool maps every class expression to a canonical instance, so
+ * that structurally equal expressions which have been interned are the same
+ * object and can be compared by pointer. Canonical instances are shared and
+ * cannot be modified: use clone() to derive a modified expression.
+ * Named classes are already unique per ontology and are not pooled.
+ * The pool holds its instances weakly: an instance stays canonical as long as
+ * it is in use, e.g. by an axiom or as registered anonymous class expression,
+ * so that pointer equality holds for all users, while transient expressions
+ * do not accumulate. Expired entries are replaced on lookup and purged
+ * whenever the pool has doubled in size.
+ * \see OWLClassExpression::getStructuralKey
+ */
+class OWLClassExpressionPool
+{
+public:
+    OWLClassExpressionPool();
+
+    /**
+     * Get the canonical instance of a class expression
+     * \return the previously interned expression which is structurally
+     * equal to the given one, otherwise the given expression which becomes
+     * the canonical instance
+     */
+    OWLClassExpression::Ptr intern(const OWLClassExpression::Ptr& expression);
+
+    /**
+     * Get the canonical instance of a class expression keeping the type of
+     * the given pointer
+     */
+    template<typename T>
+    shared_ptr<T> intern(const shared_ptr<T>& expression)
+    {
+        return dynamic_pointer_cast<T>( intern(dynamic_pointer_cast<OWLClassExpression>(expression)) );
+    }
+
+    /**
+     * Find the canonical instance of a class expression
+     * \return the interned expression which is structurally equal to the given
+     * one, or an empty pointer if there is none
+     */
+    OWLClassExpression::Ptr find(const OWLClassExpression::Ptr& expression) const;
+
+    /**
+     * Check whether the given expression is a canonical instance, which does
+     * not require the computation of the structural key
+     */
+    bool isCanonical(const OWLClassExpression* expression) const;
+
+    /**
+     * Get the number of canonical instances which are still in use
+     */
+    size_t size() const;
+
+    void clear();
+
+private:
+    typedef weak_ptr<OWLClassExpression> WeakPtr;
+    typedef std::unordered_map<std::string, WeakPtr> ExpressionMap;
+    typedef std::unordered_map<const OWLClassExpression*, WeakPtr> CanonicalMap;
+
+    /// Minimum number of entries before expired entries are purged
+    static const size_t MIN_PURGE_SIZE;
+
+    /**
+     * Remove the entries of all expired instances
+     */
+    void purge();
+
+    /// Canonical instances by structural key
+    ExpressionMap mExpressions;
+    /// Canonical instances by address
+    CanonicalMap mCanonical;
+    /// Number of entries at which expired entries are purged next
+    size_t mPurgeSize;
+};
+
+} // end namespace model
+} // end namespace owlapi
+#endif // OWLAPI_MODEL_OWL_CLASS_EXPRESSION_POOL_HPP
@@ -20,6 +20,16 @@ public:
     {}
 
     virtual ~OWLHasValueRestriction() = default;
+
+    /**
+     * Set the filler
+     * \throw std::runtime_error if this restriction is shared
+     */
+    void setFiller(const typename HasFiller<T>::filler_t& filler)
+    {
+        requireUnshared("owlapi::model::OWLHasValueRestriction::setFiller");
+        HasFiller<T>::setFiller(filler);
+    }
 };
 
 } // end namespace model
@@ -4,33 +4,198 @@
 #include "OWLLiteralNonNegativeInteger.hpp"
 #include <owlapi/Vocabulary.hpp>
 #include <boost/lexical_cast.hpp>
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+#include <pthread.h>
 #include <base-logging/Logging.hpp>
 
 namespace owlapi {
 namespace model {
 
+namespace {
+
+/**
+ * Get the representation of the values of a datatype
+ */
+OWLLiteral::ValueType getDatatypeValueType(const IRI& type)
+{
+    using namespace vocabulary;
+
+    if(type == XSD::boolean())
+    {
+        return OWLLiteral::BOOLEAN;
+    }
+
+    static const IRIList integerTypes = { XSD::integer(), XSD::resolve("int"),
+        XSD::resolve("long"), XSD::resolve("short"), XSD::byte(),
+        XSD::nonNegativeInteger(), XSD::nonPositiveInteger(),
+        XSD::positiveInteger(), XSD::negativeInteger(),
+        XSD::unsignedLong(), XSD::unsignedInt(), XSD::unsignedShort(),
+        XSD::unsignedByte() };
+    if(std::find(integerTypes.begin(), integerTypes.end(), type) != integerTypes.end())
+    {
+        return OWLLiteral::INTEGER;
+    }
+
+    if(type == XSD::resolve("double") || type == XSD::resolve("float") || type == XSD::decimal())
+    {
+        return OWLLiteral::DOUBLE;
+    }
+    return OWLLiteral::STRING;
+}
+
+/**
+ * Registry of the datatypes in use
+ * \details Lookups of known datatypes, i.e. the common case when creating
+ * literals, only take a shared lock
+ */
+struct DatatypeRegistry
+{
+    DatatypeRegistry() { pthread_rwlock_init(&lock, NULL); }
+    ~DatatypeRegistry() { pthread_rwlock_destroy(&lock); }
+
+    pthread_rwlock_t lock;
+    /// References to the elements remain valid on insertion
+    std::unordered_map<std::string, OWLLiteral::Datatype> datatypes;
+};
+
+/**
+ * Hold a read or write lock for the lifetime of the object
+ */
+class ScopedRWLock
+{
+public:
+    ScopedRWLock(pthread_rwlock_t& lock, bool exclusive)
+        : mLock(lock)
+    {
+        if(exclusive)
+        {
+            pthread_rwlock_wrlock(&mLock);
+        } else {
+            pthread_rwlock_rdlock(&mLock);
+        }
+    }
+
+    ~ScopedRWLock() { pthread_rwlock_unlock(&mLock); }
+
+private:
+    ScopedRWLock(const ScopedRWLock&);
+    ScopedRWLock& operator=(const ScopedRWLock&);
+
+    pthread_rwlock_t& mLock;
+};
+
+} // end anonymous namespace
+
+const OWLLiteral::Datatype* OWLLiteral::getDatatype(const std::string& type)
+{
+    static DatatypeRegistry registry;
+
+    {
+        ScopedRWLock lock(registry.lock, false);
+        std::unordered_map<std::string, Datatype>::const_iterator cit = registry.datatypes.find(type);
+        if(cit != registry.datatypes.end())
+        {
+            return &cit->second;
+        }
+    }
+
+    ScopedRWLock lock(registry.lock, true);
+    // another thread might have registered the datatype in the meantime
+    std::unordered_map<std::string, Datatype>::iterator it = registry.datatypes.find(type);
+    if(it == registry.datatypes.end())
+    {
+        IRI iri(type);
+        Datatype datatype = { iri, getDatatypeValueType(iri) };
+        it = registry.datatypes.insert(std::make_pair(type, datatype)).first;
+    }
+    return &it->second;
+}
+
 OWLLiteral::OWLLiteral()
-    : mType(vocabulary::RDF::PlainLiteral().toString())
+    : mDatatype(getDatatype(vocabulary::RDF::PlainLiteral().toString()))
+    , mValueType(STRING)
+    , mInteger(0)
 {}
 
 OWLLiteral::OWLLiteral(const std::string& value, const std::string& type)
-    : mValue(value)
-    , mType(type)
-{}
+    : mDatatype(getDatatype(type))
+    , mValueType(STRING)
+    , mInteger(0)
+{
+    setValue(value);
+}
+
+OWLLiteral::OWLLiteral(const std::string& value, const Datatype* datatype)
+    : mDatatype(datatype)
+    , mValueType(STRING)
+    , mInteger(0)
+{
+    setValue(value);
+}
 
 OWLLiteral::OWLLiteral(const std::string& value)
+    : mValueType(STRING)
+    , mInteger(0)
 {
     size_t pos = value.find("^^");
     if(std::string::npos != pos)
     {
-        mValue = value.substr(0, pos);
-        mType = value.substr(pos+2);
+        mDatatype = getDatatype(value.substr(pos+2));
+        setValue(value.substr(0, pos));
     } else {
-        mValue = value;
-        mType = vocabulary::RDF::PlainLiteral().toString();
+        mDatatype = getDatatype(vocabulary::RDF::PlainLiteral().toString());
+        setValue(value);
     }
 }
 
+void OWLLiteral::setValue(const std::string& value)
+{
+    mValue = value;
+    parse();
+}
+
+void OWLLiteral::parse()
+{
+    mValueType = STRING;
+    try {
+        switch(mDatatype->valueType)
+        {
+            case BOOLEAN:
+                if(mValue == "true" || mValue == "1")
+                {
+                    mBoolean = true;
+                    mValueType = BOOLEAN;
+                } else if(mValue == "false" || mValue == "0")
+                {
+                    mBoolean = false;
+                    mValueType = BOOLEAN;
+                }
+                break;
+            case INTEGER:
+                mInteger = boost::lexical_cast<int64_t>(mValue);
+                mValueType = INTEGER;
+                break;
+            case DOUBLE:
+                mDouble = boost::lexical_cast<double>(mValue);
+                mValueType = DOUBLE;
+                break;
+            case STRING:
+                break;
+        }
+    } catch(const std::bad_cast& e)
+    {
+        // invalid lexical form: the value is only available as string
+    }
+}
+
+void OWLLiteral::setType(const std::string& type)
+{
+    mDatatype = getDatatype(type);
+    parse();
+}
+
 bool OWLLiteral::isTyped() const
 {
     return !isPlainLiteral();
@@ -38,7 +203,37 @@ bool OWLLiteral::isTyped() const
 
 bool OWLLiteral::hasType(const IRI& typeIRI) const
 {
-    return typeIRI.toString() == mType;
+    return typeIRI == mDatatype->iri;
+}
+
+bool OWLLiteral::isBoolean() const
+{
+    static const Datatype* boolean = getDatatype(vocabulary::XSD::boolean().toString());
+    return mDatatype == boolean;
+}
+
+bool OWLLiteral::isDouble() const
+{
+    static const Datatype* doubleType = getDatatype(vocabulary::XSD::resolve("double").toString());
+    return mDatatype == doubleType;
+}
+
+bool OWLLiteral::isFloat() const
+{
+    static const Datatype* floatType = getDatatype(vocabulary::XSD::resolve("float").toString());
+    return mDatatype == floatType;
+}
+
+bool OWLLiteral::isInteger() const
+{
+    static const Datatype* integer = getDatatype(vocabulary::XSD::integer().toString());
+    return mDatatype == integer;
+}
+
+bool OWLLiteral::isPlainLiteral() const
+{
+    static const Datatype* plainLiteral = getDatatype(vocabulary::RDF::PlainLiteral().toString());
+    return mDatatype == plainLiteral || mDatatype->iri.empty();
 }
 
 std::string OWLLiteral::toString() const
@@ -47,31 +242,44 @@ std::string OWLLiteral::toString() const
     {
         return mValue;
     } else {
-        return mValue + "^^" + mType;
+        return mValue + "^^" + getType();
     }
 }
 
 OWLLiteral::Ptr OWLLiteral::create(const std::string& literal)
 {
-    OWLLiteral testLiteral(literal);
-    IRI type = testLiteral.mType;
-    if(type == vocabulary::XSD::integer() || type == vocabulary::XSD::resolve("int"))
-    {
-        return OWLLiteral::Ptr(new OWLLiteralInteger(literal));
-    } else if(type == vocabulary::XSD::nonNegativeInteger())
-    {
-        return OWLLiteral::Ptr(new OWLLiteralNonNegativeInteger(literal));
-    } else if(type == vocabulary::XSD::resolve("double") )
+    size_t pos = literal.find("^^");
+    if(std::string::npos != pos)
     {
-        return OWLLiteral::Ptr(new OWLLiteralDouble(literal));
-    } else {
-        return OWLLiteral::Ptr(new OWLLiteral(literal));
+        return create(literal.substr(0, pos), getDatatype(literal.substr(pos+2)));
     }
+    return OWLLiteral::Ptr(new OWLLiteral(literal));
 }
 
 OWLLiteral::Ptr OWLLiteral::create(const std::string& literal, const OWLDataType& type)
 {
-    return create( literal + "^^" + type.getIRI().toString());
+    return create(literal, getDatatype(type.getIRI().toString()));
+}
+
+OWLLiteral::Ptr OWLLiteral::create(const std::string& value, const Datatype* datatype)
+{
+    static const Datatype* integer = getDatatype(vocabulary::XSD::integer().toString());
+    static const Datatype* intType = getDatatype(vocabulary::XSD::resolve("int").toString());
+    static const Datatype* nonNegativeInteger = getDatatype(vocabulary::XSD::nonNegativeInteger().toString());
+    static const Datatype* doubleType = getDatatype(vocabulary::XSD::resolve("double").toString());
+
+    if(datatype == integer || datatype == intType)
+    {
+        return OWLLiteral::Ptr(new OWLLiteralInteger(value, datatype));
+    } else if(datatype == nonNegativeInteger)
+    {
+        return OWLLiteral::Ptr(new OWLLiteralNonNegativeInteger(value, datatype));
+    } else if(datatype == doubleType)
+    {
+        return OWLLiteral::Ptr(new OWLLiteralDouble(value, datatype));
+    } else {
+        return OWLLiteral::Ptr(new OWLLiteral(value, datatype));
+    }
 }
 
 OWLLiteral::Ptr OWLLiteral::integer(int32_t value)
@@ -91,32 +299,59 @@ OWLLiteral::Ptr OWLLiteral::doubleValue(double value)
 
 unsigned int OWLLiteral::getNonNegativeInteger() const
 {
+    if(mValueType == INTEGER && mInteger >= 0 && mInteger <= std::numeric_limits<unsigned int>::max())
+    {
+        return static_cast<unsigned int>(mInteger);
+    }
+
     try {
         return boost::lexical_cast<unsigned int>(mValue);
     } catch(const std::bad_cast& e)
     {
-        throw std::runtime_error("OWLLiteral::getNonNegativeInteger not implemented for '" + mValue + "' and given type: '" + mType + "'");
+        throw std::runtime_error("OWLLiteral::getNonNegativeInteger not implemented for '" + mValue + "' and given type: '" + getType() + "'");
     }
 }
 
 int OWLLiteral::getInteger() const
 {
+    if(mValueType == INTEGER && mInteger >= std::numeric_limits<int>::min() && mInteger <= std::numeric_limits<int>::max())
+    {
+        return static_cast<int>(mInteger);
+    }
+
     try {
         return boost::lexical_cast<int>(mValue);
     } catch(const std::bad_cast& e)
     {
-        throw std::runtime_error("OWLLiteral::getInteger not implemented for '" + mValue + "' and given type: '" + mType + "'");
+        throw std::runtime_error("OWLLiteral::getInteger not implemented for '" + mValue + "' and given type: '" + getType() + "'");
     }
 }
 
 double OWLLiteral::getDouble() const
 {
+    if(mValueType == DOUBLE)
+    {
+        return mDouble;
+    } else if(mValueType == INTEGER)
+    {
+        return static_cast<double>(mInteger);
+    }
+
     try {
         return boost::lexical_cast<double>(mValue);
     } catch(const std::bad_cast& e)
     {
-        throw std::runtime_error("OWLLiteral::getDouble not implemented for '" + mValue + "' and given type: '" + mType + "'");
+        throw std::runtime_error("OWLLiteral::getDouble not implemented for '" + mValue + "' and given type: '" + getType() + "'");
+    }
+}
+
+bool OWLLiteral::getBoolean() const
+{
+    if(mValueType == BOOLEAN)
+    {
+        return mBoolean;
     }
+    throw std::runtime_error("OWLLiteral::getBoolean not implemented for '" + mValue + "' and given type: '" + getType() + "'");
 }
 
 IRIList OWLLiteral::toIRIList(const OWLLiteral::PtrList& literals)
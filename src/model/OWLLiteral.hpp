@@ -27,20 +27,66 @@ namespace model {
  */
 class OWLLiteral : public OWLPropertyAssertionObject, public OWLAnnotationValue
 {
+public:
+    typedef shared_ptr<OWLLiteral> Ptr;
+    typedef std::vector<Ptr> PtrList;
+
+    /// Representation of the value which is cached in parsed form
+    enum ValueType { STRING, BOOLEAN, INTEGER, DOUBLE };
+
+    /**
+     * Datatype of literals
+     * \details Datatypes are interned, i.e. there is exactly one instance per
+     * datatype IRI which remains valid for the lifetime of the process, so
+     * that literals refer to their datatype by pointer.
+     */
+    struct Datatype
+    {
+        IRI iri;
+        /// Representation of the values of this datatype
+        ValueType valueType;
+    };
+
+    /**
+     * Get the interned instance of a datatype
+     * \param type as full IRI string
+     */
+    static const Datatype* getDatatype(const std::string& type);
+
 protected:
+    /// Lexical form of the value
     std::string mValue;
-    std::string mType;
+    const Datatype* mDatatype;
+
+    /// Representation of the parsed value, STRING if the lexical form cannot
+    /// be parsed according to the datatype
+    ValueType mValueType;
+    union
+    {
+        bool mBoolean;
+        int64_t mInteger;
+        double mDouble;
+    };
 
     OWLLiteral();
 
     OWLLiteral(const std::string& value, const std::string& type);
 
+    OWLLiteral(const std::string& value, const Datatype* datatype);
+
     OWLLiteral(const std::string& value);
 
-public:
-    typedef shared_ptr<OWLLiteral> Ptr;
-    typedef std::vector<Ptr> PtrList;
+    /**
+     * Set the lexical form of the value and update the parsed value
+     */
+    void setValue(const std::string& value);
 
+    /**
+     * Parse the lexical form of the value according to the datatype
+     */
+    void parse();
+
+public:
     virtual ~OWLLiteral() {}
 
     /**
@@ -55,12 +101,22 @@ public:
       * Set the type for the literal
       * \param type as full IRI string, e.g., http://www.w3.org/2001/XMLSchema#nonNegativeInteger
       */
-    void setType(const std::string& type) { mType = type; }
+    void setType(const std::string& type);
 
-    std::string getType() const { return mType; }
+    std::string getType() const { return mDatatype->iri.toString(); }
+
+    /**
+     * Get the IRI of the datatype of this literal
+     */
+    const IRI& getDatatypeIRI() const { return mDatatype->iri; }
 
     std::string getValue() const { return mValue; }
 
+    /**
+     * Get the representation of the parsed value
+     */
+    ValueType getValueType() const { return mValueType; }
+
     OWLObject::Type getObjectType() const { return OWLObject::Literal; }
 
     // http://owlapi.sourceforge.net/javadoc/index.html?org/semanticweb/owlapi/model/OWLClassExpression.html
@@ -69,11 +125,11 @@ public:
     //
     std::string toString() const;
 
-    bool isBoolean() const { return mType == vocabulary::XSD::boolean().toString(); }
-    bool isDouble() const { return mType == vocabulary::XSD::resolve("double").toString(); }
-    bool isFloat() const { return mType == vocabulary::XSD::resolve("float").toString(); }
-    bool isInteger() const { return mType == vocabulary::XSD::integer().toString(); }
-    bool isPlainLiteral() const { return mType == vocabulary::RDF::PlainLiteral().toString() || mType.empty(); }
+    bool isBoolean() const;
+    bool isDouble() const;
+    bool isFloat() const;
+    bool isInteger() const;
+    bool isPlainLiteral() const;
 
     /**
      * Create a literal based on the given type information
@@ -87,6 +143,12 @@ public:
      */
     static OWLLiteral::Ptr create(const std::string& literal, const OWLDataType& type);
 
+    /**
+     * Create a literal from its lexical form and an interned datatype
+     * \return point to an inbuilt literal type
+     */
+    static OWLLiteral::Ptr create(const std::string& value, const Datatype* datatype);
+
     static OWLLiteral::Ptr integer(int32_t value);
     /**
      * Create a literal typed to non negative integer and given value
@@ -101,6 +163,12 @@ public:
 
     virtual double getDouble() const;
 
+    /**
+     * Get the value of a boolean literal
+     * \throw std::runtime_error if the value is not a boolean
+     */
+    virtual bool getBoolean() const;
+
     static IRIList toIRIList(const OWLLiteral::PtrList& literals);
 
     OWLLiteral::Ptr asLiteral() const override;
@@ -12,14 +12,21 @@ OWLLiteralDouble::OWLLiteralDouble(double value)
 {
     std::stringstream ss;
     ss << value;
-    mValue = ss.str();
+    setValue(ss.str());
 }
 
 OWLLiteralDouble::OWLLiteralDouble(const std::string& value)
     : OWLLiteral(value)
     , OWLLiteralNumeric<double>(0.0)
 {
-    mNumericValue = fromString(mValue);
+    mNumericValue = getDouble();
+}
+
+OWLLiteralDouble::OWLLiteralDouble(const std::string& value, const Datatype* datatype)
+    : OWLLiteral(value, datatype)
+    , OWLLiteralNumeric<double>(0.0)
+{
+    mNumericValue = getDouble();
 }
 
 } // end namespace model
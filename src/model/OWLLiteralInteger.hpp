@@ -17,14 +17,21 @@ public:
     {
         std::stringstream ss;
         ss << value;
-        mValue = ss.str();
+        setValue(ss.str());
     }
 
     OWLLiteralInteger(const std::string& value)
         : OWLLiteral(value)
         , OWLLiteralNumeric<int>(0)
     {
-        mNumericValue = fromString(mValue);
+        mNumericValue = getInteger();
+    }
+
+    OWLLiteralInteger(const std::string& value, const Datatype* datatype)
+        : OWLLiteral(value, datatype)
+        , OWLLiteralNumeric<int>(0)
+    {
+        mNumericValue = getInteger();
     }
 
     virtual ~OWLLiteralInteger() {}
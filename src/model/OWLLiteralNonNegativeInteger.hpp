@@ -17,14 +17,21 @@ public:
     {
         std::stringstream ss;
         ss << value;
-        mValue = ss.str();
+        setValue(ss.str());
     }
 
     OWLLiteralNonNegativeInteger(const std::string& value)
         : OWLLiteral(value)
         , OWLLiteralNumeric<uint32_t>(0)
     {
-        mNumericValue = fromString(mValue);
+        mNumericValue = getNonNegativeInteger();
+    }
+
+    OWLLiteralNonNegativeInteger(const std::string& value, const Datatype* datatype)
+        : OWLLiteral(value, datatype)
+        , OWLLiteralNumeric<uint32_t>(0)
+    {
+        mNumericValue = getNonNegativeInteger();
     }
 
     virtual ~OWLLiteralNonNegativeInteger() {}
@@ -6,7 +6,7 @@
 namespace owlapi {
 namespace model {
 
-class OWLObjectComplementOf : OWLBooleanClassExpression
+class OWLObjectComplementOf : public OWLBooleanClassExpression
 {
 public:
     typedef shared_ptr<OWLObjectComplementOf> Ptr;
@@ -18,6 +18,8 @@ public:
 
     virtual ~OWLObjectComplementOf() = default;
 
+    virtual ClassExpressionType getClassExpressionType() const override { return OWLClassExpression::OBJECT_COMPLEMENT_OF; };
+
     const OWLClassExpression::Ptr& getOperand() const { return mOperand; }
 
 private:
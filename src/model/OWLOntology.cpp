@@ -4,12 +4,105 @@
 #include "OWLOntologyChange.hpp"
 #include "OWLOntologyChangeFilter.hpp"
 #include "OWLAnnotationAssertionAxiom.hpp"
+#include "OWLEquivalentClassesAxiom.hpp"
+#include "OWLNaryBooleanExpression.hpp"
+#include "OWLQuantifiedObjectRestriction.hpp"
+#include "OWLPropertyAssertionAxiom.hpp"
 
 namespace owlapi {
 namespace model {
 
+namespace {
+/**
+ * Check whether a class expression refers to individuals
+ */
+bool refersToIndividuals(const OWLClassExpression::Ptr& ce)
+{
+    if(!ce)
+    {
+        return false;
+    }
+
+    switch(ce->getClassExpressionType())
+    {
+        case OWLClassExpression::OBJECT_ONE_OF:
+        case OWLClassExpression::OBJECT_HAS_VALUE:
+            return true;
+        case OWLClassExpression::OWL_CLASS:
+            return false;
+        default:
+            break;
+    }
+
+    shared_ptr<OWLNaryBooleanExpression> booleanExpression = dynamic_pointer_cast<OWLNaryBooleanExpression>(ce);
+    if(booleanExpression)
+    {
+        for(const OWLClassExpression::Ptr& operand : booleanExpression->getOperands())
+        {
+            if(refersToIndividuals(operand))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    OWLQuantifiedObjectRestriction::Ptr restriction = dynamic_pointer_cast<OWLQuantifiedObjectRestriction>(ce);
+    if(restriction)
+    {
+        return refersToIndividuals(restriction->getFiller());
+    }
+    return false;
+}
+
+/**
+ * Get the IRIs of individual and data property of a data property assertion
+ * \return false if the property is not a named data property
+ */
+bool getAssertionKey(const OWLDataPropertyAssertionAxiom& axiom, IRI& subject, IRI& property)
+{
+    OWLDataProperty::Ptr dataProperty = dynamic_pointer_cast<OWLDataProperty>(axiom.getProperty());
+    if(!dataProperty || !axiom.getSubject())
+    {
+        return false;
+    }
+    subject = axiom.getSubject()->getReferenceID();
+    property = dataProperty->getIRI();
+    return true;
+}
+
+/**
+ * Get the IRIs of subject and property of an annotation assertion
+ * \return false if the subject is neither an IRI nor an anonymous individual
+ */
+bool getAssertionKey(const OWLAnnotationAssertionAxiom& axiom, IRI& subject, IRI& property)
+{
+    OWLAnnotationSubject::Ptr annotationSubject = axiom.getSubject();
+    if(!annotationSubject || !axiom.getProperty())
+    {
+        return false;
+    }
+    switch(annotationSubject->getObjectType())
+    {
+        case OWLObject::IRIType:
+            subject = *dynamic_pointer_cast<IRI>(annotationSubject);
+            break;
+        case OWLObject::AnonymousIndividual:
+            subject = dynamic_pointer_cast<OWLAnonymousIndividual>(annotationSubject)->getReferenceID();
+            break;
+        default:
+            return false;
+    }
+    property = axiom.getProperty()->getIRI();
+    return true;
+}
+}
+
 OWLOntology::OWLOntology(const KnowledgeBase::Ptr& kb)
-    : mpKnowledgeBase(kb)
+    : mHasDefinedClasses(false)
+    , mHasNominals(false)
+    , mpKnowledgeBase(kb)
+    , mObjectArena(make_shared<ObjectArena>())
 {
     if(!mpKnowledgeBase)
     {
@@ -40,106 +133,251 @@ void OWLOntology::cleanup()
     }
 }
 
-OWLClass::Ptr OWLOntology::getClass(const IRI& iri) const
+OWLClass::Ptr OWLOntology::findClass(const IRI& iri) const
 {
     std::map<IRI, OWLClass::Ptr>::const_iterator cit = mClasses.find(iri);
     if(cit != mClasses.end())
     {
         return cit->second;
     }
-    throw std::invalid_argument("owlapi::model::OWLOntology::getClass: "
-            " no class '" + iri.toString() + "' known");
+    return OWLClass::Ptr();
 }
 
-OWLAnonymousClassExpression::Ptr OWLOntology::getAnonymousClassExpression(const IRI& iri) const
+OWLAnonymousClassExpression::Ptr OWLOntology::findAnonymousClassExpression(const IRI& iri) const
 {
     std::map<IRI, OWLAnonymousClassExpression::Ptr>::const_iterator cit = mAnonymousClassExpressions.find(iri);
     if(cit != mAnonymousClassExpressions.end())
     {
         return cit->second;
     }
-    throw std::invalid_argument("owlapi::model::OWLOntology::getAnonymousClassExpression: "
-            " no class '" + iri.toString() + "' known");
+    return OWLAnonymousClassExpression::Ptr();
 }
 
-OWLDataProperty::Ptr OWLOntology::getDataProperty(const IRI& iri) const
+OWLDataProperty::Ptr OWLOntology::findDataProperty(const IRI& iri) const
 {
     std::map<IRI, OWLDataProperty::Ptr>::const_iterator cit = mDataProperties.find(iri);
     if(cit != mDataProperties.end())
     {
         return cit->second;
     }
-    throw std::invalid_argument("owlapi::model::OWLOntology::getDataProperty: "
-            " no data property '" + iri.toString() + "' known");
+    return OWLDataProperty::Ptr();
 }
 
-const IRI& OWLOntology::iriOfDataProperty(const OWLDataProperty::Ptr& property) const
-{
-    for(const auto& p : mDataProperties)
-    {
-        if(property == p.second)
-        {
-            return p.first;
-        }
-    }
-    throw std::invalid_argument("owlapi::model::OWLOntology::iriOfDataProperty: not matching"
-            " IRI found for dataproperty");
-}
-
-OWLObjectProperty::Ptr OWLOntology::getObjectProperty(const IRI& iri) const
+OWLObjectProperty::Ptr OWLOntology::findObjectProperty(const IRI& iri) const
 {
     std::map<IRI, OWLObjectProperty::Ptr>::const_iterator cit = mObjectProperties.find(iri);
     if(cit != mObjectProperties.end())
     {
         return cit->second;
     }
-    throw std::invalid_argument("owlapi::model::OWLOntology::getObjectProperty: "
-            " no object property '" + iri.toString() + "' known");
+    return OWLObjectProperty::Ptr();
 }
 
-OWLAnnotationProperty::Ptr OWLOntology::getAnnotationProperty(const IRI& iri) const
+OWLAnnotationProperty::Ptr OWLOntology::findAnnotationProperty(const IRI& iri) const
 {
     std::map<IRI, OWLAnnotationProperty::Ptr>::const_iterator cit = mAnnotationProperties.find(iri);
     if(cit != mAnnotationProperties.end())
     {
         return cit->second;
     }
-    throw std::invalid_argument("owlapi::model::OWLOntology::getAnnotationProperty: "
-            " no annotation property '" + iri.toString() + "' known");
+    return OWLAnnotationProperty::Ptr();
 }
 
-OWLIndividual::Ptr OWLOntology::getIndividual(const IRI& iri) const
-{
+OWLNamedIndividual::Ptr OWLOntology::findNamedIndividual(const IRI& iri) const
 {
     std::map<IRI, OWLNamedIndividual::Ptr>::const_iterator cit = mNamedIndividuals.find(iri);
     if(cit != mNamedIndividuals.end())
     {
         return cit->second;
     }
+    return OWLNamedIndividual::Ptr();
 }
+
+OWLAnonymousIndividual::Ptr OWLOntology::findAnonymousIndividual(const IRI& iri) const
 {
     std::map<IRI, OWLAnonymousIndividual::Ptr>::const_iterator cit = mAnonymousIndividuals.find(iri);
     if(cit != mAnonymousIndividuals.end())
     {
         return cit->second;
     }
+    return OWLAnonymousIndividual::Ptr();
+}
+
+OWLIndividual::Ptr OWLOntology::findIndividual(const IRI& iri) const
+{
+    OWLNamedIndividual::Ptr namedIndividual = findNamedIndividual(iri);
+    if(namedIndividual)
+    {
+        return namedIndividual;
+    }
+    return findAnonymousIndividual(iri);
+}
+
+OWLClass::Ptr OWLOntology::getClass(const IRI& iri) const
+{
+    OWLClass::Ptr entity = findClass(iri);
+    if(!entity)
+    {
+        throw std::invalid_argument("owlapi::model::OWLOntology::getClass: "
+                " no class '" + iri.toString() + "' known");
+    }
+    return entity;
+}
+
+OWLAnonymousClassExpression::Ptr OWLOntology::getAnonymousClassExpression(const IRI& iri) const
+{
+    OWLAnonymousClassExpression::Ptr entity = findAnonymousClassExpression(iri);
+    if(!entity)
+    {
+        throw std::invalid_argument("owlapi::model::OWLOntology::getAnonymousClassExpression: "
+                " no class '" + iri.toString() + "' known");
+    }
+    return entity;
+}
+
+OWLDataProperty::Ptr OWLOntology::getDataProperty(const IRI& iri) const
+{
+    OWLDataProperty::Ptr entity = findDataProperty(iri);
+    if(!entity)
+    {
+        throw std::invalid_argument("owlapi::model::OWLOntology::getDataProperty: "
+                " no data property '" + iri.toString() + "' known");
+    }
+    return entity;
+}
+
+OWLAnonymousClassExpression::Ptr OWLOntology::setAnonymousClassExpression(const IRI& iri, const OWLAnonymousClassExpression::Ptr& anonymousExpression)
+{
+    OWLAnonymousClassExpression::Ptr expression = mClassExpressionPool.intern(anonymousExpression);
+
+    std::map<IRI, OWLAnonymousClassExpression::Ptr>::iterator it = mAnonymousClassExpressions.find(iri);
+    if(it != mAnonymousClassExpressions.end())
+    {
+        if(it->second == expression)
+        {
+            return expression;
+        }
+        std::unordered_map<OWLAnonymousClassExpression::Ptr, IRI>::iterator rit = mAnonymousClassExpressionIRIs.find(it->second);
+        if(rit != mAnonymousClassExpressionIRIs.end() && rit->second == iri)
+        {
+            mAnonymousClassExpressionIRIs.erase(rit);
+        }
+        it->second = expression;
+    } else {
+        mAnonymousClassExpressions[iri] = expression;
+    }
+
+    if(expression)
+    {
+        // keep the first iri an expression has been registered with
+        mAnonymousClassExpressionIRIs.insert(std::make_pair(expression, iri));
+    }
+    return expression;
+}
+
+const IRI* OWLOntology::findIRIOfAnonymousClassExpression(const OWLAnonymousClassExpression::Ptr& expression) const
+{
+    std::unordered_map<OWLAnonymousClassExpression::Ptr, IRI>::const_iterator cit = mAnonymousClassExpressionIRIs.find(expression);
+    if(cit != mAnonymousClassExpressionIRIs.end())
+    {
+        return &cit->second;
+    }
+
+    // a structurally equal copy, e.g. a clone, of a registered expression;
+    // canonical instances are their own representative, so the structural
+    // key is only computed for copies
+    if(!expression || mClassExpressionPool.isCanonical(expression.get()))
+    {
+        return NULL;
+    }
+    OWLClassExpression::Ptr canonical = mClassExpressionPool.find(expression);
+    if(canonical)
+    {
+        cit = mAnonymousClassExpressionIRIs.find(dynamic_pointer_cast<OWLAnonymousClassExpression>(canonical));
+        if(cit != mAnonymousClassExpressionIRIs.end())
+        {
+            return &cit->second;
+        }
+    }
+    return NULL;
+}
+
+const IRI& OWLOntology::iriOfAnonymousClassExpression(const OWLAnonymousClassExpression::Ptr& expression) const
+{
+    const IRI* iri = findIRIOfAnonymousClassExpression(expression);
+    if(!iri)
+    {
+        throw std::invalid_argument("owlapi::model::OWLOntology::iriOfAnonymousClassExpression: no"
+                " IRI found for anonymous class expression");
+    }
+    return *iri;
+}
+
+const IRI& OWLOntology::iriOfDataProperty(const OWLDataProperty::Ptr& property) const
+{
+    // properties are registered under their own iri
+    std::map<IRI, OWLDataProperty::Ptr>::const_iterator cit = mDataProperties.find(property->getIRI());
+    if(cit != mDataProperties.end() && cit->second == property)
+    {
+        return cit->first;
+    }
+    throw std::invalid_argument("owlapi::model::OWLOntology::iriOfDataProperty: not matching"
+            " IRI found for dataproperty");
+}
+
+OWLObjectProperty::Ptr OWLOntology::getObjectProperty(const IRI& iri) const
+{
+    OWLObjectProperty::Ptr entity = findObjectProperty(iri);
+    if(!entity)
+    {
+        throw std::invalid_argument("owlapi::model::OWLOntology::getObjectProperty: "
+                " no object property '" + iri.toString() + "' known");
+    }
+    return entity;
 }
-throw std::invalid_argument("owlapi::model::OWLOntology::getIndividual: no individual '" + iri.toString() + "' known");
+
+OWLAnnotationProperty::Ptr OWLOntology::getAnnotationProperty(const IRI& iri) const
+{
+    OWLAnnotationProperty::Ptr entity = findAnnotationProperty(iri);
+    if(!entity)
+    {
+        throw std::invalid_argument("owlapi::model::OWLOntology::getAnnotationProperty: "
+                " no annotation property '" + iri.toString() + "' known");
+    }
+    return entity;
+}
+
+OWLIndividual::Ptr OWLOntology::getIndividual(const IRI& iri) const
+{
+    OWLIndividual::Ptr entity = findIndividual(iri);
+    if(!entity)
+    {
+        throw std::invalid_argument("owlapi::model::OWLOntology::getIndividual: "
+                " no individual '" + iri.toString() + "' known");
+    }
+    return entity;
 }
 
 OWLAnonymousIndividual::Ptr OWLOntology::getAnonymousIndividual(const IRI& iri) const
 {
-    std::map<IRI, OWLAnonymousIndividual::Ptr>::const_iterator cit = mAnonymousIndividuals.find(iri);
-    if(cit != mAnonymousIndividuals.end())
+    OWLAnonymousIndividual::Ptr entity = findAnonymousIndividual(iri);
+    if(!entity)
     {
-        return cit->second;
+        throw std::invalid_argument("owlapi::model::OWLOntology::getAnonymousIndividual: "
+                " no anonymous individual '" + iri.toString() + "' known");
     }
-    throw std::invalid_argument("owlapi::model::OWLOntology::getAnonymousIndividual: no anonymous individual '" + iri.toString() + "' known");
+    return entity;
 }
 
-void OWLOntology::addAxiom(const OWLAxiom::Ptr& axiom)
+OWLAxiom::Ptr OWLOntology::addAxiom(const OWLAxiom::Ptr& axiom)
 {
-    OWLAxiom::PtrList& axioms = mAxiomsByType[axiom->getAxiomType()];
+    size_t structuralHash = axiom->getStructuralHash();
+    OWLAxiom::Ptr containedAxiom = mAxiomsByType[axiom->getAxiomType()].insert(axiom, structuralHash);
+    if(containedAxiom != axiom)
+    {
+        LOG_DEBUG_S << "Axiom: '" << axiom->toString() << "' has already been added to ontology loaded from '" << getAbsolutePath() << "'";
+        return containedAxiom;
+    }
 
     switch(axiom->getAxiomType())
     {
@@ -148,18 +386,70 @@ void OWLOntology::addAxiom(const OWLAxiom::Ptr& axiom)
                 OWLAnnotationAssertionAxiom::Ptr annotationAxiom =
                     dynamic_pointer_cast<OWLAnnotationAssertionAxiom>(axiom);
                 mAnnotationAxioms[annotationAxiom->getProperty()].push_back(annotationAxiom);
+                IRI subject, property;
+                if(getAssertionKey(*annotationAxiom, subject, property))
+                {
+                    mAnnotationAssertions.add(subject, property, annotationAxiom);
+                }
+            }
+            break;
+        case OWLAxiom::EquivalentClasses:
+            {
+                OWLEquivalentClassesAxiom::Ptr equivalentClassesAxiom =
+                    dynamic_pointer_cast<OWLEquivalentClassesAxiom>(axiom);
+                for(const OWLClassExpression::Ptr& ce : equivalentClassesAxiom->getEquivalentClasses())
+                {
+                    mEquivalentClassesAxioms[ce].insert(equivalentClassesAxiom);
+                }
+            }
+            break;
+        case OWLAxiom::DataPropertyAssertion:
+            {
+                OWLDataPropertyAssertionAxiom::Ptr assertion = dynamic_pointer_cast<OWLDataPropertyAssertionAxiom>(axiom);
+                IRI subject, property;
+                if(getAssertionKey(*assertion, subject, property))
+                {
+                    mDataPropertyAssertions.add(subject, property, assertion);
+                }
             }
             break;
         default:
             break;
+    }
 
+    addReferences(axiom, structuralHash);
+    invalidateQueryCache(*axiom);
+    return axiom;
+}
+
+OWLAxiom::Ptr OWLOntology::findAxiom(const OWLAxiom& axiom) const
+{
+    AxiomMap::const_iterator cit = mAxiomsByType.find(axiom.getAxiomType());
+    if(cit == mAxiomsByType.end())
+    {
+        return OWLAxiom::Ptr();
     }
+    return cit->second.find(axiom);
+}
 
-    if( axioms.end() == std::find(axioms.begin(), axioms.end(), axiom) )
+void OWLOntology::removeAnnotationAssertion(const OWLAnnotationAssertionAxiom::Ptr& axiom)
+{
+    auto it = mAnnotationAxioms.find(axiom->getProperty());
+    if(it != mAnnotationAxioms.end())
     {
-        axioms.push_back(axiom);
-    } else {
-        LOG_WARN_S << "Axiom: '" << axiom->toString() << "' has already been added to ontology loaded from '" << getAbsolutePath() << "'";
+        std::vector<OWLAxiom::Ptr>& annotationAxioms = it->second;
+        annotationAxioms.erase(std::remove(annotationAxioms.begin(), annotationAxioms.end(), axiom),
+                annotationAxioms.end());
+        if(annotationAxioms.empty())
+        {
+            mAnnotationAxioms.erase(it);
+        }
+    }
+
+    IRI subject, property;
+    if(getAssertionKey(*axiom, subject, property))
+    {
+        mAnnotationAssertions.remove(subject, property, axiom);
     }
 }
 
@@ -174,7 +464,7 @@ OWLAxiom::PtrList OWLOntology::getAxioms() const
     AxiomMap::const_iterator cit = mAxiomsByType.begin();
     for(; cit != mAxiomsByType.end(); ++cit)
     {
-        const OWLAxiom::PtrList& typedAxioms = cit->second;
+        const AxiomIndex<>& typedAxioms = cit->second;
         axioms.insert(axioms.begin(), typedAxioms.begin(), typedAxioms.end());
     }
     return axioms;
@@ -182,16 +472,57 @@ OWLAxiom::PtrList OWLOntology::getAxioms() const
 
 void OWLOntology::removeAxiom(const OWLAxiom::Ptr& axiom)
 {
+    AxiomIndex<>& axioms = mAxiomsByType[axiom->getAxiomType()];
+    // the contained axiom might be a structurally equal instance
+    OWLAxiom::Ptr containedAxiom = axioms.find(*axiom);
+    if(!containedAxiom)
+    {
+        return;
+    }
+
     // remove axiom from reverse map
-    OWLAxiom::PtrList& axioms = mAxiomsByType[axiom->getAxiomType()];
     OWLAxiomRetractVisitor visitor(this);
-    OWLAxiom::PtrList::iterator ait = std::find(axioms.begin(), axioms.end(), axiom);
-    if(ait != axioms.end())
+    LOG_INFO_S << "Removing axiom: " << containedAxiom->toString();
+    invalidateQueryCache(*containedAxiom);
+    containedAxiom->accept(&visitor);
+    switch(containedAxiom->getAxiomType())
     {
-        LOG_INFO_S << "Removing axiom: " << (*ait)->toString();
-        (*ait)->accept(&visitor);
+        case OWLAxiom::DataPropertyAssertion:
+            {
+                OWLDataPropertyAssertionAxiom::Ptr assertion = dynamic_pointer_cast<OWLDataPropertyAssertionAxiom>(containedAxiom);
+                IRI subject, property;
+                if(getAssertionKey(*assertion, subject, property))
+                {
+                    mDataPropertyAssertions.remove(subject, property, assertion);
+                }
+            }
+            break;
+        case OWLAxiom::AnnotationAssertion:
+            removeAnnotationAssertion(dynamic_pointer_cast<OWLAnnotationAssertionAxiom>(containedAxiom));
+            break;
+        case OWLAxiom::EquivalentClasses:
+            {
+                OWLEquivalentClassesAxiom::Ptr equivalentClassesAxiom =
+                    dynamic_pointer_cast<OWLEquivalentClassesAxiom>(containedAxiom);
+                for(const OWLClassExpression::Ptr& ce : equivalentClassesAxiom->getEquivalentClasses())
+                {
+                    auto it = mEquivalentClassesAxioms.find(ce);
+                    if(it != mEquivalentClassesAxioms.end())
+                    {
+                        it->second.erase(*equivalentClassesAxiom);
+                        if(it->second.empty())
+                        {
+                            mEquivalentClassesAxioms.erase(it);
+                        }
+                    }
+                }
+            }
+            break;
+        default:
+            break;
     }
-    axioms.erase(ait);
+    removeReferences(*containedAxiom);
+    axioms.erase(*containedAxiom);
 }
 
 void OWLOntology::retractValueOf(const OWLIndividual::Ptr& individual, const OWLDataProperty::Ptr& property)
@@ -203,18 +534,19 @@ void OWLOntology::retractValueOf(const OWLIndividual::Ptr& individual, const OWL
         individualName = namedIndividual->getIRI().toString();
     }
 
-    std::vector<OWLAxiom::Ptr>& axioms = mAxiomsByType[OWLAxiom::DataPropertyAssertion];
-    std::vector<OWLAxiom::Ptr>::iterator it = axioms.begin();
-    for(; it != axioms.end(); ++it)
+    const PropertyValueIndex<OWLDataPropertyAssertionAxiom::Ptr>::ValueList* assertions =
+        mDataPropertyAssertions.find(individual->getReferenceID(), property->getIRI());
+    if(assertions)
     {
-        OWLDataPropertyAssertionAxiom::Ptr axiom = dynamic_pointer_cast<OWLDataPropertyAssertionAxiom>(*it);
-        if(axiom->getSubject() == individual && axiom->getProperty() == property)
-        {
-            LOG_DEBUG_S << "Retracted DataPropertyAssertionAxiom: s: '" << individualName << "'"
-                    << ", p: " << property->getIRI().toString() << "'";
-            axioms.erase(it);
-            return;
-        }
+        OWLDataPropertyAssertionAxiom::Ptr axiom = assertions->front();
+        LOG_DEBUG_S << "Retracted DataPropertyAssertionAxiom: s: '" << individualName << "'"
+                << ", p: " << property->getIRI().toString() << "'";
+        invalidateQueryCache(*axiom);
+        mDataPropertyAssertions.remove(individual->getReferenceID(), property->getIRI(), axiom);
+        removeReferences(*axiom);
+
+        mAxiomsByType[OWLAxiom::DataPropertyAssertion].erase(*axiom);
+        return;
     }
     LOG_DEBUG_S << "No value to be retracted";
 }
@@ -222,14 +554,120 @@ void OWLOntology::retractValueOf(const OWLIndividual::Ptr& individual, const OWL
 void OWLOntology::retractIndividual(const IRI& iri)
 {
     OWLIndividual::Ptr individual = getIndividual(iri);
-    std::vector<OWLClassAssertionAxiom::Ptr>& axioms = mClassAssertionAxiomsByIndividual[individual];
-    for(OWLClassAssertionAxiom::Ptr& axiom : axioms)
+    // Copy, since retracting the axioms modifies the index
+    const AxiomIndex<OWLClassAssertionAxiom>& index = mClassAssertionAxiomsByIndividual[individual];
+    std::vector<OWLClassAssertionAxiom::Ptr> axioms(index.begin(), index.end());
+    for(const OWLClassAssertionAxiom::Ptr& axiom : axioms)
     {
         OWLAxiomRetractVisitor v(this);
         axiom->accept(&v);
     }
 }
 
+void OWLOntology::invalidateQueryCache(const OWLAxiom& axiom)
+{
+    switch(axiom.getAxiomType())
+    {
+        case OWLAxiom::Declaration:
+        {
+            // A new property applies to its default domain owl:Thing
+            const OWLDeclarationAxiom& declaration = dynamic_cast<const OWLDeclarationAxiom&>(axiom);
+            if(declaration.getEntity()->getEntityType() != OWLEntity::NAMED_INDIVIDUAL)
+            {
+                mPropertyDomainIndex.reset();
+            }
+            break;
+        }
+        case OWLAxiom::SubAnnotationPropertyOf:
+        case OWLAxiom::AnnotationPropertyDomain:
+        case OWLAxiom::AnnotationPropertyRange:
+        case OWLAxiom::AnnotationAssertion:
+            // Not relevant for reasoning
+            break;
+        case OWLAxiom::ClassAssertion:
+        case OWLAxiom::ObjectPropertyAssertion:
+        case OWLAxiom::DataPropertyAssertion:
+        {
+            if(mHasNominals)
+            {
+                mQueryCache.clear();
+                mPropertyDomainIndex.reset();
+                break;
+            }
+
+            // Assertions do not change the class hierarchy or the
+            // restrictions of classes, but individuals might be punned
+            // classes
+            IRIList individuals;
+            const OWLClassAssertionAxiom* classAssertion = dynamic_cast<const OWLClassAssertionAxiom*>(&axiom);
+            if(classAssertion)
+            {
+                individuals.push_back(classAssertion->getIndividual()->getReferenceID());
+            }
+            const OWLPropertyAssertionAxiom* propertyAssertion = dynamic_cast<const OWLPropertyAssertionAxiom*>(&axiom);
+            if(propertyAssertion)
+            {
+                individuals.push_back(propertyAssertion->getSubject()->getReferenceID());
+            }
+            mQueryCache.invalidate(individuals);
+            break;
+        }
+        case OWLAxiom::SubClassOf:
+        {
+            const OWLSubClassOfAxiom& subClassOfAxiom = dynamic_cast<const OWLSubClassOfAxiom&>(axiom);
+            OWLClassExpression::PtrList expressions = { subClassOfAxiom.getSubClass(), subClassOfAxiom.getSuperClass() };
+            invalidateQueryCache(expressions, subClassOfAxiom.getSubClass()->getClassExpressionType() != OWLClassExpression::OWL_CLASS);
+            break;
+        }
+        case OWLAxiom::EquivalentClasses:
+        {
+            const OWLEquivalentClassesAxiom& equivalentClassesAxiom = dynamic_cast<const OWLEquivalentClassesAxiom&>(axiom);
+            const OWLClassExpression::PtrList& expressions = equivalentClassesAxiom.getEquivalentClasses();
+            bool defining = false;
+            for(const OWLClassExpression::Ptr& ce : expressions)
+            {
+                defining = defining || ce->getClassExpressionType() != OWLClassExpression::OWL_CLASS;
+            }
+            invalidateQueryCache(expressions, defining);
+            break;
+        }
+        default:
+            // Property axioms and disjointness can change the class
+            // hierarchy in a non-local way
+            mQueryCache.clear();
+            mPropertyDomainIndex.reset();
+            break;
+    }
+}
+
+void OWLOntology::invalidateQueryCache(const OWLClassExpression::PtrList& expressions, bool defining)
+{
+    IRIList klasses;
+    for(const OWLClassExpression::Ptr& ce : expressions)
+    {
+        OWLClass::Ptr klass = dynamic_pointer_cast<OWLClass>(ce);
+        if(klass)
+        {
+            klasses.push_back(klass->getIRI());
+        }
+        mHasNominals = mHasNominals || refersToIndividuals(ce);
+    }
+    mHasDefinedClasses = mHasDefinedClasses || defining;
+    mPropertyDomainIndex.reset();
+
+    if(mHasDefinedClasses)
+    {
+        // Any change might affect the subsumption of defined classes
+        mQueryCache.clear();
+    } else {
+        // Cached restrictions depend on the queried class, its ancestors and
+        // the qualifying classes, so that invalidating the directly
+        // affected classes suffices
+        mQueryCache.invalidate(klasses);
+        mQueryCache.invalidateSubClassRelations();
+    }
+}
+
 void OWLOntology::addDirectImportsDocument(const IRI& iri)
 {
     if( mDirectImportsDocuments.end() == std::find(mDirectImportsDocuments.begin(), mDirectImportsDocuments.end(), iri) )
@@ -247,10 +685,63 @@ void OWLOntology::addImportsDocument(const IRI& iri)
     }
 }
 
+void OWLOntology::addReferences(const OWLAxiom::Ptr& axiom, size_t structuralHash)
+{
+    for(const OWLEntity::Ptr& entity : axiom->getSignature())
+    {
+        mReferencingAxioms[entity->getEntityType()][entity->getIRI()].insert(axiom, structuralHash);
+    }
+}
+
+void OWLOntology::removeReferences(const OWLAxiom& axiom)
+{
+    size_t structuralHash = axiom.getStructuralHash();
+    for(const OWLEntity::Ptr& entity : axiom.getSignature())
+    {
+        std::map<OWLEntity::EntityType, std::unordered_map<IRI, AxiomIndex<> > >::iterator tit =
+            mReferencingAxioms.find(entity->getEntityType());
+        if(tit == mReferencingAxioms.end())
+        {
+            continue;
+        }
+        std::unordered_map<IRI, AxiomIndex<> >::iterator it = tit->second.find(entity->getIRI());
+        if(it == tit->second.end())
+        {
+            continue;
+        }
+        it->second.erase(axiom, structuralHash);
+        if(it->second.empty())
+        {
+            tit->second.erase(it);
+        }
+    }
+}
+
 OWLAxiom::PtrList OWLOntology::getReferencingAxioms(const OWLEntity::Ptr& entity, bool excludeImports)
 {
     OWLAxiom::PtrList axioms;
 
+    std::map<OWLEntity::EntityType, std::unordered_map<IRI, AxiomIndex<> > >::const_iterator tit =
+        mReferencingAxioms.find(entity->getEntityType());
+    if(tit == mReferencingAxioms.end())
+    {
+        return axioms;
+    }
+    std::unordered_map<IRI, AxiomIndex<> >::const_iterator cit = tit->second.find(entity->getIRI());
+    if(cit == tit->second.end())
+    {
+        return axioms;
+    }
+
+    for(const OWLAxiom::Ptr& axiom : cit->second)
+    {
+        if(excludeImports && mImportsDocuments.end() != std::find(mImportsDocuments.begin(),
+                    mImportsDocuments.end(), axiom->getOrigin()))
+        {
+            continue;
+        }
+        axioms.push_back(axiom);
+    }
     return axioms;
 }
 
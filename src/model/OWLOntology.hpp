@@ -2,6 +2,7 @@
 #define OWLAPI_MODEL_OWL_ONTOLOGY_HPP
 
 #include <map>
+#include <unordered_map>
 #include <algorithm>
 #include "OWLClass.hpp"
 #include "OWLNamedIndividual.hpp"
@@ -12,11 +13,19 @@
 #include "OWLDataType.hpp"
 #include "OWLAxiom.hpp"
 #include "OWLClassAssertionAxiom.hpp"
+#include "OWLDataPropertyAssertionAxiom.hpp"
 #include "OWLDeclarationAxiom.hpp"
 #include "OWLSubClassOfAxiom.hpp"
+#include "OWLEquivalentClassesAxiom.hpp"
+#include "OWLAnnotationAssertionAxiom.hpp"
 #include "ChangeApplied.hpp"
 #include "OWLAxiomRetractVisitor.hpp"
 #include "QueryCache.hpp"
+#include "PropertyValueIndex.hpp"
+#include "AxiomIndex.hpp"
+#include "OWLClassExpressionPool.hpp"
+#include "ObjectArena.hpp"
+#include "../reasoner/PropertyDomainIndex.hpp"
 
 namespace owlapi {
 
@@ -31,10 +40,11 @@ namespace io {
 namespace model {
 
 class OWLOntologyTell;
+class OWLOntologyTellBatch;
 class OWLOntologyAsk;
 class OWLOntologyChange;
 
-typedef std::map<OWLAxiom::AxiomType, OWLAxiom::PtrList > AxiomMap;
+typedef std::map<OWLAxiom::AxiomType, AxiomIndex<> > AxiomMap;
 
 /**
  * Ontology
@@ -43,6 +53,7 @@ typedef std::map<OWLAxiom::AxiomType, OWLAxiom::PtrList > AxiomMap;
 class OWLOntology
 {
     friend class OWLOntologyTell;
+    friend class OWLOntologyTellBatch;
     friend class OWLOntologyAsk;
     friend class io::OWLOntologyIO;
     friend class io::OWLOntologyReader;
@@ -56,6 +67,9 @@ protected:
     std::map<IRI, OWLClass::Ptr> mClasses;
     /// All anonymous class expressions
     std::map<IRI, OWLAnonymousClassExpression::Ptr> mAnonymousClassExpressions;
+    /// IRIs of the anonymous class expressions, i.e. the reverse of
+    /// mAnonymousClassExpressions
+    std::unordered_map<OWLAnonymousClassExpression::Ptr, IRI> mAnonymousClassExpressionIRIs;
     /// All named individuals
     std::map<IRI, OWLNamedIndividual::Ptr> mNamedIndividuals;
     /// All anonymous individuals
@@ -76,18 +90,28 @@ protected:
     /// General axiom map
     AxiomMap mAxiomsByType;
 
-    std::map<OWLClassExpression::Ptr, std::vector<OWLClassAssertionAxiom::Ptr> > mClassAssertionAxiomsByClass;
+    /// Equivalent classes axioms by each of their class expressions
+    std::unordered_map<OWLClassExpression::Ptr, AxiomIndex<OWLEquivalentClassesAxiom> > mEquivalentClassesAxioms;
 
-    std::map<OWLIndividual::Ptr, std::vector<OWLClassAssertionAxiom::Ptr> > mClassAssertionAxiomsByIndividual;
+    std::map<OWLClassExpression::Ptr, AxiomIndex<OWLClassAssertionAxiom> > mClassAssertionAxiomsByClass;
+
+    std::map<OWLIndividual::Ptr, AxiomIndex<OWLClassAssertionAxiom> > mClassAssertionAxiomsByIndividual;
 
     std::map<OWLDataProperty::Ptr, std::vector<OWLAxiom::Ptr> > mDataPropertyAxioms;
+    /// Data property assertions by individual and data property
+    PropertyValueIndex<OWLDataPropertyAssertionAxiom::Ptr> mDataPropertyAssertions;
     std::map<OWLObjectProperty::Ptr, std::vector<OWLAxiom::Ptr> > mObjectPropertyAxioms;
     std::map<OWLAnnotationProperty::Ptr, std::vector<OWLAxiom::Ptr> > mAnnotationAxioms;
-    std::map<OWLNamedIndividual::Ptr, std::vector<OWLAxiom::Ptr> > mNamedIndividualAxioms;
+    /// Annotation assertions by subject and annotation property
+    PropertyValueIndex<OWLAnnotationAssertionAxiom::Ptr> mAnnotationAssertions;
+    std::map<OWLNamedIndividual::Ptr, AxiomIndex<> > mNamedIndividualAxioms;
     /// Map of anonymous individual to all axioms the individual is involved into
-    std::map<OWLAnonymousIndividual::Ptr, std::vector<OWLAxiom::Ptr> > mAnonymousIndividualAxioms;
+    std::map<OWLAnonymousIndividual::Ptr, AxiomIndex<> > mAnonymousIndividualAxioms;
     std::map<OWLEntity::Ptr, std::vector<OWLDeclarationAxiom::Ptr> > mDeclarationsByEntity;
 
+    /// Axioms referring to an entity, by entity type and entity IRI
+    std::map<OWLEntity::EntityType, std::unordered_map<IRI, AxiomIndex<> > > mReferencingAxioms;
+
     /// Map to access subclass axiom by a given subclass
     std::map<OWLClassExpression::Ptr, std::vector<OWLSubClassOfAxiom::Ptr> > mSubClassAxiomBySubPosition;
     /// Map to access subclass axiom by a given superclass
@@ -112,25 +136,69 @@ protected:
     template<typename LIST, typename A>
     void removeAxiomFromMap(LIST& list, const A* axiom)
     {
-        typename LIST::iterator it = std::find_if(list.begin(), list.end(), [axiom](const typename LIST::value_type& ptr)
-                {
-                    return axiom == ptr.get();
-                });
-
-        if(it != list.end())
+        if(!list.erase(*axiom))
         {
-            list.erase(it);
-            return;
+            throw std::runtime_error("owlapi::model::OWLOntology: failed to remove axiom from list");
         }
-        throw std::runtime_error("owlapi::model::OWLOntology: failed to remove axiom from list");
     }
 
+    /// Whether class axioms define a class through an anonymous class
+    /// expression, so that changes of the class hierarchy are not local
+    bool mHasDefinedClasses;
+    /// Whether class expressions refer to individuals, so that assertions can
+    /// change the class hierarchy
+    bool mHasNominals;
+
 protected:
     QueryCache mQueryCache;
+    /// Canonical instances of the anonymous class expressions
+    OWLClassExpressionPool mClassExpressionPool;
+    /// Memory of the entities, axioms and class expressions created for this
+    /// ontology
+    ObjectArena::Ptr mObjectArena;
+    /// Properties applicable to each class, built on demand and reset on
+    /// changes of the class or property hierarchy
+    reasoner::PropertyDomainIndex::Ptr mPropertyDomainIndex;
+
+    /**
+     * Invalidate the cached query results which are affected by adding or
+     * removing the given axiom
+     */
+    void invalidateQueryCache(const OWLAxiom& axiom);
+
+    /**
+     * Invalidate the cached query results which are affected by a class axiom
+     * \param expressions Class expressions the axiom refers to
+     * \param defining True if the axiom defines a class through an anonymous
+     * class expression
+     */
+    void invalidateQueryCache(const OWLClassExpression::PtrList& expressions, bool defining);
 
     OWLClass::Ptr getClass(const IRI& iri) const;
     OWLAnonymousClassExpression::Ptr getAnonymousClassExpression(const IRI& iri) const;
 
+    /**
+     * Register an anonymous class expression under the given iri and
+     * update the reverse mapping
+     * \details A replaced expression remains in the pool
+     * \return the canonical instance of the expression, which is registered
+     * instead of the given one
+     * \see OWLClassExpressionPool
+     */
+    OWLAnonymousClassExpression::Ptr setAnonymousClassExpression(const IRI& iri, const OWLAnonymousClassExpression::Ptr& expression);
+    /**
+     * Find the iri of a registered anonymous class expression, or of the
+     * registered expression which is structurally equal to it
+     * \return the iri, or NULL if the expression has not been registered
+     */
+    const IRI* findIRIOfAnonymousClassExpression(const OWLAnonymousClassExpression::Ptr& expression) const;
+    /**
+     * Get the iri of a registered anonymous class expression, or of the
+     * registered expression which is structurally equal to it
+     * \throw std::invalid_argument if the expression has not been registered
+     */
+    const IRI& iriOfAnonymousClassExpression(const OWLAnonymousClassExpression::Ptr& expression) const;
+
     OWLDataProperty::Ptr getDataProperty(const IRI& iri) const;
     const IRI& iriOfDataProperty(const OWLDataProperty::Ptr& property) const;
 
@@ -139,9 +207,47 @@ protected:
     OWLIndividual::Ptr getIndividual(const IRI& iri) const;
     OWLAnonymousIndividual::Ptr getAnonymousIndividual(const IRI& iri) const;
 
-    void addAxiom(const OWLAxiom::Ptr& axiom);
+    /**
+     * Non-throwing lookup of entities
+     * \return the entity, or an empty pointer if it is not known
+     */
+    OWLClass::Ptr findClass(const IRI& iri) const;
+    OWLAnonymousClassExpression::Ptr findAnonymousClassExpression(const IRI& iri) const;
+    OWLDataProperty::Ptr findDataProperty(const IRI& iri) const;
+    OWLObjectProperty::Ptr findObjectProperty(const IRI& iri) const;
+    OWLAnnotationProperty::Ptr findAnnotationProperty(const IRI& iri) const;
+    OWLNamedIndividual::Ptr findNamedIndividual(const IRI& iri) const;
+    OWLAnonymousIndividual::Ptr findAnonymousIndividual(const IRI& iri) const;
+    OWLIndividual::Ptr findIndividual(const IRI& iri) const;
+
+    /**
+     * Add an axiom unless a structurally equal axiom has already been added
+     * \return the axiom contained in the ontology
+     */
+    OWLAxiom::Ptr addAxiom(const OWLAxiom::Ptr& axiom);
+    /**
+     * Find the contained axiom which is structurally equal to the given one
+     * \return the contained axiom, or an empty pointer if there is none
+     */
+    OWLAxiom::Ptr findAxiom(const OWLAxiom& axiom) const;
     void removeAxiom(const OWLAxiom::Ptr& axiom);
 
+    /**
+     * Register the axiom as referencing all entities of its signature
+     * \param structuralHash the structural hash of the axiom, which is
+     * shared by all reference indexes
+     */
+    void addReferences(const OWLAxiom::Ptr& axiom, size_t structuralHash);
+    /**
+     * Remove the axiom from the references of all entities of its signature
+     */
+    void removeReferences(const OWLAxiom& axiom);
+
+    /**
+     * Remove a contained annotation assertion from the annotation indexes
+     */
+    void removeAnnotationAssertion(const OWLAnnotationAssertionAxiom::Ptr& axiom);
+
     void retractValueOf(const OWLIndividual::Ptr& individual, const OWLDataProperty::Ptr& property);
 
     /**
@@ -199,6 +305,12 @@ public:
     const AxiomMap& getAxiomMap() const { return mAxiomsByType; }
     OWLAxiom::PtrList getAxioms() const;
 
+    /**
+     * Get the axioms which refer to the given entity
+     * \param entity The entity
+     * \param excludeImports If true, axioms which originate from imported
+     * documents are omitted
+     */
     OWLAxiom::PtrList getReferencingAxioms(const OWLEntity::Ptr& entity, bool excludeImports);
 
     ChangeApplied applyChange(const shared_ptr<OWLOntologyChange>& change);
@@ -208,6 +320,11 @@ public:
       */
     QueryCache& getQueryCache() { return mQueryCache; }
 
+    /**
+     * Get the arena which holds the model objects created for this ontology
+     */
+    const ObjectArena::Ptr& getObjectArena() const { return mObjectArena; }
+
     /**
      * \see https://www.w3.org/TR/owl2-syntax/
      *  Entities are the fundamental building blocks of OWL 2 ontologies, and
@@ -2,6 +2,8 @@
 #include "../KnowledgeBase.hpp"
 #include "../Vocabulary.hpp"
 #include "OWLObjectIntersectionOf.hpp"
+#include "../reasoner/TaxonomyWalker.hpp"
+#include <unordered_map>
 
 namespace owlapi {
 namespace model {
@@ -11,43 +13,37 @@ OWLOntologyAsk::OWLOntologyAsk(OWLOntology::Ptr ontology)
 {}
 
 
-OWLClassExpression::Ptr OWLOntologyAsk::getOWLClassExpression(const IRI& iri) const
+OWLClassExpression::Ptr OWLOntologyAsk::findOWLClassExpression(const IRI& iri) const
 {
-
-    try {
-        OWLAnonymousClassExpression::Ptr klass = getOWLAnonymousClassExpression(iri);
-        return dynamic_pointer_cast<OWLClassExpression>(klass);
-    } catch(...)
+    OWLAnonymousClassExpression::Ptr anonymousKlass = mpOntology->findAnonymousClassExpression(iri);
+    if(anonymousKlass)
     {
-        ///
+        return anonymousKlass;
     }
+    return mpOntology->findClass(iri);
+}
 
-    try {
-        OWLClass::Ptr klass = getOWLClass(iri);
-        return dynamic_pointer_cast<OWLClassExpression>(klass);
-    } catch(...)
+OWLClassExpression::Ptr OWLOntologyAsk::getOWLClassExpression(const IRI& iri) const
+{
+    OWLClassExpression::Ptr klass = findOWLClassExpression(iri);
+    if(!klass)
     {
-        ///
+        throw std::invalid_argument("owlapi::model::OWLOntologyAsk::getClassExpression: "
+                "could not find a class expression for iri '" + iri.toString() + "'");
     }
-    throw std::invalid_argument("owlapi::model::OWLOntologyAsk::getClassExpression: "
-            "could not find a class expression for iri '" + iri.toString() + "'");
+    return klass;
 }
+
 const IRI& OWLOntologyAsk::getOWLClassExpressionIRI(const OWLClassExpression::Ptr& expression) const
 {
     OWLAnonymousClassExpression::Ptr aClassExpression = dynamic_pointer_cast<OWLAnonymousClassExpression>(expression);
 
     if(aClassExpression)
     {
-        std::map<IRI, OWLAnonymousClassExpression::Ptr>::const_iterator it = std::find_if(
-                mpOntology->mAnonymousClassExpressions.begin(),
-                mpOntology->mAnonymousClassExpressions.end(),
-                [&aClassExpression](const std::pair<IRI, OWLAnonymousClassExpression::Ptr>& other)
-                {
-                    return other.second == aClassExpression;
-                });
-        if(it != mpOntology->mAnonymousClassExpressions.end())
+        const IRI* iri = mpOntology->findIRIOfAnonymousClassExpression(aClassExpression);
+        if(iri)
         {
-            return it->first;
+            return *iri;
         }
         throw std::runtime_error("owlapi::model::OWLOntologyAsk::getOWLClassExpressionIRI:"
                 " failed to identify IRI for AnonymousClassExpression."
@@ -58,15 +54,9 @@ const IRI& OWLOntologyAsk::getOWLClassExpressionIRI(const OWLClassExpression::Pt
     OWLClass::Ptr aClass = dynamic_pointer_cast<OWLClass>(expression);
     if(aClass)
     {
-        std::map<IRI, OWLClass::Ptr>::const_iterator it = std::find_if(
-                mpOntology->mClasses.begin(),
-                mpOntology->mClasses.end(),
-                [&aClass](const std::pair<IRI, OWLClass::Ptr>& other)
-                {
-                    return other.second == aClass;
-                });
-
-        if(it != mpOntology->mClasses.end())
+        // classes are registered under their own iri
+        std::map<IRI, OWLClass::Ptr>::const_iterator it = mpOntology->mClasses.find(aClass->getIRI());
+        if(it != mpOntology->mClasses.end() && it->second == aClass)
         {
             return it->first;
         }
@@ -83,95 +73,125 @@ const IRI& OWLOntologyAsk::getOWLClassExpressionIRI(const OWLClassExpression::Pt
     );
 }
 
+OWLClass::Ptr OWLOntologyAsk::findOWLClass(const IRI& iri) const
+{
+    return mpOntology->findClass(iri);
+}
+
 OWLClass::Ptr OWLOntologyAsk::getOWLClass(const IRI& iri) const
 {
-    std::map<IRI, OWLClass::Ptr>::const_iterator it = mpOntology->mClasses.find(iri);
-    if(it != mpOntology->mClasses.end())
+    OWLClass::Ptr entity = findOWLClass(iri);
+    if(!entity)
     {
-        return it->second;
+        throw std::runtime_error("OWLOntologyAsk::getOWLClass: '" + iri.toString() + "' is not a known OWLClass");
     }
+    return entity;
+}
 
-    throw std::runtime_error("OWLOntologyAsk::getOWLClass: '" + iri.toString() + "' is not a known OWLClass");
+OWLAnonymousClassExpression::Ptr OWLOntologyAsk::findOWLAnonymousClassExpression(const IRI& iri) const
+{
+    return mpOntology->findAnonymousClassExpression(iri);
 }
 
 OWLAnonymousClassExpression::Ptr OWLOntologyAsk::getOWLAnonymousClassExpression(const IRI& iri) const
 {
-    std::map<IRI, OWLAnonymousClassExpression::Ptr>::const_iterator it = mpOntology->mAnonymousClassExpressions.find(iri);
-    if(it != mpOntology->mAnonymousClassExpressions.end())
+    OWLAnonymousClassExpression::Ptr entity = findOWLAnonymousClassExpression(iri);
+    if(!entity)
     {
-        return it->second;
+        throw std::runtime_error("OWLOntologyAsk::getOWLAnonymousClassExpression: '" + iri.toString() + "' is not a known OWLAnonymousClassExpression");
     }
-
-    throw std::runtime_error("OWLOntologyAsk::getOWLAnonymousClassExpression: '" + iri.toString() + "' is not a known OWLAnonymousClassExpression");
+    return entity;
 }
 
 
-OWLIndividual::Ptr OWLOntologyAsk::getOWLIndividual(const IRI& iri) const
+OWLIndividual::Ptr OWLOntologyAsk::findOWLIndividual(const IRI& iri) const
 {
-    try {
-        return getOWLAnonymousIndividual(iri);
-    } catch(const std::runtime_error& e)
-    {}
+    return mpOntology->findIndividual(iri);
+}
 
-    try {
-        return getOWLNamedIndividual(iri);
-    } catch(const std::runtime_error& e)
-    {}
+OWLIndividual::Ptr OWLOntologyAsk::getOWLIndividual(const IRI& iri) const
+{
+    OWLIndividual::Ptr entity = findOWLIndividual(iri);
+    if(!entity)
+    {
+        throw std::runtime_error("OWLOntologyAsk::getOWLIndividual: '" + iri.toString() + "' is not a known OWLIndividual");
+    }
+    return entity;
+}
 
-    throw std::runtime_error("OWLOntologyAsk::getOWLIndividual: '" + iri.toString() + "' is not a known OWLIndividual");
+OWLAnonymousIndividual::Ptr OWLOntologyAsk::findOWLAnonymousIndividual(const IRI& iri) const
+{
+    return mpOntology->findAnonymousIndividual(iri);
 }
 
 OWLAnonymousIndividual::Ptr OWLOntologyAsk::getOWLAnonymousIndividual(const IRI& iri) const
 {
-    std::map<IRI, OWLAnonymousIndividual::Ptr>::const_iterator it = mpOntology->mAnonymousIndividuals.find(iri);
-    if(it != mpOntology->mAnonymousIndividuals.end())
+    OWLAnonymousIndividual::Ptr entity = findOWLAnonymousIndividual(iri);
+    if(!entity)
     {
-        return it->second;
+        throw std::runtime_error("OWLOntologyAsk::getAnonymousIndividual: '" + iri.toString() + "' is not a known OWLAnonymousIndividual");
     }
-    throw std::runtime_error("OWLOntologyAsk::getAnonymousIndividual: '" + iri.toString() + "' is not a known OWLAnonymousIndividual");
+    return entity;
+}
+
+OWLNamedIndividual::Ptr OWLOntologyAsk::findOWLNamedIndividual(const IRI& iri) const
+{
+    return mpOntology->findNamedIndividual(iri);
 }
 
 OWLNamedIndividual::Ptr OWLOntologyAsk::getOWLNamedIndividual(const IRI& iri) const
 {
-    std::map<IRI, OWLNamedIndividual::Ptr>::const_iterator it = mpOntology->mNamedIndividuals.find(iri);
-    if(it != mpOntology->mNamedIndividuals.end())
+    OWLNamedIndividual::Ptr entity = findOWLNamedIndividual(iri);
+    if(!entity)
     {
-        return it->second;
+        throw std::runtime_error("OWLOntologyAsk::getNamedIndividual: '" + iri.toString() + "' is not a known OWLNamedIndividual");
     }
+    return entity;
+}
 
-    throw std::runtime_error("OWLOntologyAsk::getNamedIndividual: '" + iri.toString() + "' is not a known OWLNamedIndividual");
+OWLObjectProperty::Ptr OWLOntologyAsk::findOWLObjectProperty(const IRI& iri) const
+{
+    return mpOntology->findObjectProperty(iri);
 }
 
 OWLObjectProperty::Ptr OWLOntologyAsk::getOWLObjectProperty(const IRI& iri) const
 {
-    std::map<IRI, OWLObjectProperty::Ptr>::const_iterator it = mpOntology->mObjectProperties.find(iri);
-    if(it != mpOntology->mObjectProperties.end())
+    OWLObjectProperty::Ptr entity = findOWLObjectProperty(iri);
+    if(!entity)
     {
-        return it->second;
+        throw std::runtime_error("OWLOntologyAsk::getOWLObjectProperty: '" + iri.toString() + "' is not a known OWLObjectProperty");
     }
-    throw std::runtime_error("OWLOntologyAsk::getOWLObjectProperty: '" + iri.toString() + "' is not a known OWLObjectProperty");
+    return entity;
+}
+
+OWLDataProperty::Ptr OWLOntologyAsk::findOWLDataProperty(const IRI& iri) const
+{
+    return mpOntology->findDataProperty(iri);
 }
 
 OWLDataProperty::Ptr OWLOntologyAsk::getOWLDataProperty(const IRI& iri) const
 {
-    std::map<IRI, OWLDataProperty::Ptr>::const_iterator it = mpOntology->mDataProperties.find(iri);
-    if(it != mpOntology->mDataProperties.end())
+    OWLDataProperty::Ptr entity = findOWLDataProperty(iri);
+    if(!entity)
     {
-        return it->second;
+        throw std::runtime_error("OWLOntologyAsk::getOWLDataProperty: '" + iri.toString() + "' is not a known OWLDataProperty");
     }
+    return entity;
+}
 
-    throw std::runtime_error("OWLOntologyAsk::getOWLDataProperty: '" + iri.toString() + "' is not a known OWLDataProperty");
+OWLAnnotationProperty::Ptr OWLOntologyAsk::findOWLAnnotationProperty(const IRI& iri) const
+{
+    return mpOntology->findAnnotationProperty(iri);
 }
 
 OWLAnnotationProperty::Ptr OWLOntologyAsk::getOWLAnnotationProperty(const IRI& iri) const
 {
-    std::map<IRI, OWLAnnotationProperty::Ptr>::const_iterator it = mpOntology->mAnnotationProperties.find(iri);
-    if(it != mpOntology->mAnnotationProperties.end())
+    OWLAnnotationProperty::Ptr entity = findOWLAnnotationProperty(iri);
+    if(!entity)
     {
-        return it->second;
+        throw std::runtime_error("OWLOntologyAsk::getOWLAnnotationProperty: '" + iri.toString() + "' is not a known OWLAnnotationProperty");
     }
-
-    throw std::runtime_error("OWLOntologyAsk::getOWLAnnotationProperty: '" + iri.toString() + "' is not a known OWLAnnotationProperty");
+    return entity;
 }
 
 std::vector<OWLCardinalityRestriction::Ptr>
@@ -179,6 +199,14 @@ OWLOntologyAsk::getCardinalityRestrictions(const owlapi::model::OWLClassExpressi
         const IRI& objectProperty,
         bool includeAncestors) const
 {
+    // Track the entities the result is derived from for the query cache
+    OWLClass::Ptr namedClass = dynamic_pointer_cast<OWLClass>(ce);
+    if(namedClass)
+    {
+        QueryCache::recordDependency(namedClass->getIRI());
+    }
+    QueryCache::recordDependency(objectProperty);
+
     owlapi::model::OWLProperty::Ptr property;
     if(objectProperty != IRI())
     {
@@ -343,12 +371,14 @@ OWLOntologyAsk::getCardinalityRestrictions(const IRI& iri,
     {
         return result.first;
     } else {
+        QueryCache::DependencyScope dependencies;
         OWLClass::Ptr klass = getOWLClass(iri);
         OWLCardinalityRestriction::PtrList restrictions =
             getCardinalityRestrictions(klass, objectProperty, includeAncestors);
         if(includeAncestors)
         {
-            mpOntology->mQueryCache.cacheCardinalityRestrictions(iri, objectProperty, restrictions);
+            mpOntology->mQueryCache.cacheCardinalityRestrictions(iri, objectProperty, restrictions,
+                    dependencies.getDependencies());
         }
         return restrictions;
     }
@@ -365,6 +395,7 @@ std::vector<OWLCardinalityRestriction::Ptr> OWLOntologyAsk::getCardinalityRestri
     {
         return result.first;
     } else {
+        QueryCache::DependencyScope dependencies;
         std::vector<IRI>::const_iterator cit = klasses.begin();
         std::vector<OWLCardinalityRestriction::Ptr> restrictions;
 
@@ -377,7 +408,8 @@ std::vector<OWLCardinalityRestriction::Ptr> OWLOntologyAsk::getCardinalityRestri
         mpOntology->mQueryCache.cacheCardinalityRestrictions(klasses,
                 objectProperty,
                 operationType,
-                restrictions);
+                restrictions,
+                dependencies.getDependencies());
         return restrictions;
     }
 }
@@ -470,8 +502,104 @@ std::vector<OWLCardinalityRestriction::Ptr> OWLOntologyAsk::getCardinalityRestri
 }
 
 
+QueryCache::CardinalityBounds OWLOntologyAsk::getCardinalityBounds(const IRI& klass,
+        const IRI& objectProperty) const
+{
+    std::pair<QueryCache::CardinalityBounds, bool> result =
+        mpOntology->mQueryCache.getCardinalityBounds(klass, objectProperty);
+    if(result.second)
+    {
+        return result.first;
+    }
+
+    QueryCache::DependencyScope dependencies;
+    result.first = OWLObjectCardinalityRestriction::getBounds(
+            getCardinalityRestrictions(klass, objectProperty));
+    mpOntology->mQueryCache.cacheCardinalityBounds(klass, objectProperty, result.first,
+            dependencies.getDependencies());
+    return result.first;
+}
+
+namespace {
+
+/**
+ * Collect the object properties of the cardinality restrictions a class
+ * expression consists of
+ */
+void collectRestrictedProperties(const OWLClassExpression::Ptr& ce, IRISet& properties)
+{
+    switch(ce->getClassExpressionType())
+    {
+        case OWLClassExpression::OBJECT_EXACT_CARDINALITY:
+        case OWLClassExpression::OBJECT_MAX_CARDINALITY:
+        case OWLClassExpression::OBJECT_MIN_CARDINALITY:
+        {
+            OWLCardinalityRestriction::Ptr restriction = dynamic_pointer_cast<OWLCardinalityRestriction>(ce);
+            OWLObjectProperty::Ptr property = dynamic_pointer_cast<OWLObjectProperty>(restriction->getProperty());
+            if(property)
+            {
+                properties.insert(property->getIRI());
+            }
+            break;
+        }
+        case OWLClassExpression::OBJECT_INTERSECTION_OF:
+        {
+            OWLObjectIntersectionOf::Ptr intersectionOf = dynamic_pointer_cast<OWLObjectIntersectionOf>(ce);
+            for(const OWLClassExpression::Ptr& operand : intersectionOf->getOperands())
+            {
+                collectRestrictedProperties(operand, properties);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+} // end anonymous namespace
+
+size_t OWLOntologyAsk::compileCardinalityBounds() const
+{
+    // Classes without restrictions on a property have empty bounds, so that
+    // only properties used in restrictions need to be considered
+    IRISet properties;
+    for(const std::pair<const OWLClassExpression::Ptr, std::vector<OWLSubClassOfAxiom::Ptr> >& p : mpOntology->mSubClassAxiomBySubPosition)
+    {
+        for(const OWLSubClassOfAxiom::Ptr& axiom : p.second)
+        {
+            collectRestrictedProperties(axiom->getSuperClass(), properties);
+        }
+    }
+    for(const std::pair<const OWLClassExpression::Ptr, AxiomIndex<OWLEquivalentClassesAxiom> >& p : mpOntology->mEquivalentClassesAxioms)
+    {
+        collectRestrictedProperties(p.first, properties);
+    }
+
+    size_t numberOfEntries = 0;
+    for(const std::pair<const IRI, OWLClass::Ptr>& klass : mpOntology->mClasses)
+    {
+        for(const IRI& property : properties)
+        {
+            try {
+                getCardinalityBounds(klass.first, property);
+                ++numberOfEntries;
+            } catch(const std::invalid_argument& e)
+            {
+                LOG_DEBUG_S << "owlapi::model::OWLOntologyAsk::compileCardinalityBounds: no bounds for '"
+                    << klass.first << "' and '" << property << "' -- " << e.what();
+            }
+        }
+    }
+    return numberOfEntries;
+}
+
 bool OWLOntologyAsk::isSubClassOf(const IRI& iri, const IRI& superclass) const
 {
+    if(mpOntology->kb()->hasSubsumptionIndex())
+    {
+        return mpOntology->kb()->isSubClassOf(iri, superclass);
+    }
+
     std::pair<bool, bool> result = mpOntology->mQueryCache.isSubClassOf(iri, superclass);
     if(result.second)
     {
@@ -480,8 +608,9 @@ bool OWLOntologyAsk::isSubClassOf(const IRI& iri, const IRI& superclass) const
         result.first = mpOntology->kb()->isSubClassOf(iri, superclass);
         result.second = true;
 
+        QueryCache::Dependencies dependencies = { iri, superclass };
         mpOntology->mQueryCache.cacheIsSubClassOf(iri, superclass,
-                result.first);
+                result.first, dependencies);
 
         return result.first;
     }
@@ -521,24 +650,12 @@ bool OWLOntologyAsk::isOWLAnonymousClassExpression(const IRI& iri) const
 
 bool OWLOntologyAsk::isOWLIndividual(const IRI& iri) const
 {
-    try {
-        mpOntology->getIndividual(iri);
-        return true;
-    } catch(...)
-    {
-        return false;
-    }
+    return mpOntology->findIndividual(iri) != OWLIndividual::Ptr();
 }
 
 bool OWLOntologyAsk::isOWLAnonymousIndividual(const IRI& iri) const
 {
-    try {
-        mpOntology->getAnonymousIndividual(iri);
-        return true;
-    } catch(...)
-    {
-        return false;
-    }
+    return mpOntology->findAnonymousIndividual(iri) != OWLAnonymousIndividual::Ptr();
 }
 
 bool OWLOntologyAsk::isRDFProperty(const IRI& iri) const
@@ -556,41 +673,25 @@ IRIList OWLOntologyAsk::allSubClassesOf(const IRI& classType, bool direct) const
     return mpOntology->kb()->allSubClassesOf(classType, direct);
 }
 
-std::vector<IRIList> OWLOntologyAsk::allSubClassesOfWithDistance(const IRI& classType) const
+std::vector<IRIList> OWLOntologyAsk::allSubClassesOfWithDistance(const IRI& classType, bool unique) const
 {
-    std::vector<IRIList> list;
-    IRIList allDirectSubclasses = allSubClassesOf(classType, true);
-    list.push_back(allDirectSubclasses);
+    shared_ptr<KnowledgeBase> kb = mpOntology->kb();
+    reasoner::TaxonomyWalker walker(classType,
+            [&kb](const IRI& klass) { return kb->allSubClassesOf(klass, true); },
+            unique);
 
-    while(!allDirectSubclasses.empty())
-    {
-        IRIList subclasses;
-        for(const IRI& iri : allDirectSubclasses)
-        {
-            IRIList directSubclasses = allSubClassesOf(iri, true);
-            subclasses.insert(subclasses.begin(), directSubclasses.begin(), directSubclasses.end());
-        }
-        list.push_back(subclasses);
-        allDirectSubclasses = subclasses;
-    }
+    std::vector<IRIList> list = walker.getLevels();
+    list.push_back(IRIList());
     return list;
 }
 
 IRIList OWLOntologyAsk::allUnderivedSubClassesOf(const IRI& classType) const
 {
-    IRIList noChildrenSubclass;
-    IRIList subclasses = allSubClassesOf(classType, false);
-    IRIList::const_iterator cit = subclasses.begin();
-    for(; cit != subclasses.end(); ++cit)
-    {
-        const IRI& subclass = *cit;
-        IRIList subclassesOfSubclass = allSubClassesOf(subclass, true);
-        if(subclassesOfSubclass.empty())
-        {
-            noChildrenSubclass.push_back(subclass);
-        }
-    }
-    return noChildrenSubclass;
+    shared_ptr<KnowledgeBase> kb = mpOntology->kb();
+    reasoner::TaxonomyWalker walker(classType,
+            [&kb](const IRI& klass) { return kb->allSubClassesOf(klass, true); },
+            true);
+    return walker.getLeaves();
 }
 
 IRIList OWLOntologyAsk::allInstances() const
@@ -624,25 +725,20 @@ std::vector<OWLClassExpression::Ptr> OWLOntologyAsk::allEquivalentClassExpressio
 {
     OWLClassExpression::PtrList allClasses;
 
-    for(const OWLAxiom::Ptr& axiom :
-            mpOntology->mAxiomsByType[OWLAxiom::EquivalentClasses])
+    auto it = mpOntology->mEquivalentClassesAxioms.find(klassExpression);
+    if(it == mpOntology->mEquivalentClassesAxioms.end())
     {
-        const OWLEquivalentClassesAxiom::Ptr& equivalentClassesAxiom =
-            dynamic_pointer_cast<OWLEquivalentClassesAxiom>(axiom);
+        return allClasses;
+    }
 
-        if(equivalentClassesAxiom->contains(klassExpression))
+    for(const OWLEquivalentClassesAxiom::Ptr& equivalentClassesAxiom : it->second)
+    {
+        for(const OWLClassExpression::Ptr& other : equivalentClassesAxiom->getEquivalentClasses())
         {
-            OWLClassExpression::PtrList equivalentClasses =
-                equivalentClassesAxiom->getEquivalentClasses();
-
-            equivalentClasses.erase(std::remove_if(equivalentClasses.begin(), equivalentClasses.end(),
-                    [klassExpression](const OWLClassExpression::Ptr& other)
-                    {
-                        return other == klassExpression;
-                    }), equivalentClasses.end());
-
-            allClasses.insert(allClasses.end(), equivalentClasses.begin(),
-                    equivalentClasses.end());
+            if(other != klassExpression)
+            {
+                allClasses.push_back(other);
+            }
         }
     }
     return allClasses;
@@ -731,51 +827,24 @@ OWLAnnotationValue::Ptr OWLOntologyAsk::getAnnotationValue(const IRI& instance,
         const IRI& annotationProperty,
         bool includeAncestors) const
 {
+    const PropertyValueIndex<OWLAnnotationAssertionAxiom::Ptr>::ValueList* assertions =
+        mpOntology->mAnnotationAssertions.find(instance, annotationProperty);
+    if(assertions)
+    {
+        return assertions->front()->annotationValue();
+    }
+
     for(const auto& p : mpOntology->mAnnotationAxioms)
     {
-        const OWLAnnotationProperty::Ptr& aProperty = p.first;
-        const std::vector<OWLAxiom::Ptr>& axioms = p.second;
-        if(aProperty->getIRI() != annotationProperty)
+        if(p.first->getIRI() == annotationProperty)
         {
-            continue;
+            throw std::invalid_argument("owlapi::model::OWLOntologyAsk::getAnnotationValue:"
+                    " failed to extract annotation '" +
+                    annotationProperty.toString() +
+                    "' for " +
+                    instance.toString()
+                    );
         }
-
-        for(const OWLAxiom::Ptr& axiom : axioms)
-        {
-            OWLAnnotationAssertionAxiom::Ptr assertionAxiom = dynamic_pointer_cast<OWLAnnotationAssertionAxiom>(axiom);
-            if(assertionAxiom)
-            {
-                OWLAnnotationSubject::Ptr subject = assertionAxiom->getSubject();
-                switch(subject->getObjectType())
-                {
-                    case OWLObject::IRIType:
-                    {
-                        IRI target = *dynamic_pointer_cast<IRI>(subject).get();
-                        if(target == instance)
-                        {
-                            return assertionAxiom->annotationValue();
-                        }
-                        break;
-                    }
-                    case OWLObject::AnonymousIndividual:
-                        if(dynamic_pointer_cast<OWLAnonymousIndividual>(subject)->getReferenceID() == instance)
-                        {
-                            return assertionAxiom->annotationValue();
-                        }
-                        break;
-                    default:
-                        throw std::invalid_argument("owlapi::model::OWLOntologyAsk::getAnnotationValue:"
-                                " encountered unknown type for AnnotationSubject");
-                }
-            }
-        }
-        throw std::invalid_argument("owlapi::model::OWLOntologyAsk::getAnnotationValue:"
-                " failed to extract annotation '" +
-                annotationProperty.toString() +
-                "' for " +
-                instance.toString()
-                );
-
     }
     return OWLAnnotationValue::Ptr();
 }
@@ -903,24 +972,12 @@ bool OWLOntologyAsk::isDatatype(const IRI& iri) const
 
 bool OWLOntologyAsk::isObjectProperty(const IRI& property) const
 {
-    try {
-        mpOntology->kb()->getObjectProperty(property);
-        return true;
-    } catch(const std::exception& e)
-    {
-        return false;
-    }
+    return mpOntology->kb()->tryGetObjectProperty(property).get() != NULL;
 }
 
 bool OWLOntologyAsk::isDataProperty(const IRI& property) const
 {
-    try {
-        mpOntology->kb()->getDataProperty(property);
-        return true;
-    } catch(const std::exception& e)
-    {
-        return false;
-    }
+    return mpOntology->kb()->tryGetDataProperty(property).get() != NULL;
 }
 
 bool OWLOntologyAsk::isAnnotationProperty(const IRI& property) const
@@ -928,8 +985,73 @@ bool OWLOntologyAsk::isAnnotationProperty(const IRI& property) const
     return mpOntology->mAnnotationProperties.find(property) != mpOntology->mAnnotationProperties.end();
 }
 
+namespace {
+
+/**
+ * Get the given class, its equivalent classes and all its subclasses
+ * \param cache Previously computed results, which is updated
+ */
+const IRIList& getSubsumedClasses(KnowledgeBase& kb, const IRI& klass,
+        std::unordered_map<IRI, IRIList>& cache)
+{
+    std::unordered_map<IRI, IRIList>::iterator it = cache.find(klass);
+    if(it != cache.end())
+    {
+        return it->second;
+    }
+
+    IRIList& klasses = cache[klass];
+    klasses.push_back(klass);
+    IRIList equivalentClasses = kb.allEquivalentClasses(klass);
+    klasses.insert(klasses.end(), equivalentClasses.begin(), equivalentClasses.end());
+    IRIList subClasses = kb.allSubClassesOf(klass);
+    klasses.insert(klasses.end(), subClasses.begin(), subClasses.end());
+    return klasses;
+}
+
+} // end anonymous namespace
+
+const reasoner::PropertyDomainIndex& OWLOntologyAsk::getPropertyDomainIndex() const
+{
+    if(mpOntology->mPropertyDomainIndex)
+    {
+        return *mpOntology->mPropertyDomainIndex;
+    }
+
+    shared_ptr<KnowledgeBase> kb = mpOntology->kb();
+    reasoner::PropertyDomainIndex::Ptr index(new reasoner::PropertyDomainIndex(kb->allClasses()));
+
+    // A property applies to all classes subsumed by one of its domains, so
+    // that each domain has to be expanded only once
+    std::unordered_map<IRI, IRIList> domainClasses;
+
+    for(const IRI& property : kb->allObjectProperties())
+    {
+        for(const IRI& domain : getObjectPropertyDomain(property))
+        {
+            index->addObjectProperty(property, getSubsumedClasses(*kb, domain, domainClasses));
+        }
+    }
+    for(const IRI& property : kb->allDataProperties())
+    {
+        for(const IRI& domain : getDataPropertyDomain(property))
+        {
+            index->addDataProperty(property, getSubsumedClasses(*kb, domain, domainClasses));
+        }
+    }
+
+    mpOntology->mPropertyDomainIndex = index;
+    return *index;
+}
+
 IRIList OWLOntologyAsk::getObjectPropertiesForDomain(const IRI& domain) const
 {
+    const reasoner::PropertyDomainIndex& index = getPropertyDomainIndex();
+    if(index.contains(domain))
+    {
+        return index.getObjectProperties(domain);
+    }
+
     IRIList validProperties;
     IRIList objectProperties = mpOntology->kb()->allObjectProperties();
     IRIList::const_iterator cit = objectProperties.begin();
@@ -947,6 +1069,12 @@ IRIList OWLOntologyAsk::getObjectPropertiesForDomain(const IRI& domain) const
 
 IRIList OWLOntologyAsk::getDataPropertiesForDomain(const IRI& domain) const
 {
+    const reasoner::PropertyDomainIndex& index = getPropertyDomainIndex();
+    if(index.contains(domain))
+    {
+        return index.getDataProperties(domain);
+    }
+
     IRIList validProperties;
     IRIList dataProperties = mpOntology->kb()->allDataProperties();
     IRIList::const_iterator cit = dataProperties.begin();
@@ -962,7 +1090,6 @@ IRIList OWLOntologyAsk::getDataPropertiesForDomain(const IRI& domain) const
     return validProperties;
 }
 
-
 IRISet OWLOntologyAsk::getRelatedObjectProperties(const IRI& instance, bool needInverse) const
 {
     return mpOntology->kb()->getRelatedObjectProperties(instance, needInverse);
@@ -84,6 +84,22 @@ public:
      */
     OWLAnnotationProperty::Ptr getOWLAnnotationProperty(const IRI& iri) const;
 
+    /**
+     * Non-throwing counterparts of the getOWL* functions, i.e. a lookup
+     * failure does not raise an exception
+     * \return the requested object, or an empty pointer if it cannot be found
+     * in the ontology
+     */
+    OWLClass::Ptr findOWLClass(const IRI& iri) const;
+    OWLAnonymousClassExpression::Ptr findOWLAnonymousClassExpression(const IRI& iri) const;
+    OWLClassExpression::Ptr findOWLClassExpression(const IRI& iri) const;
+    OWLIndividual::Ptr findOWLIndividual(const IRI& iri) const;
+    OWLAnonymousIndividual::Ptr findOWLAnonymousIndividual(const IRI& iri) const;
+    OWLNamedIndividual::Ptr findOWLNamedIndividual(const IRI& iri) const;
+    OWLObjectProperty::Ptr findOWLObjectProperty(const IRI& iri) const;
+    OWLDataProperty::Ptr findOWLDataProperty(const IRI& iri) const;
+    OWLAnnotationProperty::Ptr findOWLAnnotationProperty(const IRI& iri) const;
+
     /**
      * Retrieve the cardinality restrictions of a given class expression
      * \param ce Classexpression
@@ -164,6 +180,28 @@ public:
             const IRI& objectProperty,
             const IRI& targetKlass) const;
 
+    /**
+     * Get the bounds per qualification of the cardinality restrictions
+     * (including the inherited ones) of a class for an object property
+     * \details Bounds are kept in the query cache until the class or any
+     * class they have been derived from changes
+     * \throw std::invalid_argument if the class is not known or a
+     * qualification is not a named class
+     * \see OWLObjectCardinalityRestriction::getBounds
+     */
+    QueryCache::CardinalityBounds getCardinalityBounds(const IRI& klass,
+            const IRI& objectProperty) const;
+
+    /**
+     * Compute the cardinality bounds of all classes for all object properties
+     * which are used in cardinality restrictions, so that subsequent calls
+     * of getCardinalityBounds are answered by lookup
+     * \details Entries which are outdated by a later change of the ontology
+     * are recomputed on demand
+     * \return number of available entries
+     */
+    size_t compileCardinalityBounds() const;
+
 
     /**
      * Check if object identified by iri is a subclass of the given superclass
@@ -254,9 +292,12 @@ public:
 
     /**
      * Retrieve all subclasses of a given klass
-     * \return hierachical list of all subclasses with increasing link distance
+     * \param unique If true, a subclass which is reachable through multiple
+     * paths is listed only at its shortest distance, otherwise once per path
+     * \return hierachical list of all subclasses with increasing link
+     * distance, terminated by an empty list
      */
-    std::vector<IRIList> allSubClassesOfWithDistance(const IRI& klass) const;
+    std::vector<IRIList> allSubClassesOfWithDistance(const IRI& klass, bool unique = false) const;
 
     /**
      * Retrieve all underived subclasses, i.e. the leaves in the inheritance
@@ -487,6 +528,13 @@ public:
       * Retrieve the underlying ontology reference
       */
     const OWLOntology::Ptr& getOntology() const { return mpOntology; }
+
+private:
+    /**
+     * Get the index of properties applicable to each class, which is built
+     * from the classified knowledge base if it is not available
+     */
+    const reasoner::PropertyDomainIndex& getPropertyDomainIndex() const;
 };
 
 } // end namespace model
@@ -193,7 +193,7 @@ OWLClass::Ptr OWLOntologyTell::klass(const IRI& iri)
     {
         return it->second;
     } else {
-        OWLClass::Ptr klass = make_shared<OWLClass>(iri);
+        OWLClass::Ptr klass = create<OWLClass>(iri);
         mpOntology->mClasses[iri] = klass;
 
         // Update kb
@@ -212,16 +212,14 @@ OWLAnonymousClassExpression::Ptr OWLOntologyTell::anonymousClass(const IRI& iri,
     std::map<IRI, OWLAnonymousClassExpression::Ptr>::iterator it = mpOntology->mAnonymousClassExpressions.find(iri);
     if(expression)
     {
-        mpOntology->mAnonymousClassExpressions[iri] = expression;
-        return expression;
+        return mpOntology->setAnonymousClassExpression(iri, expression);
     } else {
         if(it != mpOntology->mAnonymousClassExpressions.end())
         {
             return it->second;
         }
         OWLAnonymousClassExpression::Ptr aClass = make_shared<OWLAnonymousClassExpression>();
-        mpOntology->mAnonymousClassExpressions[iri] = aClass;
-        return aClass;
+        return mpOntology->setAnonymousClassExpression(iri, aClass);
     }
 }
 
@@ -233,7 +231,7 @@ OWLAnonymousIndividual::Ptr OWLOntologyTell::anonymousIndividual(const IRI& iri)
         return it->second;
     } else {
         NodeID node(iri.toString(), true);
-        OWLAnonymousIndividual::Ptr individual = make_shared<OWLAnonymousIndividual>(node);
+        OWLAnonymousIndividual::Ptr individual = create<OWLAnonymousIndividual>(node);
         mpOntology->mAnonymousIndividuals[iri] = individual;
 
         mpOntology->kb()->getInstanceLazy(iri);
@@ -248,7 +246,7 @@ OWLNamedIndividual::Ptr OWLOntologyTell::namedIndividual(const IRI& iri)
     {
         return it->second;
     } else {
-        OWLNamedIndividual::Ptr individual = make_shared<OWLNamedIndividual>(iri);
+        OWLNamedIndividual::Ptr individual = create<OWLNamedIndividual>(iri);
         mpOntology->mNamedIndividuals[iri] = individual;
 
         //Update kb
@@ -285,7 +283,7 @@ OWLObjectProperty::Ptr OWLOntologyTell::objectProperty(const IRI& iri)
     {
         return it->second;
     } else {
-        OWLObjectProperty::Ptr property = make_shared<OWLObjectProperty>(iri);
+        OWLObjectProperty::Ptr property = create<OWLObjectProperty>(iri);
         mpOntology->mObjectProperties[iri] = property;
 
         //Update kb
@@ -342,20 +340,23 @@ void OWLOntologyTell::removeAnnotationProperty(const IRI& iri)
     OWLAnnotationProperty::Ptr property = mpOntology->mAnnotationProperties[iri];
     mpOntology->mAnnotationProperties.erase(iri);
 
-    std::map<OWLAxiom::AxiomType, OWLAxiom::PtrList>::iterator it = mpOntology->mAxiomsByType.find(OWLAxiom::AnnotationAssertion);
+    AxiomMap::iterator it = mpOntology->mAxiomsByType.find(OWLAxiom::AnnotationAssertion);
     if(it == mpOntology->mAxiomsByType.end())
     {
         return;
     }
 
-    OWLAxiom::PtrList& axioms = it->second;
-    OWLAxiom::PtrList::iterator ait = std::find_if(axioms.begin(), axioms.end(), [iri](OWLAxiom::Ptr other)
+    AxiomIndex<>& axioms = it->second;
+    AxiomIndex<>::const_iterator ait = std::find_if(axioms.begin(), axioms.end(), [iri](OWLAxiom::Ptr other)
             {
                 return dynamic_pointer_cast<OWLAnnotationAssertionAxiom>(other)->getProperty()->getIRI() == iri;
             });
     if(ait != axioms.end())
     {
-        axioms.erase(ait);
+        OWLAxiom::Ptr axiom = *ait;
+        mpOntology->removeAnnotationAssertion(dynamic_pointer_cast<OWLAnnotationAssertionAxiom>(axiom));
+        mpOntology->removeReferences(*axiom);
+        axioms.erase(*axiom);
     }
 }
 
@@ -372,10 +373,8 @@ OWLSubClassOfAxiom::Ptr OWLOntologyTell::subClassOf(const IRI& subclass, const I
     if(mAsk.isOWLAnonymousClassExpression(superclass))
     {
         OWLAnonymousClassExpression::Ptr e_superclass = mAsk.getOWLAnonymousClassExpression(superclass);
-
-        mpOntology->kb()->subClassOf(subclass, superclass);
-
-        return subClassOf(e_subclass, dynamic_pointer_cast<OWLClassExpression>(e_superclass));
+        return subClassOf(e_subclass, dynamic_pointer_cast<OWLClassExpression>(e_superclass),
+                [&]() { return mpOntology->kb()->subClassOf(subclass, superclass); });
 
     } else {
         OWLClass::Ptr e_superclass = klass(superclass);
@@ -385,23 +384,29 @@ OWLSubClassOfAxiom::Ptr OWLOntologyTell::subClassOf(const IRI& subclass, const I
 
 OWLSubClassOfAxiom::Ptr OWLOntologyTell::subClassOf(const OWLClass::Ptr& subclass, const OWLClass::Ptr& superclass)
 {
-    mpOntology->kb()->subClassOf(subclass->getIRI(), superclass->getIRI());
     return subClassOf(ptr_cast<OWLClassExpression,OWLClass>(subclass),
-            ptr_cast<OWLClassExpression, OWLClass>(superclass));
+            ptr_cast<OWLClassExpression, OWLClass>(superclass),
+            [&]() { return mpOntology->kb()->subClassOf(subclass->getIRI(), superclass->getIRI()); });
 }
 
 
 OWLSubClassOfAxiom::Ptr OWLOntologyTell::subClassOf(const OWLClassExpression::Ptr& subclassExpression, const OWLClassExpression::Ptr& superclassExpression)
 {
-    OWLSubClassOfAxiom::Ptr axiom = make_shared<OWLSubClassOfAxiom>(subclassExpression, superclassExpression);
-    mpOntology->mSubClassAxiomBySubPosition[subclassExpression].push_back(axiom);
-    mpOntology->mSubClassAxiomBySuperPosition[superclassExpression].push_back(axiom);
-
-    LOG_DEBUG_S << "Added SubClassOfAxiom:" << subclassExpression->toString() << " axiom: " << axiom->toString();
+    return subClassOf(subclassExpression, superclassExpression, std::function<reasoner::factpp::Axiom ()>());
+}
 
-    addAxiom(axiom);
-    // to return the exact type
-    return axiom;
+OWLSubClassOfAxiom::Ptr OWLOntologyTell::subClassOf(const OWLClassExpression::Ptr& subclassExpression,
+        const OWLClassExpression::Ptr& superclassExpression,
+        const std::function<reasoner::factpp::Axiom ()>& tellKnowledgeBase)
+{
+    OWLSubClassOfAxiom::Ptr axiom = make_shared<OWLSubClassOfAxiom>(subclassExpression, superclassExpression);
+    return addUnique<OWLSubClassOfAxiom>(axiom, tellKnowledgeBase,
+            [&]()
+            {
+                mpOntology->mSubClassAxiomBySubPosition[subclassExpression].push_back(axiom);
+                mpOntology->mSubClassAxiomBySuperPosition[superclassExpression].push_back(axiom);
+                LOG_DEBUG_S << "Added SubClassOfAxiom:" << subclassExpression->toString() << " axiom: " << axiom->toString();
+            });
 }
 
 OWLCardinalityRestriction::Ptr OWLOntologyTell::objectCardinalityRestriction(
@@ -410,20 +415,57 @@ OWLCardinalityRestriction::Ptr OWLOntologyTell::objectCardinalityRestriction(
         const OWLClassExpression::Ptr& qualification,
         OWLCardinalityRestriction::CardinalityRestrictionType restrictionType)
 {
-    return OWLObjectCardinalityRestriction::createInstance(dynamic_pointer_cast<OWLObjectPropertyExpression>(property), cardinality, qualification, restrictionType);
+    OWLCardinalityRestriction::Ptr restriction = OWLObjectCardinalityRestriction::createInstance(dynamic_pointer_cast<OWLObjectPropertyExpression>(property), cardinality, qualification, restrictionType);
+    return mpOntology->mClassExpressionPool.intern(restriction);
 }
 
 OWLAxiom::Ptr OWLOntologyTell::addAxiom(const OWLAxiom::Ptr& axiom)
 {
     axiom->setOrigin(mOrigin);
-    mpOntology->addAxiom(axiom);
-    return axiom;
+    return mpOntology->addAxiom(axiom);
+}
+
+template<typename T>
+typename T::Ptr OWLOntologyTell::addUnique(const typename T::Ptr& axiom,
+        const std::function<reasoner::factpp::Axiom ()>& tellKnowledgeBase,
+        const std::function<void ()>& registerAxiom)
+{
+    // A repeated axiom must neither be told to the reasoner nor be registered
+    // again, otherwise removing the contained axiom leaves the fact in place
+    OWLAxiom::Ptr containedAxiom = mpOntology->findAxiom(*axiom);
+    if(containedAxiom)
+    {
+        return dynamic_pointer_cast<T>(containedAxiom);
+    }
+
+    if(tellKnowledgeBase)
+    {
+        reasoner::factpp::Axiom kbAxiom = tellKnowledgeBase();
+        if(registerAxiom)
+        {
+            registerAxiom();
+        }
+        return dynamic_pointer_cast<T>(addAxiom(axiom, kbAxiom));
+    }
+
+    if(registerAxiom)
+    {
+        registerAxiom();
+    }
+    return dynamic_pointer_cast<T>(addAxiom(axiom));
 }
 
 OWLAxiom::Ptr OWLOntologyTell::addAxiom(const OWLAxiom::Ptr& axiom, const reasoner::factpp::Axiom& kbAxiom)
 {
+    OWLAxiom::Ptr containedAxiom = addAxiom(axiom);
+    if(containedAxiom != axiom)
+    {
+        // The contained axiom already holds the reference to the fact in the
+        // knowledge base, so drop the duplicate
+        mpOntology->kb()->retract(kbAxiom);
+        return containedAxiom;
+    }
     mpOntology->kb()->addReference(axiom, kbAxiom);
-    addAxiom(axiom);
     return axiom;
 }
 
@@ -436,14 +478,11 @@ OWLAxiom::Ptr OWLOntologyTell::equalClasses(const IRIList& klasses)
         pKlasses.push_back(pKlass);
     }
     OWLEquivalentClassesAxiom::Ptr axiom = make_shared<OWLEquivalentClassesAxiom>(pKlasses);
-    reasoner::factpp::Axiom kb_axiom = mpOntology->kb()->equalClasses(klasses);
-    addAxiom(axiom, kb_axiom);
-    return axiom;
+    return addUnique<OWLAxiom>(axiom, [&]() { return mpOntology->kb()->equalClasses(klasses); });
 }
 
 OWLAxiom::Ptr OWLOntologyTell::equalObjectProperties(const IRIList& properties)
 {
-    reasoner::factpp::Axiom kb_axiom = mpOntology->kb()->equalObjectProperties(properties);
     OWLObjectPropertyExpression::PtrList pProperties;
     for(const IRI& p : properties)
     {
@@ -451,13 +490,11 @@ OWLAxiom::Ptr OWLOntologyTell::equalObjectProperties(const IRIList& properties)
         pProperties.push_back(pProperty);
     }
     OWLEquivalentObjectPropertiesAxiom::Ptr axiom = make_shared<OWLEquivalentObjectPropertiesAxiom>(pProperties);
-    addAxiom(axiom, kb_axiom);
-    return axiom;
+    return addUnique<OWLAxiom>(axiom, [&]() { return mpOntology->kb()->equalObjectProperties(properties); });
 }
 
 OWLAxiom::Ptr OWLOntologyTell::equalDataProperties(const IRIList& properties)
 {
-    reasoner::factpp::Axiom kb_axiom = mpOntology->kb()->equalDataProperties(properties);
     OWLDataPropertyExpression::PtrList pProperties;
     for(const IRI& p : properties)
     {
@@ -465,13 +502,11 @@ OWLAxiom::Ptr OWLOntologyTell::equalDataProperties(const IRIList& properties)
         pProperties.push_back(pProperty);
     }
     OWLEquivalentDataPropertiesAxiom::Ptr axiom = make_shared<OWLEquivalentDataPropertiesAxiom>(pProperties);
-    addAxiom(axiom, kb_axiom);
-    return axiom;
+    return addUnique<OWLAxiom>(axiom, [&]() { return mpOntology->kb()->equalDataProperties(properties); });
 }
 
 OWLAxiom::Ptr OWLOntologyTell::disjointObjectProperties(const IRIList& properties)
 {
-    reasoner::factpp::Axiom kb_axiom = mpOntology->kb()->disjointObjectProperties(properties);
     OWLObjectPropertyExpression::PtrList pProperties;
     for(const IRI& p : properties)
     {
@@ -479,13 +514,11 @@ OWLAxiom::Ptr OWLOntologyTell::disjointObjectProperties(const IRIList& propertie
         pProperties.push_back(pProperty);
     }
     OWLDisjointObjectPropertiesAxiom::Ptr axiom = make_shared<OWLDisjointObjectPropertiesAxiom>(pProperties);
-    addAxiom(axiom, kb_axiom);
-    return axiom;
+    return addUnique<OWLAxiom>(axiom, [&]() { return mpOntology->kb()->disjointObjectProperties(properties); });
 }
 
 OWLAxiom::Ptr OWLOntologyTell::disjointDataProperties(const IRIList& properties)
 {
-    reasoner::factpp::Axiom kb_axiom = mpOntology->kb()->disjointDataProperties(properties);
     OWLDataPropertyExpression::PtrList pProperties;
     for(const IRI& p : properties)
     {
@@ -493,13 +526,11 @@ OWLAxiom::Ptr OWLOntologyTell::disjointDataProperties(const IRIList& properties)
         pProperties.push_back(pProperty);
     }
     OWLDisjointDataPropertiesAxiom::Ptr axiom = make_shared<OWLDisjointDataPropertiesAxiom>(pProperties);
-    addAxiom(axiom, kb_axiom);
-    return axiom;
+    return addUnique<OWLAxiom>(axiom, [&]() { return mpOntology->kb()->disjointDataProperties(properties); });
 }
 
 OWLAxiom::Ptr OWLOntologyTell::disjointClasses(const IRIList& klasses)
 {
-    reasoner::factpp::Axiom kb_axiom = mpOntology->kb()->disjoint(klasses, KnowledgeBase::CLASS);
     OWLClassExpression::PtrList pKlasses;
     for(const IRI& classType : klasses)
     {
@@ -507,13 +538,11 @@ OWLAxiom::Ptr OWLOntologyTell::disjointClasses(const IRIList& klasses)
         pKlasses.push_back(pKlass);
     }
     OWLDisjointClassesAxiom::Ptr axiom = make_shared<OWLDisjointClassesAxiom>(pKlasses);
-    addAxiom(axiom, kb_axiom);
-    return axiom;
+    return addUnique<OWLAxiom>(axiom, [&]() { return mpOntology->kb()->disjoint(klasses, KnowledgeBase::CLASS); });
 }
 
 OWLAxiom::Ptr OWLOntologyTell::disjointUnion(const IRI& unionClass, const IRIList& disjointKlasses)
 {
-    reasoner::factpp::Axiom kb_axiom = mpOntology->kb()->disjointUnion(unionClass, disjointKlasses);
     OWLClassExpression::PtrList pKlasses;
     for(const IRI& classType : disjointKlasses)
     {
@@ -522,31 +551,27 @@ OWLAxiom::Ptr OWLOntologyTell::disjointUnion(const IRI& unionClass, const IRILis
     }
 
     OWLDisjointUnionAxiom::Ptr axiom = make_shared<OWLDisjointUnionAxiom>(klass(unionClass), pKlasses);
-    addAxiom(axiom, kb_axiom);
-    return axiom;
+    return addUnique<OWLAxiom>(axiom, [&]() { return mpOntology->kb()->disjointUnion(unionClass, disjointKlasses); });
 }
 
 
 OWLClassAssertionAxiom::Ptr OWLOntologyTell::instanceOf(const IRI& instance, const IRI& classType)
 {
-    // Update reasoner kb
-    reasoner::factpp::Axiom kb_axiom = mpOntology->kb()->instanceOf(instance, classType);
-
     // ClassAssertion
     OWLNamedIndividual::Ptr e_individual = namedIndividual(instance);
     OWLClassExpression::Ptr e_class = klass(classType);
     OWLClassAssertionAxiom::Ptr axiom = make_shared<OWLClassAssertionAxiom>(e_individual, e_class);
 
-    // Register
-    mpOntology->mClassAssertionAxiomsByClass[e_class].push_back(axiom);
-    mpOntology->mClassAssertionAxiomsByIndividual[e_individual].push_back(axiom);
-    mpOntology->mNamedIndividualAxioms[e_individual].push_back(axiom);
-
     LOG_DEBUG_S << "NamedIndividual '" << instance << "' of class: '" << classType << "'";
 
-    addAxiom( axiom, kb_axiom );
-
-    return axiom;
+    return addUnique<OWLClassAssertionAxiom>(axiom,
+            [&]() { return mpOntology->kb()->instanceOf(instance, classType); },
+            [&]()
+            {
+                mpOntology->mClassAssertionAxiomsByClass[e_class].insert(axiom);
+                mpOntology->mClassAssertionAxiomsByIndividual[e_individual].insert(axiom);
+                mpOntology->mNamedIndividualAxioms[e_individual].insert(axiom);
+            });
 }
 
 OWLAxiom::Ptr OWLOntologyTell::inverseFunctionalProperty(const IRI& property)
@@ -605,17 +630,13 @@ OWLAxiom::Ptr OWLOntologyTell::relatedTo(const IRI& subject, const IRI& relation
         return annotationOf(subject, relation, object);
     }
 
-    mpOntology->kb()->relatedTo(subject, relation, object);
-
     LOG_DEBUG_S << "Add relation: " << std::endl
         << "    s: " << subject << std::endl
         << "    p: " << relation << std::endl
         << "    o: " << object << std::endl;
 
-    OWLIndividual::Ptr individual;
-    try {
-         individual = mpOntology->getIndividual(subject);
-    } catch(...)
+    OWLIndividual::Ptr individual = mpOntology->findIndividual(subject);
+    if(!individual)
     {
         // punning is allowed -- so auto-declare named individual
         if(mAsk.isOWLClass(subject) || mAsk.isDataProperty(subject) || mAsk.isObjectProperty(subject))
@@ -623,16 +644,16 @@ OWLAxiom::Ptr OWLOntologyTell::relatedTo(const IRI& subject, const IRI& relation
             individual = namedIndividual(subject);
         } else {
             LOG_DEBUG_S << "Checked for punning: '" << subject << "', but its not a known class or property";
-            throw;
+            throw std::invalid_argument("owlapi::model::OWLOntologyTell::relatedTo: "
+                    "subject '" + subject.toString() + "' is not a known individual");
         }
     }
 
-    OWLPropertyAssertionObject::Ptr assertionObject;
-    try {
-        assertionObject = mpOntology->getIndividual(object);
-        LOG_DEBUG_S << "    o: from known individual" << std::endl;
-    } catch(...)
+    OWLPropertyAssertionObject::Ptr assertionObject = mpOntology->findIndividual(object);
+    if(assertionObject)
     {
+        LOG_DEBUG_S << "    o: from known individual" << std::endl;
+    } else {
         assertionObject = OWLLiteral::create(object.toString());
         LOG_DEBUG_S << "    o: as literal" << std::endl;
     }
@@ -643,7 +664,7 @@ OWLAxiom::Ptr OWLOntologyTell::relatedTo(const IRI& subject, const IRI& relation
                     individual,
                     mpOntology->getObjectProperty(relation),
                     assertionObject);
-        return addAxiom(axiom);
+        return addUnique<OWLAxiom>(axiom, [&]() { return mpOntology->kb()->relatedTo(subject, relation, object); });
 
     } else if(mAsk.isDataProperty(relation))
     {
@@ -651,7 +672,7 @@ OWLAxiom::Ptr OWLOntologyTell::relatedTo(const IRI& subject, const IRI& relation
                     individual,
                     mpOntology->getDataProperty(relation),
                     dynamic_pointer_cast<OWLLiteral>(assertionObject) );
-        return addAxiom(axiom);
+        return addUnique<OWLAxiom>(axiom, [&]() { return mpOntology->kb()->relatedTo(subject, relation, object); });
     } else {
         throw std::runtime_error("owlapi::model::OWLOntologyTell::relatedTo: "
                 "'" + relation.toString() + "' is not a known relation/property");
@@ -685,18 +706,14 @@ OWLSubPropertyAxiom::Ptr OWLOntologyTell::subPropertyOf(const IRI& subProperty,
 
     } else if(mAsk.isAnnotationProperty(parentProperty))
     {
-        OWLAnnotationProperty::Ptr subAProperty;
-        try {
-            subAProperty = mpOntology->getAnnotationProperty(subProperty);
-        } catch(const std::invalid_argument& e)
+        OWLAnnotationProperty::Ptr subAProperty = mpOntology->findAnnotationProperty(subProperty);
+        if(!subAProperty)
         {
             subAProperty = annotationProperty(subProperty);
         }
 
-        OWLAnnotationProperty::Ptr superAProperty;
-        try {
-            superAProperty = mpOntology->getAnnotationProperty(parentProperty);
-        } catch(const std::invalid_argument& e)
+        OWLAnnotationProperty::Ptr superAProperty = mpOntology->findAnnotationProperty(parentProperty);
+        if(!superAProperty)
         {
             superAProperty = annotationProperty(parentProperty);
         }
@@ -839,8 +856,7 @@ OWLClassExpression::Ptr OWLOntologyTell::dataPropertyRestriction(const IRI& id,
             break;
     }
 
-    mpOntology->mAnonymousClassExpressions[id] = r;
-    return r;
+    return mpOntology->setAnonymousClassExpression(id, r);
 }
 
 OWLAxiom::Ptr OWLOntologyTell::dataPropertyRangeOf(const IRI& property, const IRI& classType)
@@ -890,8 +906,7 @@ OWLClassExpression::Ptr OWLOntologyTell::objectOneOf(
 
     OWLObjectOneOf::Ptr ce = make_shared<OWLObjectOneOf>(individuals);
     mpOntology->kb()->objectOneOf(id, instances);
-    mpOntology->mAnonymousClassExpressions[id] = dynamic_pointer_cast<OWLAnonymousClassExpression>(ce);
-    return dynamic_pointer_cast<OWLClassExpression>(ce);
+    return mpOntology->setAnonymousClassExpression(id, ce);
 }
 
 OWLClassExpression::Ptr OWLOntologyTell::objectIntersectionOf(
@@ -909,8 +924,7 @@ OWLClassExpression::Ptr OWLOntologyTell::objectIntersectionOf(
 
     mpOntology->kb()->objectIntersectionOf(id, klasses);
 
-    mpOntology->mAnonymousClassExpressions[id] = dynamic_pointer_cast<OWLAnonymousClassExpression>(intersection);
-    return dynamic_pointer_cast<OWLClassExpression>(intersection);
+    return mpOntology->setAnonymousClassExpression(id, intersection);
 }
 
 OWLClassExpression::Ptr OWLOntologyTell::objectUnionOf(
@@ -928,8 +942,7 @@ OWLClassExpression::Ptr OWLOntologyTell::objectUnionOf(
 
     mpOntology->kb()->objectUnionOf(id, klasses);
 
-    mpOntology->mAnonymousClassExpressions[id] = dynamic_pointer_cast<OWLAnonymousClassExpression>(unionOf);
-    return dynamic_pointer_cast<OWLClassExpression>(unionOf);
+    return mpOntology->setAnonymousClassExpression(id, unionOf);
 }
 
 OWLClassExpression::Ptr OWLOntologyTell::objectComplementOf(
@@ -943,8 +956,7 @@ OWLClassExpression::Ptr OWLOntologyTell::objectComplementOf(
 
     mpOntology->kb()->objectComplementOf(id, klass);
 
-    mpOntology->mAnonymousClassExpressions[id] = dynamic_pointer_cast<OWLAnonymousClassExpression>(ce);
-    return dynamic_pointer_cast<OWLClassExpression>(ce);
+    return mpOntology->setAnonymousClassExpression(id, complementOf);
 }
 
 OWLClassExpression::Ptr OWLOntologyTell::objectPropertyRestriction(
@@ -1077,8 +1089,7 @@ OWLClassExpression::Ptr OWLOntologyTell::objectPropertyRestriction(
             break;
     }
 
-    mpOntology->mAnonymousClassExpressions[id] = r;
-    return r;
+    return mpOntology->setAnonymousClassExpression(id, r);
 }
 
 OWLAxiom::Ptr OWLOntologyTell::objectPropertyDomainOf(const IRI& relation, const IRI& classType)
@@ -1294,7 +1305,7 @@ OWLDataType::Ptr OWLOntologyTell::datatype(const IRI& iri)
     {
         return cit->second;
     } else {
-        OWLDataType::Ptr dataType = make_shared<OWLDataType>(iri);
+        OWLDataType::Ptr dataType = create<OWLDataType>(iri);
         mpOntology->kb()->dataType(iri);
         mpOntology->mDataTypes[iri] = dataType;
         return dataType;
@@ -1,6 +1,7 @@
 #ifndef OWLAPI_MODEL_OWL_ONTOLOGY_TELL_HPP
 #define OWLAPI_MODEL_OWL_ONTOLOGY_TELL_HPP
 
+#include <functional>
 #include <stdexcept>
 #include "OWLOntology.hpp"
 #include "OWLLiteral.hpp"
@@ -35,9 +36,49 @@ class OWLOntologyTell
 
     /**
      * Add an axiom and the axiom it referenced in the knowledgebase
+     * \details If a structurally equal axiom has already been added, the
+     * knowledgebase axiom is retracted again
+     * \return the axiom contained in the ontology
      */
     OWLAxiom::Ptr addAxiom(const OWLAxiom::Ptr& axiom, const owlapi::reasoner::factpp::Axiom& kbAxiom);
 
+    /**
+     * Add an axiom unless a structurally equal axiom is already contained
+     * \param tellKnowledgeBase Tells the knowledgebase about a new axiom and
+     * returns the knowledgebase axiom, if set
+     * \param registerAxiom Registers a new axiom in the indexes of the
+     * ontology, if set
+     * \return the contained axiom, without telling the knowledgebase if a
+     * duplicate has been added before
+     */
+    template<typename T>
+    typename T::Ptr addUnique(const typename T::Ptr& axiom,
+            const std::function<owlapi::reasoner::factpp::Axiom ()>& tellKnowledgeBase,
+            const std::function<void ()>& registerAxiom = std::function<void ()>());
+
+    /**
+     * Declare the subclass relationship between two class expressions and
+     * tell the knowledgebase, if a new axiom has been added
+     */
+    OWLSubClassOfAxiom::Ptr subClassOf(const OWLClassExpression::Ptr& subclassExpression,
+                const OWLClassExpression::Ptr& superclassExpression,
+                const std::function<owlapi::reasoner::factpp::Axiom ()>& tellKnowledgeBase);
+
+    /**
+     * Create a model object in the object arena of the ontology
+     * \details The arena does not reclaim the memory of released objects, so
+     * it is only used for entities, which live as long as the ontology.
+     * Axioms and class expressions can be removed, replaced or discarded as
+     * duplicates after the lookup; they are created with make_shared instead,
+     * together with the values they own
+     * \see ObjectArena
+     */
+    template<typename T, typename... Args>
+    shared_ptr<T> create(Args&&... args) const
+    {
+        return allocate_shared<T>(ArenaAllocator<T>(mpOntology->mObjectArena), std::forward<Args>(args)...);
+    }
+
 public:
     typedef shared_ptr<OWLOntologyTell> Ptr;
 
@@ -164,7 +205,9 @@ public:
 
     /**
      * Create a cardinality restriction (for consistency reasons)
-     * \see OWLCardinalityRestriction
+     * \details Structurally equal restrictions are the same instance, which
+     * therefore must not be modified; use clone() instead
+     * \see OWLCardinalityRestriction, OWLClassExpressionPool
      * \return restriction
      */
     OWLCardinalityRestriction::Ptr objectCardinalityRestriction(
@@ -177,7 +220,8 @@ public:
     /**
      * Add an axiom
      * \param axiom
-     * \return the added axiom
+     * \return the added axiom, or the structurally equal axiom which has been
+     * added before
      */
     OWLAxiom::Ptr addAxiom(const OWLAxiom::Ptr& axiom);
 
@@ -269,6 +313,11 @@ public:
 
     OWLClassExpression::Ptr dataPropertyRestriction(const IRI& id, const OWLDataRestriction::Ptr& r);
 
+    /**
+     * Register an anonymous class expression with an (anonymous) id
+     * \return the canonical instance of the expression, i.e. structurally
+     * equal expressions are the same instance
+     */
     OWLClassExpression::Ptr objectOneOf(
             const IRI& id,
             const owlapi::model::IRIList& instances
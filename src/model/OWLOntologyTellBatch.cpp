@@ -0,0 +1,268 @@
+#include "OWLOntologyTellBatch.hpp"
+#include <algorithm>
+#include <unordered_set>
+#include <base-logging/Logging.hpp>
+#include "../KnowledgeBase.hpp"
+#include "OWLObjectPropertyAssertionAxiom.hpp"
+
+namespace owlapi {
+namespace model {
+
+OWLOntologyTellBatch::OWLOntologyTellBatch(OWLOntology::Ptr ontology, const IRI& origin)
+    : mpOntology(ontology)
+    , mTell(ontology, origin)
+{}
+
+void OWLOntologyTellBatch::instanceOf(const IRI& instance, const IRI& classType)
+{
+    Assertion assertion = { INSTANCE_OF, instance, IRI(), classType, OWLLiteral::Ptr() };
+    mAssertions.push_back(assertion);
+}
+
+void OWLOntologyTellBatch::relatedTo(const IRI& subject, const IRI& relation, const IRI& object)
+{
+    Assertion assertion = { RELATED_TO, subject, relation, object, OWLLiteral::Ptr() };
+    mAssertions.push_back(assertion);
+}
+
+void OWLOntologyTellBatch::valueOf(const IRI& instance, const IRI& dataProperty, const OWLLiteral::Ptr& literal)
+{
+    if(!literal)
+    {
+        throw std::invalid_argument("owlapi::model::OWLOntologyTellBatch::valueOf: no literal given for '"
+                + instance.toString() + "' and '" + dataProperty.toString() + "'");
+    }
+    Assertion assertion = { VALUE_OF, instance, dataProperty, IRI(), literal };
+    mAssertions.push_back(assertion);
+}
+
+std::vector<OWLOntologyTellBatch::Assertion> OWLOntologyTellBatch::deduplicate() const
+{
+    std::vector<Assertion> assertions;
+    assertions.reserve(mAssertions.size());
+
+    std::unordered_set<std::string> keys;
+    keys.reserve(mAssertions.size());
+    // Iterate backwards, since the last value assertion replaces all
+    // previous ones
+    for(std::vector<Assertion>::const_reverse_iterator it = mAssertions.rbegin();
+            it != mAssertions.rend(); ++it)
+    {
+        std::string key = std::to_string(it->type) + "\n"
+            + it->subject.toString() + "\n"
+            + it->predicate.toString();
+        if(it->type != VALUE_OF)
+        {
+            key += "\n" + it->object.toString();
+        }
+
+        if(keys.insert(key).second)
+        {
+            assertions.push_back(*it);
+        }
+    }
+    std::reverse(assertions.begin(), assertions.end());
+    return assertions;
+}
+
+std::vector<OWLOntologyTellBatch::Assertion> OWLOntologyTellBatch::resolve(std::vector<Assertion>& assertions) const
+{
+    std::vector<Assertion> annotations;
+
+    IRISet batchIndividuals;
+    for(const Assertion& assertion : assertions)
+    {
+        if(assertion.type == INSTANCE_OF)
+        {
+            batchIndividuals.insert(assertion.subject);
+        }
+    }
+
+    std::vector<Assertion> resolved;
+    resolved.reserve(assertions.size());
+    for(Assertion& assertion : assertions)
+    {
+        switch(assertion.type)
+        {
+            case INSTANCE_OF:
+                resolved.push_back(assertion);
+                break;
+            case RELATED_TO:
+                if(mpOntology->findAnnotationProperty(assertion.predicate))
+                {
+                    if(assertion.object.empty())
+                    {
+                        throw std::invalid_argument("owlapi::model::OWLOntologyTellBatch::commit: "
+                                "empty property value for subject '" + assertion.subject.toString()
+                                + "' and relation '" + assertion.predicate.toString() + "'");
+                    }
+                    annotations.push_back(assertion);
+                    break;
+                }
+                if(mpOntology->findDataProperty(assertion.predicate))
+                {
+                    assertion.type = VALUE_OF;
+                    assertion.literal = OWLLiteral::create(assertion.object.toString());
+                    resolved.push_back(assertion);
+                    break;
+                }
+                if(!mpOntology->findObjectProperty(assertion.predicate))
+                {
+                    throw std::invalid_argument("owlapi::model::OWLOntologyTellBatch::commit: "
+                            "'" + assertion.predicate.toString() + "' is not a known relation/property");
+                }
+                // punning is allowed -- so the subject might be a class or property
+                if(!mpOntology->findIndividual(assertion.subject)
+                        && !batchIndividuals.count(assertion.subject)
+                        && !mpOntology->findClass(assertion.subject)
+                        && !mpOntology->findDataProperty(assertion.subject)
+                        && !mpOntology->findObjectProperty(assertion.subject))
+                {
+                    throw std::invalid_argument("owlapi::model::OWLOntologyTellBatch::commit: "
+                            " no individual '" + assertion.subject.toString() + "' known");
+                }
+                resolved.push_back(assertion);
+                break;
+            case VALUE_OF:
+                if(!mpOntology->findDataProperty(assertion.predicate))
+                {
+                    throw std::invalid_argument("owlapi::model::OWLOntologyTellBatch::commit: "
+                            "'" + assertion.predicate.toString() + "' is not a known data property");
+                }
+                resolved.push_back(assertion);
+                break;
+        }
+    }
+
+    // Add the class assertions first, so that the property assertions can
+    // refer to the individuals declared by them
+    std::stable_partition(resolved.begin(), resolved.end(), [](const Assertion& assertion)
+            {
+                return assertion.type == INSTANCE_OF;
+            });
+    assertions.swap(resolved);
+    return annotations;
+}
+
+OWLAxiom::PtrList OWLOntologyTellBatch::commit(bool refresh)
+{
+    std::vector<Assertion> assertions = deduplicate();
+    std::vector<Assertion> annotations = resolve(assertions);
+
+    OWLAxiom::PtrList addedAxioms;
+    addedAxioms.reserve(assertions.size() + annotations.size());
+    for(const Assertion& assertion : assertions)
+    {
+        OWLAxiom::Ptr axiom;
+        switch(assertion.type)
+        {
+            case INSTANCE_OF:
+                axiom = addInstanceOf(assertion);
+                break;
+            case RELATED_TO:
+                axiom = addRelatedTo(assertion);
+                break;
+            case VALUE_OF:
+                axiom = addValueOf(assertion);
+                break;
+        }
+        if(axiom)
+        {
+            addedAxioms.push_back(axiom);
+        }
+    }
+
+    for(const Assertion& assertion : annotations)
+    {
+        size_t numberOfAxioms = mpOntology->mAxiomsByType[OWLAxiom::AnnotationAssertion].size();
+        OWLAxiom::Ptr axiom = mTell.annotationOf(assertion.subject, assertion.predicate, assertion.object);
+        if(mpOntology->mAxiomsByType[OWLAxiom::AnnotationAssertion].size() != numberOfAxioms)
+        {
+            addedAxioms.push_back(axiom);
+        }
+    }
+
+    LOG_DEBUG_S << "Committed batch of " << mAssertions.size() << " assertions: "
+        << addedAxioms.size() << " new axioms";
+    mAssertions.clear();
+
+    if(refresh && !addedAxioms.empty())
+    {
+        mpOntology->refresh();
+    }
+    return addedAxioms;
+}
+
+OWLAxiom::Ptr OWLOntologyTellBatch::addInstanceOf(const Assertion& assertion)
+{
+    OWLNamedIndividual::Ptr e_individual = mTell.namedIndividual(assertion.subject);
+    OWLClass::Ptr e_class = mTell.klass(assertion.object);
+    OWLClassAssertionAxiom::Ptr axiom = make_shared<OWLClassAssertionAxiom>(e_individual, e_class);
+    if(mpOntology->addAxiom(axiom) != axiom)
+    {
+        return OWLAxiom::Ptr();
+    }
+
+    mpOntology->mClassAssertionAxiomsByClass[e_class].insert(axiom);
+    mpOntology->mClassAssertionAxiomsByIndividual[e_individual].insert(axiom);
+    mpOntology->mNamedIndividualAxioms[e_individual].insert(axiom);
+
+    reasoner::factpp::Axiom kbAxiom = mpOntology->kb()->instanceOf(assertion.subject, assertion.object);
+    mpOntology->kb()->addReference(axiom, kbAxiom);
+    return axiom;
+}
+
+OWLAxiom::Ptr OWLOntologyTellBatch::addRelatedTo(const Assertion& assertion)
+{
+    OWLIndividual::Ptr individual = mpOntology->findIndividual(assertion.subject);
+    if(!individual)
+    {
+        individual = mTell.namedIndividual(assertion.subject);
+    }
+
+    OWLPropertyAssertionObject::Ptr assertionObject = mpOntology->findIndividual(assertion.object);
+    if(!assertionObject)
+    {
+        assertionObject = OWLLiteral::create(assertion.object.toString());
+    }
+
+    OWLObjectPropertyAssertionAxiom::Ptr axiom = make_shared<OWLObjectPropertyAssertionAxiom>(
+            individual,
+            mpOntology->getObjectProperty(assertion.predicate),
+            assertionObject);
+    if(mpOntology->addAxiom(axiom) != axiom)
+    {
+        return OWLAxiom::Ptr();
+    }
+
+    reasoner::factpp::Axiom kbAxiom = mpOntology->kb()->relatedTo(assertion.subject, assertion.predicate, assertion.object);
+    mpOntology->kb()->addReference(axiom, kbAxiom);
+    return axiom;
+}
+
+OWLAxiom::Ptr OWLOntologyTellBatch::addValueOf(const Assertion& assertion)
+{
+    OWLIndividual::Ptr individual = mpOntology->findIndividual(assertion.subject);
+    if(!individual)
+    {
+        individual = mTell.anonymousIndividual(assertion.subject);
+    }
+    OWLDataProperty::Ptr property = mpOntology->getDataProperty(assertion.predicate);
+    OWLDataPropertyAssertionAxiom::Ptr axiom = make_shared<OWLDataPropertyAssertionAxiom>(individual, property, assertion.literal);
+
+    // the value is already known -- neither model nor reasoner need an update
+    if(mpOntology->mAxiomsByType[OWLAxiom::DataPropertyAssertion].contains(*axiom))
+    {
+        return OWLAxiom::Ptr();
+    }
+
+    mpOntology->retractValueOf(individual, property);
+    mpOntology->addAxiom(axiom);
+
+    reasoner::factpp::Axiom kbAxiom = mpOntology->kb()->valueOf(assertion.subject, assertion.predicate, assertion.literal);
+    mpOntology->kb()->addReference(axiom, kbAxiom);
+    return axiom;
+}
+
+} // end namespace model
+} // end namespace owlapi
@@ -0,0 +1,127 @@
+#ifndef OWLAPI_MODEL_OWL_ONTOLOGY_TELL_BATCH_HPP
+#define OWLAPI_MODEL_OWL_ONTOLOGY_TELL_BATCH_HPP
+
+#include <vector>
+#include "OWLOntologyTell.hpp"
+
+namespace owlapi {
+namespace model {
+
+/**
+ * \class OWLOntologyTellBatch
+ * \brief Collects assertions and adds them to an ontology at once
+ * \details Assertions are only queued until commit is called. The commit
+ * drops duplicates, resolves each involved entity and property only once,
+ * pushes only axioms which are new to the ontology into the reasoner and
+ * refreshes the reasoner at most once.
+ *
+ * \verbatim
+ OWLOntologyTellBatch batch(ontology);
+ batch.reserve(facts.size());
+ for(const Fact& fact : facts)
+ {
+     batch.relatedTo(fact.subject, fact.relation, fact.object);
+ }
+ batch.commit();
+ \endverbatim
+ */
+class OWLOntologyTellBatch
+{
+public:
+    typedef shared_ptr<OWLOntologyTellBatch> Ptr;
+
+    /**
+     * \param ontology OWLOntology to populate
+     * \param origin optional source IRI of the assertions
+     * \see OWLOntologyTell::OWLOntologyTell
+     */
+    OWLOntologyTellBatch(OWLOntology::Ptr ontology, const IRI& origin = IRI());
+
+    /**
+     * Reserve space for the given number of assertions
+     */
+    void reserve(size_t numberOfAssertions) { mAssertions.reserve(numberOfAssertions); }
+
+    /**
+     * Queue a class assertion
+     * \see OWLOntologyTell::instanceOf
+     */
+    void instanceOf(const IRI& instance, const IRI& classType);
+
+    /**
+     * Queue a property assertion
+     * \details If relation is a data property, the assertion is handled as
+     * valueOf assertion with a literal created from object
+     * \see OWLOntologyTell::relatedTo
+     */
+    void relatedTo(const IRI& subject, const IRI& relation, const IRI& object);
+
+    /**
+     * Queue a data property assertion, which replaces an existing value
+     * \see OWLOntologyTell::valueOf
+     */
+    void valueOf(const IRI& instance, const IRI& dataProperty, const OWLLiteral::Ptr& literal);
+
+    /**
+     * Get the number of queued assertions
+     */
+    size_t size() const { return mAssertions.size(); }
+
+    bool empty() const { return mAssertions.empty(); }
+
+    /**
+     * Discard all queued assertions
+     */
+    void clear() { mAssertions.clear(); }
+
+    /**
+     * Add all queued assertions to the ontology
+     * \details All assertions are validated before the ontology is modified,
+     * so that a failing commit leaves ontology and batch untouched
+     * \param refresh Set to true to refresh the reasoner once all axioms
+     * have been added
+     * \return the axioms which have been added to the ontology, i.e.
+     * excluding the ones the ontology already contained
+     * \throw std::invalid_argument if an assertion refers to an unknown
+     * property or individual
+     */
+    OWLAxiom::PtrList commit(bool refresh = true);
+
+private:
+    enum AssertionType { INSTANCE_OF, RELATED_TO, VALUE_OF };
+
+    struct Assertion
+    {
+        AssertionType type;
+        IRI subject;
+        IRI predicate;
+        IRI object;
+        OWLLiteral::Ptr literal;
+    };
+
+    /**
+     * Get the queued assertions without duplicates, for value assertions
+     * only the last one per individual and property is kept
+     */
+    std::vector<Assertion> deduplicate() const;
+
+    /**
+     * Resolve the type of each assertion, so that only assertions of type
+     * INSTANCE_OF, VALUE_OF and RELATED_TO via object properties remain
+     * \return the annotation assertions
+     * \throw std::invalid_argument if an assertion cannot be added
+     */
+    std::vector<Assertion> resolve(std::vector<Assertion>& assertions) const;
+
+    OWLAxiom::Ptr addInstanceOf(const Assertion& assertion);
+    OWLAxiom::Ptr addRelatedTo(const Assertion& assertion);
+    OWLAxiom::Ptr addValueOf(const Assertion& assertion);
+
+    OWLOntology::Ptr mpOntology;
+    OWLOntologyTell mTell;
+    std::vector<Assertion> mAssertions;
+};
+
+} // end namespace model
+} // end namespace owlapi
+#endif // OWLAPI_MODEL_OWL_ONTOLOGY_TELL_BATCH_HPP
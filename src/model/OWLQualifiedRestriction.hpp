@@ -66,6 +66,7 @@ protected:
      * allow incremental construction
      */
     void setQualification(const OWLQualification& qualification) {
+        requireUnshared("owlapi::model::OWLQualifiedRestriction::setQualification");
         mQualification = qualification;
         mQualified = !( mQualification == owlapi::vocabulary::OWL::Thing() || mQualification == owlapi::vocabulary::RDFS::Literal() );
     }
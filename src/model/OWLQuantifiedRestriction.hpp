@@ -34,6 +34,16 @@ public:
     }
 
     virtual ~OWLQuantifiedRestriction() = default;
+
+    /**
+     * Set the filler
+     * \throw std::runtime_error if this restriction is shared
+     */
+    void setFiller(const typename HasFiller<T>::filler_t& filler)
+    {
+        requireUnshared("owlapi::model::OWLQuantifiedRestriction::setFiller");
+        HasFiller<T>::setFiller(filler);
+    }
 };
 
 } // end namespace model
@@ -42,8 +42,13 @@ public:
 
     /**
      * Set property
+     * \throw std::runtime_error if this restriction is shared
      */
-    void setProperty(const OWLPropertyExpression::Ptr& property) { mpProperty = property; }
+    void setProperty(const OWLPropertyExpression::Ptr& property)
+    {
+        requireUnshared("owlapi::model::OWLRestriction::setProperty");
+        mpProperty = property;
+    }
 
     virtual bool isDataRestriction() const;
     virtual bool isObjectRestriction() const;
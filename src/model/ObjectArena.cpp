@@ -0,0 +1,60 @@
+#include "ObjectArena.hpp"
+#include <cstdint>
+
+namespace owlapi {
+namespace model {
+
+ObjectArena::ObjectArena(size_t blockSize)
+    : mBlockSize(blockSize)
+    , mCurrent(NULL)
+    , mAvailable(0)
+    , mAllocatedBytes(0)
+{}
+
+char* ObjectArena::addBlock(size_t size)
+{
+    mBlocks.push_back( std::unique_ptr<char[]>(new char[size]) );
+    return mBlocks.back().get();
+}
+
+void* ObjectArena::allocate(size_t size, size_t alignment)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mAllocatedBytes += size;
+
+    // Large objects get a block of their own, so that the current block is
+    // not abandoned
+    if(size > mBlockSize/4)
+    {
+        return addBlock(size);
+    }
+
+    size_t padding = (alignment - reinterpret_cast<uintptr_t>(mCurrent) % alignment) % alignment;
+    if(!mCurrent || padding + size > mAvailable)
+    {
+        // new[] returns memory suitable for any fundamental alignment
+        mCurrent = addBlock(mBlockSize);
+        mAvailable = mBlockSize;
+        padding = 0;
+    }
+
+    char* memory = mCurrent + padding;
+    mCurrent = memory + size;
+    mAvailable -= padding + size;
+    return memory;
+}
+
+size_t ObjectArena::getAllocatedBytes() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mAllocatedBytes;
+}
+
+size_t ObjectArena::getNumberOfBlocks() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mBlocks.size();
+}
+
+} // end namespace model
+} // end namespace owlapi
@@ -0,0 +1,114 @@
+#ifndef OWLAPI_MODEL_OBJECT_ARENA_HPP
+#define OWLAPI_MODEL_OBJECT_ARENA_HPP
+
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "../SharedPtr.hpp"
+
+namespace owlapi {
+namespace model {
+
+/**
+ * \class ObjectArena
+ * \brief Memory arena for the model objects of an ontology
+ * \details Objects are placed consecutively into large blocks of memory.
+ * Releasing an object does not free its memory: all blocks are freed at once
+ * when the arena is destroyed. The arena is therefore meant for objects which
+ * live about as long as the ontology, e.g. entities, axioms and class
+ * expressions.
+ * \see ArenaAllocator
+ */
+class ObjectArena
+{
+public:
+    typedef shared_ptr<ObjectArena> Ptr;
+
+    /**
+     * Create an empty arena
+     * \param blockSize Size of the memory blocks in bytes; allocations which
+     * exceed a quarter of the block size get a block of their own
+     */
+    ObjectArena(size_t blockSize = 64*1024);
+
+    /**
+     * Allocate memory from the current block
+     * \throw std::bad_alloc if no memory is available
+     */
+    void* allocate(size_t size, size_t alignment);
+
+    /**
+     * Get the number of bytes which have been allocated from this arena
+     */
+    size_t getAllocatedBytes() const;
+
+    /**
+     * Get the number of blocks which have been reserved by this arena
+     */
+    size_t getNumberOfBlocks() const;
+
+private:
+    ObjectArena(const ObjectArena&) = delete;
+    ObjectArena& operator=(const ObjectArena&) = delete;
+
+    char* addBlock(size_t size);
+
+    size_t mBlockSize;
+    std::vector< std::unique_ptr<char[]> > mBlocks;
+    /// Unused part of the current block
+    char* mCurrent;
+    size_t mAvailable;
+    size_t mAllocatedBytes;
+    mutable std::mutex mMutex;
+};
+
+/**
+ * \class ArenaAllocator
+ * \brief Standard allocator which allocates from an ObjectArena
+ * \details Each allocator keeps the arena alive, so that objects created via
+ * allocate_shared remain valid even if they outlive the ontology.
+ * Deallocation is a no-op, memory is released with the arena.
+ */
+template<typename T>
+class ArenaAllocator
+{
+public:
+    typedef T value_type;
+
+    ArenaAllocator(const ObjectArena::Ptr& arena)
+        : mArena(arena)
+    {}
+
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other)
+        : mArena(other.getArena())
+    {}
+
+    T* allocate(size_t n)
+    {
+        return static_cast<T*>( mArena->allocate(n*sizeof(T), alignof(T)) );
+    }
+
+    void deallocate(T*, size_t) {}
+
+    const ObjectArena::Ptr& getArena() const { return mArena; }
+
+private:
+    ObjectArena::Ptr mArena;
+};
+
+template<typename T, typename U>
+bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b)
+{
+    return a.getArena() == b.getArena();
+}
+
+template<typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b)
+{
+    return !(a == b);
+}
+
+} // end namespace model
+} // end namespace owlapi
+#endif // OWLAPI_MODEL_OBJECT_ARENA_HPP
@@ -0,0 +1,140 @@
+#ifndef OWLAPI_MODEL_PROPERTY_VALUE_INDEX_HPP
+#define OWLAPI_MODEL_PROPERTY_VALUE_INDEX_HPP
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+#include "IRI.hpp"
+
+namespace owlapi {
+namespace model {
+
+/**
+ * \class PropertyValueIndex
+ * \brief Values asserted for (subject, property) pairs
+ * \details Values are grouped by subject, so that the values of a single
+ * pair as well as all properties of a subject are found in constant time.
+ * The values of a pair are kept in the order they have been added.
+ */
+template<typename Value>
+class PropertyValueIndex
+{
+public:
+    typedef std::vector<Value> ValueList;
+
+    /**
+     * Add a value
+     */
+    void add(const IRI& subject, const IRI& property, const Value& value)
+    {
+        mValues[subject][property].push_back(value);
+    }
+
+    /**
+     * Find the values of a subject and property
+     * \return NULL if there is no value
+     */
+    const ValueList* find(const IRI& subject, const IRI& property) const
+    {
+        typename SubjectMap::const_iterator sit = mValues.find(subject);
+        if(sit == mValues.end())
+        {
+            return NULL;
+        }
+        typename PropertyMap::const_iterator pit = sit->second.find(property);
+        if(pit == sit->second.end())
+        {
+            return NULL;
+        }
+        return &pit->second;
+    }
+
+    /**
+     * Remove all values of a subject and property
+     * \return the removed values
+     */
+    ValueList take(const IRI& subject, const IRI& property)
+    {
+        ValueList values;
+        typename SubjectMap::iterator sit = mValues.find(subject);
+        if(sit == mValues.end())
+        {
+            return values;
+        }
+        typename PropertyMap::iterator pit = sit->second.find(property);
+        if(pit == sit->second.end())
+        {
+            return values;
+        }
+        values.swap(pit->second);
+        sit->second.erase(pit);
+        if(sit->second.empty())
+        {
+            mValues.erase(sit);
+        }
+        return values;
+    }
+
+    /**
+     * Remove a single value of a subject and property
+     * \return true if the value has been removed, false if it was not known
+     */
+    bool remove(const IRI& subject, const IRI& property, const Value& value)
+    {
+        typename SubjectMap::iterator sit = mValues.find(subject);
+        if(sit == mValues.end())
+        {
+            return false;
+        }
+        typename PropertyMap::iterator pit = sit->second.find(property);
+        if(pit == sit->second.end())
+        {
+            return false;
+        }
+        ValueList& values = pit->second;
+        typename ValueList::iterator vit = std::find(values.begin(), values.end(), value);
+        if(vit == values.end())
+        {
+            return false;
+        }
+        values.erase(vit);
+        if(values.empty())
+        {
+            sit->second.erase(pit);
+            if(sit->second.empty())
+            {
+                mValues.erase(sit);
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Get all properties for which the subject has values
+     */
+    IRIList getProperties(const IRI& subject) const
+    {
+        IRIList properties;
+        typename SubjectMap::const_iterator sit = mValues.find(subject);
+        if(sit != mValues.end())
+        {
+            for(const typename PropertyMap::value_type& p : sit->second)
+            {
+                properties.push_back(p.first);
+            }
+        }
+        return properties;
+    }
+
+    void clear() { mValues.clear(); }
+
+private:
+    typedef std::unordered_map<IRI, ValueList> PropertyMap;
+    typedef std::unordered_map<IRI, PropertyMap> SubjectMap;
+
+    SubjectMap mValues;
+};
+
+} // end namespace model
+} // end namespace owlapi
+#endif // OWLAPI_MODEL_PROPERTY_VALUE_INDEX_HPP
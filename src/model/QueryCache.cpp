@@ -1,26 +1,189 @@
 #include "QueryCache.hpp"
+#include <algorithm>
 
 namespace owlapi {
 namespace model {
 
+namespace {
+/// Innermost active dependency scope of the current thread
+thread_local QueryCache::DependencyScope* currentDependencyScope = NULL;
+}
+
+QueryCache::DependencyScope::DependencyScope()
+    : mpParent(currentDependencyScope)
+{
+    currentDependencyScope = this;
+}
+
+QueryCache::DependencyScope::~DependencyScope()
+{
+    currentDependencyScope = mpParent;
+    if(mpParent)
+    {
+        mpParent->add(mDependencies);
+    }
+}
+
+void QueryCache::DependencyScope::add(const IRI& iri)
+{
+    mDependencies.insert(iri);
+}
+
+void QueryCache::DependencyScope::add(const Dependencies& dependencies)
+{
+    mDependencies.insert(dependencies.begin(), dependencies.end());
+}
+
+void QueryCache::recordDependency(const IRI& iri)
+{
+    if(currentDependencyScope && !iri.empty())
+    {
+        currentDependencyScope->add(iri);
+    }
+}
+
+const size_t QueryCache::MIN_PURGE_SIZE;
+
+QueryCache::QueryCache(size_t maxEntries)
+    : mCardinalityRestrictions(maxEntries)
+    , mCardinalityRestrictionsOps(maxEntries)
+    , mSubClassing(maxEntries)
+    , mCardinalityBounds(0)
+    , mPurgeSize(MIN_PURGE_SIZE)
+{}
 
 void QueryCache::clear()
 {
     mCardinalityRestrictions.clear();
     mCardinalityRestrictionsOps.clear();
+    mSubClassing.clear();
+    mCardinalityBounds.clear();
+
+    std::lock_guard<std::mutex> lock(mTokenMutex);
+    mTokens.clear();
+    mPurgeSize = MIN_PURGE_SIZE;
 }
 
-std::pair<bool,bool> QueryCache::isSubClassOf(const IRI& iri, const IRI& otherIri) const
+void QueryCache::invalidate(const IRIList& entities)
+{
+    std::lock_guard<std::mutex> lock(mTokenMutex);
+    for(const IRI& entity : entities)
+    {
+        // Only entities that cached results depend on are tracked
+        std::unordered_map<IRI, weak_ptr<DependencyToken> >::iterator it = mTokens.find(entity);
+        if(it != mTokens.end())
+        {
+            if(shared_ptr<DependencyToken> token = it->second.lock())
+            {
+                token->valid = false;
+            }
+            mTokens.erase(it);
+        }
+    }
+}
+
+void QueryCache::invalidateSubClassRelations()
+{
+    mSubClassing.clear();
+}
+
+QueryCache::TrackedDependencies QueryCache::track(const Dependencies& dependencies)
+{
+    TrackedDependencies trackedDependencies;
+    trackedDependencies.reserve(dependencies.size());
+
+    std::lock_guard<std::mutex> lock(mTokenMutex);
+    for(const IRI& dependency : dependencies)
+    {
+        weak_ptr<DependencyToken>& trackedToken = mTokens[dependency];
+        shared_ptr<DependencyToken> token = trackedToken.lock();
+        if(!token)
+        {
+            token = make_shared<DependencyToken>();
+            trackedToken = token;
+        }
+        trackedDependencies.push_back( std::make_pair(dependency, token) );
+    }
+
+    if(mTokens.size() >= mPurgeSize)
+    {
+        purge();
+    }
+    return trackedDependencies;
+}
+
+void QueryCache::purge()
+{
+    std::unordered_map<IRI, weak_ptr<DependencyToken> >::iterator it = mTokens.begin();
+    while(it != mTokens.end())
+    {
+        if(it->second.expired())
+        {
+            it = mTokens.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    // purge again only once the number of entities has doubled, which keeps
+    // the cost of purging constant per cached result
+    mPurgeSize = std::max(MIN_PURGE_SIZE, 2*mTokens.size());
+}
+
+bool QueryCache::isValid(const TrackedDependencies& dependencies) const
+{
+    for(const TrackedDependencies::value_type& dependency : dependencies)
+    {
+        if(!dependency.second->valid)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t QueryCache::getNumberOfDependencies() const
+{
+    std::lock_guard<std::mutex> lock(mTokenMutex);
+    return mTokens.size();
+}
+
+void QueryCache::setMaxEntries(size_t maxEntries)
 {
-    std::pair<bool, bool> result;
-    std::unordered_map< std::pair<IRI, IRI>, bool>::const_iterator cit = mSubClassing.find( std::pair<IRI,IRI>(iri, otherIri) );
-    if(cit != mSubClassing.end())
+    mCardinalityRestrictions.setMaxEntries(maxEntries);
+    mCardinalityRestrictionsOps.setMaxEntries(maxEntries);
+    mSubClassing.setMaxEntries(maxEntries);
+}
+
+QueryCache::Statistics QueryCache::getStatistics() const
+{
+    Statistics statistics;
+    std::vector<Statistics> categories = { mCardinalityRestrictions.getStatistics(),
+        mCardinalityRestrictionsOps.getStatistics(),
+        mSubClassing.getStatistics(),
+        mCardinalityBounds.getStatistics() };
+    for(const Statistics& category : categories)
     {
-        result.first = cit->second;
-        result.second = true;
-    } else {
-        result.second = false;
+        statistics.hits += category.hits;
+        statistics.misses += category.misses;
+        statistics.evictions += category.evictions;
+        statistics.invalidations += category.invalidations;
+        statistics.entries += category.entries;
     }
+    return statistics;
+}
+
+void QueryCache::resetStatistics()
+{
+    mCardinalityRestrictions.resetStatistics();
+    mCardinalityRestrictionsOps.resetStatistics();
+    mSubClassing.resetStatistics();
+    mCardinalityBounds.resetStatistics();
+}
+
+std::pair<bool,bool> QueryCache::isSubClassOf(const IRI& iri, const IRI& otherIri) const
+{
+    std::pair<bool, bool> result(false, false);
+    result.second = lookup(mSubClassing, std::pair<IRI,IRI>(iri, otherIri), result.first);
     return result;
 }
 
@@ -28,23 +191,18 @@ std::pair<OWLCardinalityRestriction::PtrList, bool> QueryCache::getCardinalityRe
         const IRI& objectProperty) const
 {
     std::pair<OWLCardinalityRestriction::PtrList, bool> result;
-    std::unordered_map< std::pair<IRI, IRI>, OWLCardinalityRestriction::PtrList >::const_iterator cit =
-    mCardinalityRestrictions.find( std::pair<IRI,IRI>(iri, objectProperty) );
-    if(cit != mCardinalityRestrictions.end())
-    {
-        result.first = cit->second;
-        result.second = true;
-    } else {
-        result.second = false;
-    }
+    result.second = lookup(mCardinalityRestrictions, std::pair<IRI,IRI>(iri, objectProperty), result.first);
     return result;
 }
 
 void QueryCache::cacheCardinalityRestrictions(const IRI& iri, const IRI& objectProperty,
-            const OWLCardinalityRestriction::PtrList& restrictions)
+            const OWLCardinalityRestriction::PtrList& restrictions,
+            const Dependencies& dependencies)
 {
-    mCardinalityRestrictions.emplace(std::pair<IRI, IRI>(iri, objectProperty), restrictions);
-
+    CachedResult<OWLCardinalityRestriction::PtrList> cachedResult;
+    cachedResult.result = restrictions;
+    cachedResult.dependencies = track(dependencies);
+    mCardinalityRestrictions.put(std::pair<IRI, IRI>(iri, objectProperty), cachedResult);
 }
 
 std::pair<OWLCardinalityRestriction::PtrList, bool> QueryCache::getCardinalityRestrictions(const IRIList& iris,
@@ -52,34 +210,49 @@ std::pair<OWLCardinalityRestriction::PtrList, bool> QueryCache::getCardinalityRe
         OWLCardinalityRestrictionOps::OperationType operationType) const
 {
     std::pair<OWLCardinalityRestriction::PtrList, bool> result;
-    std::unordered_map< std::tuple<IRIList, IRI, OWLCardinalityRestrictionOps::OperationType>, OWLCardinalityRestriction::PtrList >::const_iterator cit;
-
-    std::tuple<IRIList,IRI,OWLCardinalityRestrictionOps::OperationType> tpl = std::make_tuple(iris, objectProperty, operationType);
-    cit = mCardinalityRestrictionsOps.find(tpl);
-
-    if(cit != mCardinalityRestrictionsOps.end())
-    {
-        result.first = cit->second;
-        result.second = true;
-    } else {
-        result.second = false;
-    }
+    CardinalityRestrictionsOpsKey tpl = std::make_tuple(iris, objectProperty, operationType);
+    result.second = lookup(mCardinalityRestrictionsOps, tpl, result.first);
     return result;
 }
 
 void QueryCache::cacheCardinalityRestrictions(const IRIList& iris,
         const IRI& objectProperty,
         OWLCardinalityRestrictionOps::OperationType operationType,
-        const OWLCardinalityRestriction::PtrList& restrictions)
+        const OWLCardinalityRestriction::PtrList& restrictions,
+        const Dependencies& dependencies)
 {
-    std::tuple<IRIList,IRI,OWLCardinalityRestrictionOps::OperationType> tpl = std::make_tuple(iris, objectProperty, operationType);
-    mCardinalityRestrictionsOps.emplace(tpl,restrictions);
+    CachedResult<OWLCardinalityRestriction::PtrList> cachedResult;
+    cachedResult.result = restrictions;
+    cachedResult.dependencies = track(dependencies);
+    CardinalityRestrictionsOpsKey tpl = std::make_tuple(iris, objectProperty, operationType);
+    mCardinalityRestrictionsOps.put(tpl, cachedResult);
+}
 
+std::pair<QueryCache::CardinalityBounds, bool> QueryCache::getCardinalityBounds(const IRI& iri,
+        const IRI& objectProperty) const
+{
+    std::pair<CardinalityBounds, bool> result;
+    result.second = lookup(mCardinalityBounds, std::pair<IRI,IRI>(iri, objectProperty), result.first);
+    return result;
+}
+
+void QueryCache::cacheCardinalityBounds(const IRI& iri, const IRI& objectProperty,
+        const CardinalityBounds& bounds,
+        const Dependencies& dependencies)
+{
+    CachedResult<CardinalityBounds> cachedResult;
+    cachedResult.result = bounds;
+    cachedResult.dependencies = track(dependencies);
+    mCardinalityBounds.put(std::pair<IRI, IRI>(iri, objectProperty), cachedResult);
 }
 
-void QueryCache::cacheIsSubClassOf(const IRI& iri, const IRI& otherIri, bool isSubclass)
+void QueryCache::cacheIsSubClassOf(const IRI& iri, const IRI& otherIri, bool isSubclass,
+        const Dependencies& dependencies)
 {
-    mSubClassing.emplace( std::pair<IRI, IRI>(iri, otherIri), isSubclass);
+    CachedResult<bool> cachedResult;
+    cachedResult.result = isSubclass;
+    cachedResult.dependencies = track(dependencies);
+    mSubClassing.put( std::pair<IRI, IRI>(iri, otherIri), cachedResult);
 }
 
 } // end namespace model
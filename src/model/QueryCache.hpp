@@ -1,12 +1,16 @@
 #ifndef OWLAPI_MODEL_QUERY_CACHE_HPP
 #define OWLAPI_MODEL_QUERY_CACHE_HPP
 
+#include <atomic>
+#include <map>
 #include <unordered_map>
 #include <functional>
+#include <mutex>
 #include <boost/functional/hash.hpp>
 #include <tuple>
 #include "IRI.hpp"
 #include "OWLCardinalityRestriction.hpp"
+#include "ShardedLRUCache.hpp"
 
 namespace std {
 using namespace owlapi::model;
@@ -18,9 +22,9 @@ struct hash< tuple<IRIList, IRI, OWLCardinalityRestrictionOps::OperationType> >
         size_t seed = 0;
         for(const owlapi::model::IRI& iri : get<0>(tpl) )
         {
-            boost::hash_combine(seed, iri.toString());
+            boost::hash_combine(seed, iri.getId());
         }
-        boost::hash_combine(seed, get<1>(tpl).toString());
+        boost::hash_combine(seed, get<1>(tpl).getId());
         boost::hash_combine(seed, get<2>(tpl));
         return seed;
     }
@@ -30,14 +34,110 @@ struct hash< tuple<IRIList, IRI, OWLCardinalityRestrictionOps::OperationType> >
 namespace owlapi {
 namespace model {
 
+/**
+ * \class QueryCache
+ * \brief Cache for query results of an ontology
+ * \details The cache is thread-safe and can be shared by multiple threads
+ * querying the same ontology. Each result category is bounded in size and
+ * evicts the least recently used entries.
+ *
+ * Each cached result records the entities (classes, properties and
+ * individuals) it has been derived from. Invalidating an entity marks only
+ * the results depending on it as stale, so that modifications of the
+ * ontology do not require to drop the whole cache.
+ */
 class QueryCache
 {
 public:
+    typedef CacheStatistics Statistics;
+
+    /// Entities a query result has been derived from
+    typedef IRISet Dependencies;
+
+    /// Flattened bounds of cardinality restrictions per qualification
+    /// \see OWLObjectCardinalityRestriction::getBounds
+    typedef std::map<IRI, OWLCardinalityRestriction::MinMax> CardinalityBounds;
+
+    /**
+     * \class DependencyScope
+     * \brief Collect the dependencies of a query result while it is computed
+     * \details Scopes are thread-local and can be nested: when a scope ends,
+     * its dependencies are propagated to the enclosing scope, so that a result
+     * computed from other (cached) results inherits their dependencies
+     */
+    class DependencyScope
+    {
+    public:
+        DependencyScope();
+        ~DependencyScope();
+
+        void add(const IRI& iri);
+        void add(const Dependencies& dependencies);
+
+        const Dependencies& getDependencies() const { return mDependencies; }
+
+    private:
+        DependencyScope(const DependencyScope&) = delete;
+        DependencyScope& operator=(const DependencyScope&) = delete;
+
+        DependencyScope* mpParent;
+        Dependencies mDependencies;
+    };
+
+    /**
+     * Record a dependency in the currently active scope of this thread, if
+     * there is any
+     */
+    static void recordDependency(const IRI& iri);
+
+    /// Default maximum number of entries per result category
+    static const size_t DEFAULT_MAX_ENTRIES = 100000;
+
+    /**
+     * Constructor
+     * \param maxEntries Maximum number of entries per result category, 0 for
+     * no limit
+     */
+    QueryCache(size_t maxEntries = DEFAULT_MAX_ENTRIES);
+
     /**
      * Clear the query cache
      */
     void clear();
 
+    /**
+     * Invalidate all cached results which depend on any of the given entities
+     */
+    void invalidate(const IRIList& entities);
+
+    /**
+     * Invalidate all cached subclass relationships
+     */
+    void invalidateSubClassRelations();
+
+    /**
+     * Set the maximum number of entries per result category, 0 for no limit
+     * \details Cardinality bounds are not limited, since they form a table
+     * which is meant to cover all classes
+     */
+    void setMaxEntries(size_t maxEntries);
+
+    /**
+     * Get the number of entities which are tracked as dependencies
+     * \details Entities are dropped once no cached result depends on them
+     */
+    size_t getNumberOfDependencies() const;
+
+    /**
+     * Get the accumulated usage statistics of all result categories
+     */
+    Statistics getStatistics() const;
+
+    /**
+     * Reset the hit, miss, eviction and invalidation counters
+     */
+    void resetStatistics();
+
     std::pair<bool,bool> isSubClassOf(const IRI& iri, const IRI& otherIri) const;
 
     /**
@@ -60,29 +160,129 @@ public:
 
     /**
      * Cache result of call to identify cardinality restrictions
+     * \param dependencies Entities the result has been derived from
      */
     void cacheCardinalityRestrictions(const IRI& iri, const IRI& objectProperty,
-            const OWLCardinalityRestriction::PtrList& restrictions);
+            const OWLCardinalityRestriction::PtrList& restrictions,
+            const Dependencies& dependencies = Dependencies());
 
     void cacheCardinalityRestrictions(const IRIList& iris,
             const IRI& objectProperty,
             OWLCardinalityRestrictionOps::OperationType operationType,
-            const OWLCardinalityRestriction::PtrList& restrictions);
+            const OWLCardinalityRestriction::PtrList& restrictions,
+            const Dependencies& dependencies = Dependencies());
+
+    /**
+     * Retrieve the cached cardinality bounds of a class for an object property
+     * \return a pair of actual result and success of the retrieval, if success
+     * value is false, then the bounds are not available or outdated
+     */
+    std::pair<CardinalityBounds, bool> getCardinalityBounds(const IRI& iri,
+            const IRI& objectProperty) const;
+
+    /**
+     * Cache the cardinality bounds of a class for an object property
+     * \param dependencies Entities the result has been derived from
+     */
+    void cacheCardinalityBounds(const IRI& iri, const IRI& objectProperty,
+            const CardinalityBounds& bounds,
+            const Dependencies& dependencies = Dependencies());
 
     /**
      * Cache subclass relationship testing
+     * \param dependencies Entities the result has been derived from
      */
-    void cacheIsSubClassOf(const IRI& iri, const IRI& otherIri, bool isSubclass);
+    void cacheIsSubClassOf(const IRI& iri, const IRI& otherIri, bool isSubclass,
+            const Dependencies& dependencies = Dependencies());
 
 private:
-    std::unordered_map< std::pair<IRI, IRI>, OWLCardinalityRestriction::PtrList> mCardinalityRestrictions;
+    typedef std::tuple<IRIList, IRI, OWLCardinalityRestrictionOps::OperationType> CardinalityRestrictionsOpsKey;
+
+    /**
+     * Validity of all cached results depending on an entity
+     * \details The token is shared by these results and replaced once the
+     * entity is invalidated, so that an entity is only tracked as long as
+     * cached results depend on it
+     */
+    struct DependencyToken
+    {
+        std::atomic<bool> valid;
+
+        DependencyToken()
+            : valid(true)
+        {}
+    };
+
+    /// Dependencies with the tokens they had when the result was cached
+    typedef std::vector< std::pair<IRI, shared_ptr<DependencyToken> > > TrackedDependencies;
+
+    template<typename T>
+    struct CachedResult
+    {
+        T result;
+        TrackedDependencies dependencies;
+    };
+
+    /**
+     * Retrieve the current tokens of the given dependencies
+     */
+    TrackedDependencies track(const Dependencies& dependencies);
+
+    /**
+     * Remove the entities no cached result depends on anymore, requires
+     * the token mutex to be locked
+     */
+    void purge();
+
+    /**
+     * Check that none of the dependencies has been invalidated in the meantime
+     */
+    bool isValid(const TrackedDependencies& dependencies) const;
+
+    /**
+     * Lookup a result in the given cache and propagate its dependencies
+     * to the current dependency scope
+     */
+    template<typename Key, typename T>
+    bool lookup(ShardedLRUCache<Key, CachedResult<T> >& cache, const Key& key, T& result) const
+    {
+        CachedResult<T> cachedResult;
+        bool found = cache.get(key, cachedResult, [this](const CachedResult<T>& r)
+                {
+                    return isValid(r.dependencies);
+                });
 
-    std::unordered_map< std::tuple<IRIList, IRI,
-        OWLCardinalityRestrictionOps::OperationType>, OWLCardinalityRestriction::PtrList>
+        if(found)
+        {
+            result = cachedResult.result;
+            for(const TrackedDependencies::value_type& dependency : cachedResult.dependencies)
+            {
+                recordDependency(dependency.first);
+            }
+        }
+        return found;
+    }
+
+    // mutable since lookups update the recently used order and the statistics
+    mutable ShardedLRUCache< std::pair<IRI, IRI>, CachedResult<OWLCardinalityRestriction::PtrList> > mCardinalityRestrictions;
+
+    mutable ShardedLRUCache< CardinalityRestrictionsOpsKey, CachedResult<OWLCardinalityRestriction::PtrList> >
         mCardinalityRestrictionsOps;
 
-    std::unordered_map< std::pair<IRI, IRI>, bool> mSubClassing;
+    mutable ShardedLRUCache< std::pair<IRI, IRI>, CachedResult<bool> > mSubClassing;
+
+    /// Unbounded table of cardinality bounds per class and object property
+    mutable ShardedLRUCache< std::pair<IRI, IRI>, CachedResult<CardinalityBounds> > mCardinalityBounds;
+
+    /// Minimum number of tracked entities before unused ones are purged
+    static const size_t MIN_PURGE_SIZE = 64;
 
+    /// Protects the dependency tokens
+    mutable std::mutex mTokenMutex;
+    /// Current token of all entities cached results depend on
+    std::unordered_map<IRI, weak_ptr<DependencyToken> > mTokens;
+    /// Number of tracked entities at which unused ones are purged next
+    size_t mPurgeSize;
 };
 
 } // end namespace model
@@ -0,0 +1,334 @@
+#ifndef OWLAPI_MODEL_SHARDED_LRU_CACHE_HPP
+#define OWLAPI_MODEL_SHARDED_LRU_CACHE_HPP
+
+#include <stdint.h>
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace owlapi {
+namespace model {
+
+/**
+ * Statistics of the cache usage
+ */
+struct CacheStatistics
+{
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    /// Number of entries which have been found, but were no longer valid
+    uint64_t invalidations;
+    size_t entries;
+
+    CacheStatistics()
+        : hits(0)
+        , misses(0)
+        , evictions(0)
+        , invalidations(0)
+        , entries(0)
+    {}
+};
+
+/**
+ * \class ShardedLRUCache
+ * \brief Thread-safe key value cache with bounded size
+ * \details Entries are distributed over a number of shards, each protected by
+ * its own mutex, so that concurrent readers and writers only contend when they
+ * access the same shard. Each shard evicts its least recently used entry once
+ * it reaches its capacity; the capacities of all shards add up to the
+ * maximum number of entries.
+ */
+template<typename Key, typename Value, typename Hash = std::hash<Key> >
+class ShardedLRUCache
+{
+public:
+    typedef CacheStatistics Statistics;
+
+    /**
+     * Constructor
+     * \param maxEntries Maximum number of entries, 0 for no limit
+     * \param numberOfShards Number of independently locked partitions
+     */
+    ShardedLRUCache(size_t maxEntries = 0, size_t numberOfShards = 16)
+        : mActiveShards(0)
+        , mHits(0)
+        , mMisses(0)
+        , mEvictions(0)
+        , mInvalidations(0)
+    {
+        if(numberOfShards == 0)
+        {
+            numberOfShards = 1;
+        }
+        for(size_t i = 0; i < numberOfShards; ++i)
+        {
+            mShards.push_back( std::unique_ptr<Shard>(new Shard()) );
+        }
+        mActiveShards = numberOfShards;
+        setMaxEntries(maxEntries);
+    }
+
+    /**
+     * Set the maximum number of entries, 0 for no limit
+     * \details The limit is distributed over the shards; if the limit is
+     * smaller than the number of shards, only as many shards as entries are
+     * allowed are used so that the limit holds exactly. Existing entries are
+     * redistributed and evicted as needed
+     */
+    void setMaxEntries(size_t maxEntries)
+    {
+        std::vector< std::unique_lock<std::mutex> > locks;
+        for(std::unique_ptr<Shard>& shard : mShards)
+        {
+            locks.push_back( std::unique_lock<std::mutex>(shard->mutex) );
+        }
+
+        size_t activeShards = mShards.size();
+        if(maxEntries != 0 && maxEntries < activeShards)
+        {
+            activeShards = maxEntries;
+        }
+
+        if(activeShards != mActiveShards)
+        {
+            // The shard of a key depends on the number of active shards
+            EntryList entries;
+            for(std::unique_ptr<Shard>& shard : mShards)
+            {
+                entries.splice(entries.end(), shard->entries);
+                shard->index.clear();
+            }
+            mActiveShards = activeShards;
+
+            // Reinsert from least to most recently used to keep the order
+            while(!entries.empty())
+            {
+                Shard& shard = *mShards[ Hash()(entries.back().first) % activeShards ];
+                shard.entries.splice(shard.entries.begin(), entries, --entries.end());
+                shard.index[shard.entries.front().first] = shard.entries.begin();
+            }
+        }
+
+        for(size_t i = 0; i < mShards.size(); ++i)
+        {
+            Shard& shard = *mShards[i];
+            shard.capacity = 0;
+            if(maxEntries != 0 && i < activeShards)
+            {
+                shard.capacity = maxEntries / activeShards + (i < maxEntries % activeShards ? 1 : 0);
+            }
+            evict(shard);
+        }
+    }
+
+    /**
+     * Lookup a value
+     * \param key Key of the entry
+     * \param value Result value, only set if the entry was found
+     * \return true if the entry was found, false otherwise
+     */
+    bool get(const Key& key, Value& value)
+    {
+        return get(key, value, [](const Value&) { return true; });
+    }
+
+    /**
+     * Lookup a value and validate it
+     * \param key Key of the entry
+     * \param value Result value, only set if a valid entry was found
+     * \param isValid Predicate to test whether the stored value is still
+     * valid; invalid entries are removed and reported as miss
+     * \return true if a valid entry was found, false otherwise
+     */
+    template<typename Predicate>
+    bool get(const Key& key, Value& value, Predicate isValid)
+    {
+        std::unique_lock<std::mutex> lock;
+        Shard& shard = lockShard(key, lock);
+        typename Index::iterator it = shard.index.find(key);
+        if(it == shard.index.end())
+        {
+            ++mMisses;
+            return false;
+        }
+
+        if(!isValid(it->second->second))
+        {
+            shard.entries.erase(it->second);
+            shard.index.erase(it);
+            ++mInvalidations;
+            ++mMisses;
+            return false;
+        }
+
+        // Mark as most recently used
+        shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+        value = it->second->second;
+        ++mHits;
+        return true;
+    }
+
+    /**
+     * Insert or update an entry
+     */
+    void put(const Key& key, const Value& value)
+    {
+        std::unique_lock<std::mutex> lock;
+        Shard& shard = lockShard(key, lock);
+        typename Index::iterator it = shard.index.find(key);
+        if(it != shard.index.end())
+        {
+            it->second->second = value;
+            shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+            return;
+        }
+
+        shard.entries.push_front( Entry(key, value) );
+        shard.index[key] = shard.entries.begin();
+        evict(shard);
+    }
+
+    /**
+     * Remove an entry
+     * \return true if an entry has been removed
+     */
+    bool erase(const Key& key)
+    {
+        std::unique_lock<std::mutex> lock;
+        Shard& shard = lockShard(key, lock);
+        typename Index::iterator it = shard.index.find(key);
+        if(it == shard.index.end())
+        {
+            return false;
+        }
+        shard.entries.erase(it->second);
+        shard.index.erase(it);
+        return true;
+    }
+
+    /**
+     * Remove all entries
+     */
+    void clear()
+    {
+        for(std::unique_ptr<Shard>& shard : mShards)
+        {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            shard->entries.clear();
+            shard->index.clear();
+        }
+    }
+
+    /**
+     * Get the current number of entries
+     */
+    size_t size() const
+    {
+        size_t entries = 0;
+        for(const std::unique_ptr<Shard>& shard : mShards)
+        {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            entries += shard->index.size();
+        }
+        return entries;
+    }
+
+    /**
+     * Get the usage statistics
+     */
+    Statistics getStatistics() const
+    {
+        Statistics statistics;
+        statistics.hits = mHits;
+        statistics.misses = mMisses;
+        statistics.evictions = mEvictions;
+        statistics.invalidations = mInvalidations;
+        statistics.entries = size();
+        return statistics;
+    }
+
+    /**
+     * Reset the hit, miss, eviction and invalidation counters
+     */
+    void resetStatistics()
+    {
+        mHits = 0;
+        mMisses = 0;
+        mEvictions = 0;
+        mInvalidations = 0;
+    }
+
+private:
+    typedef std::pair<Key, Value> Entry;
+    typedef std::list<Entry> EntryList;
+    typedef std::unordered_map<Key, typename EntryList::iterator, Hash> Index;
+
+    struct Shard
+    {
+        mutable std::mutex mutex;
+        /// Entries ordered from most to least recently used
+        EntryList entries;
+        Index index;
+        /// Maximum number of entries, 0 for no limit
+        size_t capacity;
+
+        Shard()
+            : capacity(0)
+        {}
+    };
+
+    /**
+     * Lock the shard the key belongs to
+     * \details Retries if the number of active shards changed while waiting
+     * for the lock, since the key might then belong to another shard
+     */
+    Shard& lockShard(const Key& key, std::unique_lock<std::mutex>& lock)
+    {
+        for(;;)
+        {
+            size_t activeShards = mActiveShards;
+            Shard& shard = *mShards[ Hash()(key) % activeShards ];
+            lock = std::unique_lock<std::mutex>(shard.mutex);
+            if(activeShards == mActiveShards)
+            {
+                return shard;
+            }
+            lock.unlock();
+        }
+    }
+
+    /**
+     * Evict least recently used entries, requires the shard to be locked
+     */
+    void evict(Shard& shard)
+    {
+        if(shard.capacity == 0)
+        {
+            return;
+        }
+
+        while(shard.index.size() > shard.capacity)
+        {
+            shard.index.erase(shard.entries.back().first);
+            shard.entries.pop_back();
+            ++mEvictions;
+        }
+    }
+
+    std::vector< std::unique_ptr<Shard> > mShards;
+    /// Number of shards in use, only changed while all shards are locked
+    std::atomic<size_t> mActiveShards;
+
+    std::atomic<uint64_t> mHits;
+    std::atomic<uint64_t> mMisses;
+    std::atomic<uint64_t> mEvictions;
+    std::atomic<uint64_t> mInvalidations;
+};
+
+} // end namespace model
+} // end namespace owlapi
+#endif // OWLAPI_MODEL_SHARDED_LRU_CACHE_HPP
@@ -0,0 +1,75 @@
+#include "PropertyDomainIndex.hpp"
+#include <stdexcept>
+
+using namespace owlapi::model;
+
+namespace owlapi {
+namespace reasoner {
+
+PropertyDomainIndex::PropertyDomainIndex(const IRIList& klasses)
+{
+    mProperties.reserve(klasses.size());
+    for(const IRI& klass : klasses)
+    {
+        mProperties[klass];
+    }
+}
+
+void PropertyDomainIndex::addObjectProperty(const IRI& property, const IRIList& klasses)
+{
+    add(property, klasses, &Properties::objectProperties);
+}
+
+void PropertyDomainIndex::addDataProperty(const IRI& property, const IRIList& klasses)
+{
+    add(property, klasses, &Properties::dataProperties);
+}
+
+void PropertyDomainIndex::add(const IRI& property, const IRIList& klasses,
+        IRIList Properties::*list)
+{
+    for(const IRI& klass : klasses)
+    {
+        std::unordered_map<IRI, Properties>::iterator it = mProperties.find(klass);
+        if(it == mProperties.end())
+        {
+            continue;
+        }
+
+        // A class can be subsumed by multiple domains of the property
+        IRIList& properties = it->second.*list;
+        if(properties.empty() || properties.back() != property)
+        {
+            properties.push_back(property);
+        }
+    }
+}
+
+bool PropertyDomainIndex::contains(const IRI& klass) const
+{
+    return mProperties.count(klass);
+}
+
+const PropertyDomainIndex::Properties& PropertyDomainIndex::get(const IRI& klass, const std::string& caller) const
+{
+    std::unordered_map<IRI, Properties>::const_iterator cit = mProperties.find(klass);
+    if(cit == mProperties.end())
+    {
+        throw std::invalid_argument("owlapi::reasoner::PropertyDomainIndex::" + caller + ": class '"
+                + klass.toString() + "' is not indexed");
+    }
+    return cit->second;
+}
+
+const IRIList& PropertyDomainIndex::getObjectProperties(const IRI& klass) const
+{
+    return get(klass, "getObjectProperties").objectProperties;
+}
+
+const IRIList& PropertyDomainIndex::getDataProperties(const IRI& klass) const
+{
+    return get(klass, "getDataProperties").dataProperties;
+}
+
+} // end namespace reasoner
+} // end namespace owlapi
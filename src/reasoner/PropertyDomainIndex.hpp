@@ -0,0 +1,85 @@
+#ifndef OWLAPI_REASONER_PROPERTY_DOMAIN_INDEX_HPP
+#define OWLAPI_REASONER_PROPERTY_DOMAIN_INDEX_HPP
+
+#include <unordered_map>
+#include "../SharedPtr.hpp"
+#include "../model/IRI.hpp"
+
+namespace owlapi {
+namespace reasoner {
+
+/**
+ * \class PropertyDomainIndex
+ * \brief Precomputed mapping of classes to the properties applicable to them
+ * \details A property applies to a class if the class is subsumed by one of
+ * the domains of the property. The index is a snapshot of a classified
+ * knowledge base: it has to be rebuilt after the class or property hierarchy
+ * has been modified.
+ */
+class PropertyDomainIndex
+{
+public:
+    typedef shared_ptr<PropertyDomainIndex> Ptr;
+
+    /**
+     * Create an index without any applicable properties
+     * \param klasses All classes queries can be answered for
+     */
+    PropertyDomainIndex(const model::IRIList& klasses);
+
+    /**
+     * Register an object property as applicable to the given classes
+     */
+    void addObjectProperty(const model::IRI& property, const model::IRIList& klasses);
+
+    /**
+     * Register a data property as applicable to the given classes
+     */
+    void addDataProperty(const model::IRI& property, const model::IRIList& klasses);
+
+    /**
+     * Check if queries for the given class can be answered by this index
+     */
+    bool contains(const model::IRI& klass) const;
+
+    /**
+     * Get the object properties applicable to a class, in the order they
+     * have been added
+     * \throw std::invalid_argument if the class is not part of the index
+     */
+    const model::IRIList& getObjectProperties(const model::IRI& klass) const;
+
+    /**
+     * Get the data properties applicable to a class, in the order they
+     * have been added
+     * \throw std::invalid_argument if the class is not part of the index
+     */
+    const model::IRIList& getDataProperties(const model::IRI& klass) const;
+
+    /**
+     * Get the number of classes in this index
+     */
+    size_t size() const { return mProperties.size(); }
+
+private:
+    struct Properties
+    {
+        model::IRIList objectProperties;
+        model::IRIList dataProperties;
+    };
+
+    const Properties& get(const model::IRI& klass, const std::string& caller) const;
+
+    /**
+     * Append property to the list of each class, unless it has been added
+     * last
+     */
+    void add(const model::IRI& property, const model::IRIList& klasses,
+            model::IRIList Properties::*list);
+
+    std::unordered_map<model::IRI, Properties> mProperties;
+};
+
+} // end namespace reasoner
+} // end namespace owlapi
+#endif // OWLAPI_REASONER_PROPERTY_DOMAIN_INDEX_HPP
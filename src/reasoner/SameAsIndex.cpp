@@ -0,0 +1,100 @@
+#include "SameAsIndex.hpp"
+#include <stdexcept>
+
+using namespace owlapi::model;
+
+namespace owlapi {
+namespace reasoner {
+
+SameAsIndex::SameAsIndex(const std::map<IRI, IRIList>& sameAs)
+{
+    for(const std::pair<const IRI, IRIList>& p : sameAs)
+    {
+        registerInstance(p.first);
+        for(const IRI& other : p.second)
+        {
+            registerInstance(other);
+        }
+    }
+
+    // Union of all instances which refer to the same individual
+    for(const std::pair<const IRI, IRIList>& p : sameAs)
+    {
+        size_t node = getNode(mIndex[p.first]);
+        for(const IRI& other : p.second)
+        {
+            size_t otherNode = getNode(mIndex[other]);
+            if(node != otherNode)
+            {
+                mNodes[otherNode] = node;
+            }
+        }
+    }
+
+    size_t numberOfInstances = mInstances.size();
+    mNodeMembers.resize(numberOfInstances);
+    for(size_t i = 0; i < numberOfInstances; ++i)
+    {
+        mNodes[i] = getNode(i);
+        mNodeMembers[mNodes[i]].push_back(i);
+    }
+}
+
+size_t SameAsIndex::registerInstance(const IRI& instance)
+{
+    std::unordered_map<IRI, size_t>::const_iterator cit = mIndex.find(instance);
+    if(cit != mIndex.end())
+    {
+        return cit->second;
+    }
+
+    size_t idx = mInstances.size();
+    mInstances.push_back(instance);
+    mNodes.push_back(idx);
+    mIndex[instance] = idx;
+    return idx;
+}
+
+size_t SameAsIndex::getNode(size_t idx)
+{
+    while(mNodes[idx] != idx)
+    {
+        mNodes[idx] = mNodes[ mNodes[idx] ];
+        idx = mNodes[idx];
+    }
+    return idx;
+}
+
+size_t SameAsIndex::getIndex(const IRI& instance, const std::string& caller) const
+{
+    std::unordered_map<IRI, size_t>::const_iterator cit = mIndex.find(instance);
+    if(cit == mIndex.end())
+    {
+        throw std::invalid_argument("owlapi::reasoner::SameAsIndex::" + caller + ": instance '"
+                + instance.toString() + "' is not indexed");
+    }
+    return cit->second;
+}
+
+bool SameAsIndex::contains(const IRI& instance) const
+{
+    return mIndex.count(instance);
+}
+
+bool SameAsIndex::isSameInstance(const IRI& instance, const IRI& otherInstance) const
+{
+    return mNodes[getIndex(instance, "isSameInstance")] == mNodes[getIndex(otherInstance, "isSameInstance")];
+}
+
+IRIList SameAsIndex::getSameAs(const IRI& instance) const
+{
+    IRIList sameAs;
+    for(size_t member : mNodeMembers[mNodes[getIndex(instance, "getSameAs")]])
+    {
+        sameAs.push_back(mInstances[member]);
+    }
+    return sameAs;
+}
+
+} // end namespace reasoner
+} // end namespace owlapi
@@ -0,0 +1,74 @@
+#ifndef OWLAPI_REASONER_SAME_AS_INDEX_HPP
+#define OWLAPI_REASONER_SAME_AS_INDEX_HPP
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+#include "../SharedPtr.hpp"
+#include "../model/IRI.hpp"
+
+namespace owlapi {
+namespace reasoner {
+
+/**
+ * \class SameAsIndex
+ * \brief Precomputed equivalence classes of instances of a realised
+ * knowledge base
+ * \details Instances which refer to the same individual are merged into a
+ * single equivalence class, so that sameAs queries are answered in O(1)
+ * without involving the reasoner. The index is a snapshot: it has to be
+ * rebuilt after the underlying knowledge base has been modified.
+ */
+class SameAsIndex
+{
+public:
+    typedef shared_ptr<SameAsIndex> Ptr;
+
+    /**
+     * Create the index
+     * \param sameAs Map of instance to the instances referring to the same
+     * individual as computed by the reasoner
+     */
+    SameAsIndex(const std::map<model::IRI, model::IRIList>& sameAs);
+
+    /**
+     * Check if queries for the given instance can be answered by this index
+     */
+    bool contains(const model::IRI& instance) const;
+
+    /**
+     * Test whether two instances refer to the same individual
+     * \throw std::invalid_argument if either instance is not part of the index
+     */
+    bool isSameInstance(const model::IRI& instance, const model::IRI& otherInstance) const;
+
+    /**
+     * Get all instances (including the given one) which refer to the same
+     * individual
+     * \throw std::invalid_argument if the instance is not part of the index
+     */
+    model::IRIList getSameAs(const model::IRI& instance) const;
+
+    /**
+     * Get the number of instances in this index
+     */
+    size_t size() const { return mInstances.size(); }
+
+private:
+    size_t getIndex(const model::IRI& instance, const std::string& caller) const;
+    size_t registerInstance(const model::IRI& instance);
+    size_t getNode(size_t idx);
+
+    /// Dense list of all known instances
+    model::IRIList mInstances;
+    /// Mapping of instance to position in mInstances
+    std::unordered_map<model::IRI, size_t> mIndex;
+    /// Equivalence class representative of an instance
+    std::vector<size_t> mNodes;
+    /// Members of each equivalence class, indexed by representative
+    std::vector< std::vector<size_t> > mNodeMembers;
+};
+
+} // end namespace reasoner
+} // end namespace owlapi
+#endif // OWLAPI_REASONER_SAME_AS_INDEX_HPP
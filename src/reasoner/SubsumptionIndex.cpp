@@ -0,0 +1,182 @@
+#include "SubsumptionIndex.hpp"
+#include <stdexcept>
+
+using namespace owlapi::model;
+
+namespace owlapi {
+namespace reasoner {
+
+SubsumptionIndex::SubsumptionIndex(const std::map<IRI, IRIList>& ancestors,
+        const std::map<IRI, IRIList>& equivalents)
+{
+    // Assign a dense index to all classes
+    for(const std::pair<const IRI, IRIList>& p : ancestors)
+    {
+        registerClass(p.first);
+        for(const IRI& ancestor : p.second)
+        {
+            registerClass(ancestor);
+        }
+    }
+    for(const std::pair<const IRI, IRIList>& p : equivalents)
+    {
+        registerClass(p.first);
+        for(const IRI& equivalent : p.second)
+        {
+            registerClass(equivalent);
+        }
+    }
+
+    size_t numberOfClasses = mClasses.size();
+
+    // Identify the taxonomy nodes, i.e. the sets of equivalent classes
+    for(const std::pair<const IRI, IRIList>& p : equivalents)
+    {
+        size_t node = getNode(mIndex[p.first]);
+        for(const IRI& equivalent : p.second)
+        {
+            size_t otherNode = getNode(mIndex[equivalent]);
+            if(node != otherNode)
+            {
+                mNodes[otherNode] = node;
+            }
+        }
+    }
+    std::vector< std::vector<size_t> > nodeMembers(numberOfClasses);
+    for(size_t i = 0; i < numberOfClasses; ++i)
+    {
+        mNodes[i] = getNode(i);
+        nodeMembers[mNodes[i]].push_back(i);
+    }
+
+    // Reflexive closure over all members of a node
+    mQueried.resize(numberOfClasses);
+    mSuperClasses.assign(numberOfClasses, boost::dynamic_bitset<>(numberOfClasses));
+    for(size_t i = 0; i < numberOfClasses; ++i)
+    {
+        for(size_t member : nodeMembers[mNodes[i]])
+        {
+            mSuperClasses[i].set(member);
+        }
+    }
+
+    // The reasoner provides the transitive closure of the superclasses, so
+    // there is no need to propagate further
+    for(const std::pair<const IRI, IRIList>& p : ancestors)
+    {
+        size_t idx = mIndex[p.first];
+        mQueried.set(idx);
+        for(const IRI& ancestor : p.second)
+        {
+            for(size_t member : nodeMembers[mNodes[mIndex[ancestor]]])
+            {
+                mSuperClasses[idx].set(member);
+            }
+        }
+    }
+
+    // Transpose to allow for O(k) subclass retrieval
+    mSubClasses.assign(numberOfClasses, boost::dynamic_bitset<>(numberOfClasses));
+    for(size_t i = 0; i < numberOfClasses; ++i)
+    {
+        if(!mQueried[i])
+        {
+            continue;
+        }
+        const boost::dynamic_bitset<>& superClasses = mSuperClasses[i];
+        for(size_t j = superClasses.find_first(); j != boost::dynamic_bitset<>::npos;
+                j = superClasses.find_next(j))
+        {
+            mSubClasses[j].set(i);
+        }
+    }
+}
+
+size_t SubsumptionIndex::registerClass(const IRI& klass)
+{
+    std::unordered_map<IRI, size_t>::const_iterator cit = mIndex.find(klass);
+    if(cit != mIndex.end())
+    {
+        return cit->second;
+    }
+
+    size_t idx = mClasses.size();
+    mClasses.push_back(klass);
+    mNodes.push_back(idx);
+    mIndex[klass] = idx;
+    return idx;
+}
+
+size_t SubsumptionIndex::getNode(size_t idx)
+{
+    while(mNodes[idx] != idx)
+    {
+        mNodes[idx] = mNodes[ mNodes[idx] ];
+        idx = mNodes[idx];
+    }
+    return idx;
+}
+
+size_t SubsumptionIndex::getIndex(const IRI& klass, const std::string& caller) const
+{
+    std::unordered_map<IRI, size_t>::const_iterator cit = mIndex.find(klass);
+    if(cit == mIndex.end())
+    {
+        throw std::invalid_argument("owlapi::reasoner::SubsumptionIndex::" + caller + ": class '"
+                + klass.toString() + "' is not indexed");
+    }
+    return cit->second;
+}
+
+bool SubsumptionIndex::contains(const IRI& klass) const
+{
+    std::unordered_map<IRI, size_t>::const_iterator cit = mIndex.find(klass);
+    return cit != mIndex.end() && mQueried[cit->second];
+}
+
+bool SubsumptionIndex::isSubClassOf(const IRI& subclass, const IRI& superclass) const
+{
+    size_t subIdx = getIndex(subclass, "isSubClassOf");
+    if(!mQueried[subIdx])
+    {
+        throw std::invalid_argument("owlapi::reasoner::SubsumptionIndex::isSubClassOf: class '"
+                + subclass.toString() + "' is not indexed");
+    }
+    size_t superIdx = getIndex(superclass, "isSubClassOf");
+    return mSuperClasses[subIdx][superIdx];
+}
+
+IRIList SubsumptionIndex::getAncestors(const IRI& klass) const
+{
+    size_t idx = getIndex(klass, "getAncestors");
+    IRIList ancestors;
+    const boost::dynamic_bitset<>& superClasses = mSuperClasses[idx];
+    for(size_t j = superClasses.find_first(); j != boost::dynamic_bitset<>::npos;
+            j = superClasses.find_next(j))
+    {
+        if(mNodes[j] != mNodes[idx])
+        {
+            ancestors.push_back(mClasses[j]);
+        }
+    }
+    return ancestors;
+}
+
+IRIList SubsumptionIndex::getSubClasses(const IRI& klass, const IRI& exclude) const
+{
+    size_t idx = getIndex(klass, "getSubClasses");
+    IRIList subclasses;
+    const boost::dynamic_bitset<>& subClasses = mSubClasses[idx];
+    for(size_t j = subClasses.find_first(); j != boost::dynamic_bitset<>::npos;
+            j = subClasses.find_next(j))
+    {
+        if(mNodes[j] != mNodes[idx] && mClasses[j] != exclude)
+        {
+            subclasses.push_back(mClasses[j]);
+        }
+    }
+    return subclasses;
+}
+
+} // end namespace reasoner
+} // end namespace owlapi
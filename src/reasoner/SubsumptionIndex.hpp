@@ -0,0 +1,89 @@
+#ifndef OWLAPI_REASONER_SUBSUMPTION_INDEX_HPP
+#define OWLAPI_REASONER_SUBSUMPTION_INDEX_HPP
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+#include <boost/dynamic_bitset.hpp>
+#include "../SharedPtr.hpp"
+#include "../model/IRI.hpp"
+
+namespace owlapi {
+namespace reasoner {
+
+/**
+ * \class SubsumptionIndex
+ * \brief Precomputed transitive closure of a classified class hierarchy
+ * \details The index stores for each class the set of subsuming and subsumed
+ * classes as bitsets, so that subsumption tests are answered in O(1) and
+ * ancestor / descendant queries in O(k) without involving the reasoner.
+ * The index is a snapshot: it has to be rebuilt after the underlying
+ * knowledge base has been modified.
+ */
+class SubsumptionIndex
+{
+public:
+    typedef shared_ptr<SubsumptionIndex> Ptr;
+
+    /**
+     * Create the index
+     * \param ancestors Map of class to all (direct and indirect) superclasses as
+     * computed by the reasoner
+     * \param equivalents Map of class to all its equivalent classes
+     */
+    SubsumptionIndex(const std::map<model::IRI, model::IRIList>& ancestors,
+            const std::map<model::IRI, model::IRIList>& equivalents);
+
+    /**
+     * Check if subsumption queries for the given class can be answered by
+     * this index
+     */
+    bool contains(const model::IRI& klass) const;
+
+    /**
+     * Test whether subclass is subsumed by superclass
+     * \throw std::invalid_argument if either class is not part of the index
+     */
+    bool isSubClassOf(const model::IRI& subclass, const model::IRI& superclass) const;
+
+    /**
+     * Get all ancestors (excluding equivalent classes) of a class
+     * \throw std::invalid_argument if the class is not part of the index
+     */
+    model::IRIList getAncestors(const model::IRI& klass) const;
+
+    /**
+     * Get all subclasses (excluding equivalent classes) of a class
+     * \param exclude Class that shall be excluded from the result, e.g. the
+     * bottom concept
+     * \throw std::invalid_argument if the class is not part of the index
+     */
+    model::IRIList getSubClasses(const model::IRI& klass, const model::IRI& exclude = model::IRI()) const;
+
+    /**
+     * Get the number of classes in this index
+     */
+    size_t size() const { return mClasses.size(); }
+
+private:
+    size_t getIndex(const model::IRI& klass, const std::string& caller) const;
+    size_t registerClass(const model::IRI& klass);
+    size_t getNode(size_t idx);
+
+    /// Dense list of all known classes
+    model::IRIList mClasses;
+    /// Mapping of class to position in mClasses
+    std::unordered_map<model::IRI, size_t> mIndex;
+    /// Equivalence class representative of a class
+    std::vector<size_t> mNodes;
+    /// Flag which classes have been queried, i.e. for which the ancestors are known
+    boost::dynamic_bitset<> mQueried;
+    /// Reflexive set of all superclasses for each class
+    std::vector< boost::dynamic_bitset<> > mSuperClasses;
+    /// Reflexive set of all subclasses for each class
+    std::vector< boost::dynamic_bitset<> > mSubClasses;
+};
+
+} // end namespace reasoner
+} // end namespace owlapi
+#endif // OWLAPI_REASONER_SUBSUMPTION_INDEX_HPP
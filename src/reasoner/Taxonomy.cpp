@@ -0,0 +1,157 @@
+#include "Taxonomy.hpp"
+#include <fstream>
+#include <stdexcept>
+#include <base-logging/Logging.hpp>
+#include "../io/BinaryIO.hpp"
+
+using namespace owlapi::model;
+using namespace owlapi::io;
+
+namespace owlapi {
+namespace reasoner {
+
+namespace {
+
+const char MAGIC[8] = { 'O', 'W', 'L', 'T', 'A', 'X', 'O', '\0' };
+const char* CONTEXT_READ = "owlapi::reasoner::Taxonomy::read";
+
+} // end anonymous namespace
+
+const uint32_t Taxonomy::VERSION = 1;
+
+Taxonomy::Taxonomy(uint64_t key)
+    : mKey(key)
+    , mRelations(END_RELATION)
+{}
+
+void Taxonomy::set(Relation relation, const IRI& iri, const IRIList& related)
+{
+    mRelations.at(relation)[iri] = related;
+}
+
+const IRIList* Taxonomy::find(Relation relation, const IRI& iri) const
+{
+    const RelationMap& relationMap = mRelations.at(relation);
+    RelationMap::const_iterator cit = relationMap.find(iri);
+    if(cit == relationMap.end())
+    {
+        return NULL;
+    }
+    return &cit->second;
+}
+
+size_t Taxonomy::size() const
+{
+    size_t numberOfEntries = 0;
+    for(const RelationMap& relationMap : mRelations)
+    {
+        numberOfEntries += relationMap.size();
+    }
+    return numberOfEntries;
+}
+
+void Taxonomy::write(const std::string& filename) const
+{
+    // Each IRI is written once, relations refer to it by index
+    IRIList terms;
+    std::unordered_map<IRI, uint32_t> termIds;
+    auto getTermId = [&terms, &termIds](const IRI& iri) -> uint32_t
+    {
+        std::unordered_map<IRI, uint32_t>::const_iterator cit = termIds.find(iri);
+        if(cit != termIds.end())
+        {
+            return cit->second;
+        }
+        uint32_t id = terms.size();
+        terms.push_back(iri);
+        termIds[iri] = id;
+        return id;
+    };
+
+    std::vector<uint32_t> relations;
+    for(const RelationMap& relationMap : mRelations)
+    {
+        relations.push_back(relationMap.size());
+        for(const RelationMap::value_type& entry : relationMap)
+        {
+            relations.push_back(getTermId(entry.first));
+            relations.push_back(entry.second.size());
+            for(const IRI& related : entry.second)
+            {
+                relations.push_back(getTermId(related));
+            }
+        }
+    }
+
+    std::ofstream out(filename.c_str(), std::ios::binary | std::ios::trunc);
+    if(!out)
+    {
+        throw std::runtime_error("owlapi::reasoner::Taxonomy::write: failed to open '"
+                + filename + "'");
+    }
+
+    writeHeader(out, MAGIC, VERSION);
+    writeValue(out, mKey);
+    writeValue<uint32_t>(out, terms.size());
+    for(const IRI& term : terms)
+    {
+        writeString(out, term.toString());
+    }
+    out.write(reinterpret_cast<const char*>(relations.data()), relations.size()*sizeof(uint32_t));
+
+    if(!out)
+    {
+        throw std::runtime_error("owlapi::reasoner::Taxonomy::write: failed to write '"
+                + filename + "'");
+    }
+}
+
+Taxonomy::Ptr Taxonomy::read(const std::string& filename)
+{
+    MappedFile file(filename, CONTEXT_READ);
+    BufferReader reader(file.data(), file.size(), filename, CONTEXT_READ);
+    reader.readHeader(MAGIC, VERSION, "taxonomy");
+
+    Taxonomy::Ptr taxonomy = make_shared<Taxonomy>(reader.read<uint64_t>());
+
+    IRIList terms(reader.readCount(sizeof(uint32_t)));
+    for(IRI& term : terms)
+    {
+        std::string value = reader.readString();
+        if(!value.empty())
+        {
+            term = IRI(value);
+        }
+    }
+    auto getTerm = [&terms, &filename](uint32_t id) -> const IRI&
+    {
+        if(id >= terms.size())
+        {
+            throw std::runtime_error("owlapi::reasoner::Taxonomy::read: '"
+                    + filename + "' refers to an unknown term");
+        }
+        return terms[id];
+    };
+
+    for(RelationMap& relationMap : taxonomy->mRelations)
+    {
+        uint32_t numberOfEntries = reader.readCount(2*sizeof(uint32_t));
+        relationMap.reserve(numberOfEntries);
+        for(uint32_t e = 0; e < numberOfEntries; ++e)
+        {
+            const IRI& iri = getTerm(reader.read<uint32_t>());
+            IRIList& related = relationMap[iri];
+            related.resize(reader.readCount(sizeof(uint32_t)));
+            for(IRI& r : related)
+            {
+                r = getTerm(reader.read<uint32_t>());
+            }
+        }
+    }
+
+    LOG_DEBUG_S << "Restored taxonomy with " << taxonomy->size() << " entries from '" << filename << "'";
+    return taxonomy;
+}
+
+} // end namespace reasoner
+} // end namespace owlapi
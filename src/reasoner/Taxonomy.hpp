@@ -0,0 +1,102 @@
+#ifndef OWLAPI_REASONER_TAXONOMY_HPP
+#define OWLAPI_REASONER_TAXONOMY_HPP
+
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../SharedPtr.hpp"
+#include "../model/IRI.hpp"
+
+namespace owlapi {
+namespace reasoner {
+
+/**
+ * \class Taxonomy
+ * \brief Persistable result of classifying and realising a knowledge base
+ * \details The taxonomy stores the answers of the reasoner to the hierarchy
+ * queries (class hierarchy, instance types and property hierarchy) for all
+ * known entities. It is identified by a key, i.e. a hash of the axioms of
+ * the knowledge base it has been computed for, so that a taxonomy written to
+ * file can be reused as long as the knowledge base has the same content.
+ * \see KnowledgeBase::computeTaxonomy, KnowledgeBase::setTaxonomy
+ */
+class Taxonomy
+{
+public:
+    typedef shared_ptr<Taxonomy> Ptr;
+
+    /// Relations stored in the taxonomy, named after the corresponding
+    /// queries of the KnowledgeBase
+    enum Relation { SUB_CLASSES = 0,
+        DIRECT_SUB_CLASSES,
+        ANCESTORS,
+        DIRECT_ANCESTORS,
+        EQUIVALENT_CLASSES,
+        TYPES,
+        DIRECT_TYPES,
+        SUB_OBJECT_PROPERTIES,
+        DIRECT_SUB_OBJECT_PROPERTIES,
+        ANCESTOR_OBJECT_PROPERTIES,
+        DIRECT_ANCESTOR_OBJECT_PROPERTIES,
+        SUB_DATA_PROPERTIES,
+        DIRECT_SUB_DATA_PROPERTIES,
+        ANCESTOR_DATA_PROPERTIES,
+        DIRECT_ANCESTOR_DATA_PROPERTIES,
+        END_RELATION
+    };
+
+    /// Version of the binary format, to be increased with any format change
+    static const uint32_t VERSION;
+
+    /**
+     * Create an empty taxonomy
+     * \param key Key of the knowledge base content this taxonomy belongs to
+     */
+    Taxonomy(uint64_t key);
+
+    /**
+     * Get the key of the knowledge base content this taxonomy belongs to
+     */
+    uint64_t getKey() const { return mKey; }
+
+    /**
+     * Set the entities related to the given entity
+     */
+    void set(Relation relation, const model::IRI& iri, const model::IRIList& related);
+
+    /**
+     * Find the entities related to the given entity
+     * \return NULL if the relation is not known for the entity
+     */
+    const model::IRIList* find(Relation relation, const model::IRI& iri) const;
+
+    /**
+     * Get the number of stored entries over all relations
+     */
+    size_t size() const;
+
+    /**
+     * Write the taxonomy to a file
+     * \throw std::runtime_error if the file cannot be written
+     */
+    void write(const std::string& filename) const;
+
+    /**
+     * Read a taxonomy from a file
+     * \throw std::runtime_error if the file cannot be read or has an
+     * incompatible format
+     */
+    static Taxonomy::Ptr read(const std::string& filename);
+
+private:
+    typedef std::unordered_map<model::IRI, model::IRIList> RelationMap;
+
+    uint64_t mKey;
+    /// Maps of each relation, indexed by Relation
+    std::vector<RelationMap> mRelations;
+};
+
+} // end namespace reasoner
+} // end namespace owlapi
+#endif // OWLAPI_REASONER_TAXONOMY_HPP
@@ -0,0 +1,66 @@
+#include "TaxonomyWalker.hpp"
+#include <unordered_set>
+
+using namespace owlapi::model;
+
+namespace owlapi {
+namespace reasoner {
+
+TaxonomyWalker::TaxonomyWalker(const IRI& root, const DirectSubClassesFunction& directSubClasses,
+        bool unique)
+    : mDirectSubClassesFunction(directSubClasses)
+{
+    // Classes which have already been assigned a distance
+    std::unordered_set<IRI> reached;
+    reached.insert(root);
+
+    IRIList level;
+    for(const IRI& klass : getDirectSubClasses(root))
+    {
+        if(!unique || reached.insert(klass).second)
+        {
+            level.push_back(klass);
+        }
+    }
+
+    while(!level.empty())
+    {
+        IRIList nextLevel;
+        for(const IRI& klass : level)
+        {
+            bool visited = mDirectSubClasses.count(klass);
+            const IRIList& subclasses = getDirectSubClasses(klass);
+            if(!visited && subclasses.empty())
+            {
+                mLeaves.push_back(klass);
+            }
+
+            for(const IRI& subclass : subclasses)
+            {
+                if(!unique || reached.insert(subclass).second)
+                {
+                    nextLevel.push_back(subclass);
+                }
+            }
+        }
+
+        mLevels.push_back(IRIList());
+        mLevels.back().swap(level);
+        level.swap(nextLevel);
+    }
+}
+
+const IRIList& TaxonomyWalker::getDirectSubClasses(const IRI& klass)
+{
+    std::unordered_map<IRI, IRIList>::const_iterator cit = mDirectSubClasses.find(klass);
+    if(cit != mDirectSubClasses.end())
+    {
+        return cit->second;
+    }
+    IRIList& subclasses = mDirectSubClasses[klass];
+    subclasses = mDirectSubClassesFunction(klass);
+    return subclasses;
+}
+
+} // end namespace reasoner
+} // end namespace owlapi
@@ -0,0 +1,68 @@
+#ifndef OWLAPI_REASONER_TAXONOMY_WALKER_HPP
+#define OWLAPI_REASONER_TAXONOMY_WALKER_HPP
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+#include "../model/IRI.hpp"
+
+namespace owlapi {
+namespace reasoner {
+
+/**
+ * \class TaxonomyWalker
+ * \brief Breadth-first traversal of the subclasses of a class in a
+ * classified hierarchy
+ * \details The walker visits all subclasses of a root class once, ordered by
+ * their link distance to the root, and identifies the leaves of the
+ * hierarchy on the way. The direct subclasses of each class are requested
+ * only once, independent of the number of paths leading to the class.
+ */
+class TaxonomyWalker
+{
+public:
+    /// Function to retrieve the direct subclasses of a class
+    typedef std::function<model::IRIList (const model::IRI&)> DirectSubClassesFunction;
+
+    /**
+     * Traverse all subclasses of a given class
+     * \param root Class to start the traversal from
+     * \param directSubClasses Function to retrieve the direct subclasses of a
+     * class
+     * \param unique If true, a class reachable through multiple paths is
+     * listed only once at its shortest distance, otherwise it is listed for
+     * each path
+     */
+    TaxonomyWalker(const model::IRI& root, const DirectSubClassesFunction& directSubClasses,
+            bool unique = false);
+
+    /**
+     * Get the subclasses grouped by link distance, starting with the direct
+     * subclasses of the root at index 0
+     */
+    const std::vector<model::IRIList>& getLevels() const { return mLevels; }
+
+    /**
+     * Get the subclasses which have no subclasses, each listed once
+     */
+    const model::IRIList& getLeaves() const { return mLeaves; }
+
+    /**
+     * Get the number of classes (including the root) for which the direct
+     * subclasses have been requested
+     */
+    size_t getNumberOfVisitedClasses() const { return mDirectSubClasses.size(); }
+
+private:
+    const model::IRIList& getDirectSubClasses(const model::IRI& klass);
+
+    DirectSubClassesFunction mDirectSubClassesFunction;
+    /// Direct subclasses of the visited classes
+    std::unordered_map<model::IRI, model::IRIList> mDirectSubClasses;
+    std::vector<model::IRIList> mLevels;
+    model::IRIList mLeaves;
+};
+
+} // end namespace reasoner
+} // end namespace owlapi
+#endif // OWLAPI_REASONER_TAXONOMY_WALKER_HPP
@@ -1,5 +1,6 @@
 #include <boost/test/unit_test.hpp>
 #include <boost/filesystem.hpp>
+#include <fstream>
 #include <owlapi/OWLApi.hpp>
 #include <owlapi/io/OWLOntologyIO.hpp>
 #include <owlapi/io/RedlandWriter.hpp>
@@ -22,6 +23,24 @@ using namespace owlapi::io;
 
 BOOST_AUTO_TEST_SUITE(io)
 
+/**
+ * Unique path in the temporary directory, which is removed on destruction
+ */
+struct ScopedTempFile
+{
+    ScopedTempFile(const std::string& model)
+        : path((boost::filesystem::temp_directory_path() / boost::filesystem::unique_path(model)).string())
+    {}
+
+    ~ScopedTempFile()
+    {
+        boost::system::error_code ec;
+        boost::filesystem::remove(path, ec);
+    }
+
+    std::string path;
+};
+
 BOOST_AUTO_TEST_CASE(redland_writer)
 {
     {
@@ -108,6 +127,38 @@ BOOST_AUTO_TEST_CASE(formats)
     }
 }
 
+BOOST_AUTO_TEST_CASE(snapshot)
+{
+    ScopedTempFile snapshotFile("test-owlapi-io-snapshot-%%%%-%%%%.bin");
+    OWLOntology::Ptr ontology = OWLOntologyIO::fromFile( getRootDir() + "/test/data/om-schema-v0.9.owl", snapshotFile.path);
+
+    OWLOntology::Ptr restored;
+    BOOST_REQUIRE_NO_THROW(restored = OWLOntologyIO::fromSnapshot(snapshotFile.path));
+    BOOST_REQUIRE_MESSAGE(restored->getIRI() == ontology->getIRI(), "Restored ontology has iri: " << restored->getIRI());
+    BOOST_REQUIRE_EQUAL(restored->getAxioms().size(), ontology->getAxioms().size());
+
+    ScopedTempFile invalidFile("test-owlapi-io-snapshot-invalid-%%%%-%%%%.bin");
+    {
+        std::ofstream out(invalidFile.path.c_str());
+        out << "no snapshot";
+    }
+    BOOST_REQUIRE_THROW(OWLOntologyIO::fromSnapshot(invalidFile.path), std::runtime_error);
+
+    // A truncated snapshot with an intact header must not be trusted
+    ScopedTempFile truncatedFile("test-owlapi-io-snapshot-truncated-%%%%-%%%%.bin");
+    {
+        std::ifstream in(snapshotFile.path.c_str(), std::ios::binary);
+        // magic, version and byte order mark
+        std::vector<char> header(16);
+        in.read(header.data(), header.size());
+        std::ofstream out(truncatedFile.path.c_str(), std::ios::binary);
+        out.write(header.data(), header.size());
+        uint32_t numberOfDocuments = 0xFFFFFFFF;
+        out.write(reinterpret_cast<const char*>(&numberOfDocuments), sizeof(numberOfDocuments));
+    }
+    BOOST_REQUIRE_THROW(OWLOntologyIO::fromSnapshot(truncatedFile.path), std::runtime_error);
+}
+
 BOOST_AUTO_TEST_CASE(canonize)
 {
     IRI iri("http://www.rock-robotics.org/2014/09/om-schema");
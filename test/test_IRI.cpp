@@ -25,5 +25,30 @@ BOOST_AUTO_TEST_CASE(is_valid)
     }
 }
 
+BOOST_AUTO_TEST_CASE(interning)
+{
+    IRI empty;
+    BOOST_REQUIRE_MESSAGE(empty.empty(), "Default IRI is empty");
+    BOOST_REQUIRE_MESSAGE(empty.getId() == IRIRegistry::EMPTY_ID, "Default IRI has the empty id");
+
+    IRI a("http://www.rock-robotics.org/2014/01/om-schema#a");
+    IRI aSplit("http://www.rock-robotics.org/2014/01/om-schema#", "a");
+    IRI b = IRI::create("http://www.rock-robotics.org/2014/01/om-schema#b");
+
+    BOOST_REQUIRE_MESSAGE(a.getId() == aSplit.getId(), "Same IRI string has same id");
+    BOOST_REQUIRE_MESSAGE(a == aSplit, "IRIs are equal");
+    BOOST_REQUIRE_MESSAGE(a != b, "IRIs are different");
+    BOOST_REQUIRE_MESSAGE( (a < b) != (b < a), "IRIs are strictly ordered");
+    BOOST_REQUIRE_MESSAGE( !(a < aSplit) && !(aSplit < a), "Equal IRIs are not ordered");
+
+    // Ordering is lexical, independent of the order of interning
+    IRI laterInterned("http://www.rock-robotics.org/2014/01/om-schema#0-first");
+    BOOST_REQUIRE_MESSAGE(laterInterned < a, "IRIs are ordered by their string representation");
+    BOOST_REQUIRE_MESSAGE(empty < a, "Empty IRI is ordered first");
+    BOOST_REQUIRE_MESSAGE(std::hash<IRI>()(a) == std::hash<IRI>()(aSplit), "Hash of equal IRIs is equal");
+    BOOST_REQUIRE_MESSAGE(IRIRegistry::toString(a.getId()) == a.toString(), "Registry returns IRI string");
+
+    BOOST_REQUIRE_THROW(IRIRegistry::toString(IRIRegistry::size()), std::invalid_argument);
+}
 
 BOOST_AUTO_TEST_SUITE_END()
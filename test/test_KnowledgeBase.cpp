@@ -97,6 +97,187 @@ BOOST_AUTO_TEST_CASE(class_hierarchy)
     BOOST_REQUIRE_MESSAGE( klasses.size() == 3, "Number of classes is '" << klasses.size() << "' expected 3");
 }
 
+BOOST_AUTO_TEST_CASE(assert_and_add_relations)
+{
+    KnowledgeBase kb;
+    kb.instanceOf("A","Base");
+    kb.instanceOf("B","Base");
+    kb.instanceOf("C","Base");
+    kb.objectProperty("sibling");
+    kb.irreflexiveProperty("sibling");
+    kb.relatedTo("A","sibling","C");
+
+    KnowledgeBase::InstanceRelation::List relations = {
+        { "A", "sibling", "B" },
+        { "A", "sibling", "A" },
+        { "B", "sibling", "C" },
+        { "C", "sibling", "C" },
+        { "A", "sibling", "C" }
+    };
+    std::vector<bool> added = kb.assertAndAddRelations(relations);
+    std::vector<bool> expected = { true, false, true, false, true };
+    BOOST_REQUIRE(added == expected);
+    BOOST_REQUIRE_NO_THROW(kb.refresh());
+    BOOST_REQUIRE_MESSAGE( kb.isRelatedTo("B", "sibling", "C"), "B and C are related");
+    BOOST_REQUIRE_MESSAGE( !kb.isRelatedTo("A", "sibling", "A"), "A is not related to itself");
+    BOOST_REQUIRE_MESSAGE( !kb.assertAndAddRelation("B", "sibling", "B"), "B cannot be related to itself");
+}
+
+BOOST_AUTO_TEST_CASE(same_as)
+{
+    KnowledgeBase kb;
+    kb.instanceOf("A","Base");
+    kb.instanceOf("B","Base");
+    kb.alias("AliasA", "A", KnowledgeBase::INSTANCE);
+
+    IRIList unique = kb.uniqueList({ "A", "AliasA", "B", "B" });
+    BOOST_REQUIRE_MESSAGE(unique == IRIList({ "A", "B" }), "Unique instances: " << unique);
+    BOOST_REQUIRE_EQUAL(kb.getSameAs("AliasA").size(), 2);
+    BOOST_REQUIRE(kb.isSameInstance("A", "AliasA"));
+    BOOST_REQUIRE(!kb.isSameInstance("A", "B"));
+
+    // Index has to be updated after the knowledge base has been modified
+    kb.alias("AliasB", "B", KnowledgeBase::INSTANCE);
+    unique = kb.uniqueList({ "AliasB", "A", "B", "AliasA" });
+    BOOST_REQUIRE_MESSAGE(unique == IRIList({ "AliasB", "A" }), "Unique instances: " << unique);
+    BOOST_REQUIRE(kb.isSameInstance("B", "AliasB"));
+
+    // Assertions which cannot entail equality keep the index valid
+    kb.dataProperty("hasWeight");
+    kb.valueOf("A", "hasWeight", kb.dataValue("1.0", vocabulary::XSD::resolve("double").toString()));
+    kb.disjoint(IRIList({ "A", "B" }), KnowledgeBase::INSTANCE);
+    BOOST_REQUIRE_EQUAL(kb.getSameAs("AliasA").size(), 2);
+    BOOST_REQUIRE(!kb.isSameInstance("A", "B"));
+
+    kb.instanceOf("C","Base");
+    kb.alias("AliasC", "C", KnowledgeBase::INSTANCE);
+    BOOST_REQUIRE(kb.isSameInstance("C", "AliasC"));
+}
+
+BOOST_AUTO_TEST_CASE(related_instances_of_class)
+{
+    KnowledgeBase kb;
+    kb.subClassOf("Gripper", "Tool");
+    kb.subClassOf("Camera", "Sensor");
+    kb.instanceOf("robot", "Robot");
+    kb.instanceOf("gripper", "Gripper");
+    kb.instanceOf("hammer", "Tool");
+    kb.instanceOf("camera", "Camera");
+    kb.objectProperty("has");
+    kb.relatedTo("robot", "has", "gripper");
+    kb.relatedTo("robot", "has", "hammer");
+    kb.relatedTo("robot", "has", "camera");
+
+    IRIList all = kb.allRelatedInstances("robot", "has");
+    BOOST_REQUIRE_EQUAL(all.size(), 3);
+
+    IRIList tools = kb.allRelatedInstances("robot", "has", "Tool");
+    BOOST_REQUIRE_MESSAGE(IRISet(tools.begin(), tools.end()) == IRISet({ "gripper", "hammer" }), "Tools: " << tools);
+
+    IRIList owners = kb.allInverseRelatedInstances("camera", "has", "Robot");
+    BOOST_REQUIRE_MESSAGE(owners == IRIList({ "robot" }), "Owners: " << owners);
+    BOOST_REQUIRE(kb.allInverseRelatedInstances("camera", "has", "Tool").empty());
+
+    IRIList directTools = kb.allInstancesOf("Tool", true);
+    BOOST_REQUIRE_MESSAGE(directTools == IRIList({ "hammer" }), "Direct tools: " << directTools);
+}
+
+BOOST_AUTO_TEST_CASE(subsumption_index)
+{
+    KnowledgeBase kb;
+    kb.subClassOf("Derived", "Base");
+    kb.subClassOf("DerivedDerived", "Derived");
+    kb.subClassOf("Other", "Base");
+    kb.equalClasses({"Base", "EquivalentBase"});
+
+    IRIList subclasses = kb.allSubClassesOf("Base");
+    IRIList ancestors = kb.allAncestorsOf("DerivedDerived");
+
+    kb.buildSubsumptionIndex();
+    BOOST_REQUIRE_MESSAGE(kb.hasSubsumptionIndex(), "Subsumption index available");
+
+    BOOST_REQUIRE_MESSAGE( kb.isSubClassOf("DerivedDerived", "Base"), "DerivedDerived is subclass of Base");
+    BOOST_REQUIRE_MESSAGE( kb.isSubClassOf("DerivedDerived", "EquivalentBase"), "DerivedDerived is subclass of EquivalentBase");
+    BOOST_REQUIRE_MESSAGE( kb.isSubClassOf("Derived", "Derived"), "Derived is subclass of itself");
+    BOOST_REQUIRE_MESSAGE( !kb.isSubClassOf("Other", "Derived"), "Other is not a subclass of Derived");
+    BOOST_REQUIRE_MESSAGE( !kb.isSubClassOf("Base", "Derived"), "Base is not a subclass of Derived");
+
+    IRIList indexedSubclasses = kb.allSubClassesOf("Base");
+    BOOST_REQUIRE_MESSAGE( IRISet(subclasses.begin(), subclasses.end()) == IRISet(indexedSubclasses.begin(), indexedSubclasses.end()),
+            "Indexed subclasses: " << indexedSubclasses << " expected: " << subclasses);
+    IRIList indexedAncestors = kb.allAncestorsOf("DerivedDerived");
+    BOOST_REQUIRE_MESSAGE( IRISet(ancestors.begin(), ancestors.end()) == IRISet(indexedAncestors.begin(), indexedAncestors.end()),
+            "Indexed ancestors: " << indexedAncestors << " expected: " << ancestors);
+
+    kb.subClassOf("Other", "Derived");
+    BOOST_REQUIRE_MESSAGE( kb.isSubClassOf("Other", "Derived"), "Other is subclass of Derived after update");
+    BOOST_REQUIRE_MESSAGE( !kb.hasSubsumptionIndex(), "Subsumption index invalidated by update");
+}
+
+BOOST_AUTO_TEST_CASE(taxonomy)
+{
+    std::string filename = "/tmp/test-owlapi-kb-taxonomy.bin";
+    IRIList subclasses;
+    IRIList ancestors;
+    IRIList types;
+    {
+        KnowledgeBase kb;
+        kb.subClassOf("Derived", "Base");
+        kb.subClassOf("DerivedDerived", "Derived");
+        kb.instanceOf("instance", "DerivedDerived");
+
+        subclasses = kb.allSubClassesOf("Base");
+        ancestors = kb.allAncestorsOf("DerivedDerived");
+        types = kb.typesOf("instance");
+
+        reasoner::Taxonomy::Ptr taxonomy = kb.computeTaxonomy();
+        BOOST_REQUIRE_MESSAGE(taxonomy->getKey() == kb.getContentHash(), "Taxonomy is keyed by content hash");
+        taxonomy->write(filename);
+    }
+
+    KnowledgeBase kb;
+    // Same content, but different order
+    kb.instanceOf("instance", "DerivedDerived");
+    kb.subClassOf("DerivedDerived", "Derived");
+    kb.subClassOf("Derived", "Base");
+
+    reasoner::Taxonomy::Ptr taxonomy = reasoner::Taxonomy::read(filename);
+    BOOST_REQUIRE_MESSAGE(kb.setTaxonomy(taxonomy), "Taxonomy matches the knowledge base");
+    BOOST_REQUIRE(kb.hasTaxonomy());
+
+    IRIList restoredSubclasses = kb.allSubClassesOf("Base");
+    BOOST_REQUIRE_MESSAGE( IRISet(subclasses.begin(), subclasses.end()) == IRISet(restoredSubclasses.begin(), restoredSubclasses.end()),
+            "Restored subclasses: " << restoredSubclasses << " expected: " << subclasses);
+    IRIList restoredAncestors = kb.allAncestorsOf("DerivedDerived");
+    BOOST_REQUIRE_MESSAGE( IRISet(ancestors.begin(), ancestors.end()) == IRISet(restoredAncestors.begin(), restoredAncestors.end()),
+            "Restored ancestors: " << restoredAncestors << " expected: " << ancestors);
+    IRIList restoredTypes = kb.typesOf("instance");
+    BOOST_REQUIRE_MESSAGE( IRISet(types.begin(), types.end()) == IRISet(restoredTypes.begin(), restoredTypes.end()),
+            "Restored types: " << restoredTypes << " expected: " << types);
+    BOOST_REQUIRE_MESSAGE( !kb.isRealized(), "Reasoning is deferred while the taxonomy is used");
+
+    kb.subClassOf("Other", "Base");
+    BOOST_REQUIRE_MESSAGE( !kb.hasTaxonomy(), "Taxonomy invalidated by update");
+    BOOST_REQUIRE_EQUAL( kb.allSubClassesOf("Base").size(), subclasses.size() + 1);
+
+    KnowledgeBase otherKb;
+    otherKb.subClassOf("Derived", "Base");
+    BOOST_REQUIRE_MESSAGE( !otherKb.setTaxonomy(taxonomy), "Taxonomy does not match a different knowledge base");
+
+    {
+        // Any change after setting the taxonomy invalidates it
+        KnowledgeBase kb;
+        kb.subClassOf("DerivedDerived", "Derived");
+        kb.subClassOf("Derived", "Base");
+        reasoner::factpp::Axiom axiom = kb.instanceOf("instance", "DerivedDerived");
+        BOOST_REQUIRE(kb.setTaxonomy(taxonomy));
+
+        kb.retract(axiom);
+        kb.instanceOf("instance", "DerivedDerived");
+        BOOST_REQUIRE_MESSAGE( !kb.hasTaxonomy(), "Taxonomy invalidated by retraction");
+    }
+}
+
 BOOST_AUTO_TEST_CASE(property_hierarchy)
 {
     using namespace reasoner::factpp;
@@ -3,6 +3,7 @@
 
 #include <owlapi/OWLApi.hpp>
 #include <owlapi/Vocabulary.hpp>
+#include <owlapi/model/ObjectArena.hpp>
 #include <boost/regex.hpp>
 #include <unordered_map>
 
@@ -110,6 +111,48 @@ BOOST_AUTO_TEST_CASE(iri_unordered_maps)
     BOOST_REQUIRE_MESSAGE(iriMap[otherIri] == 2, "Iri retrieval: expected 2");
 }
 
+BOOST_AUTO_TEST_CASE(literals)
+{
+    using namespace owlapi::vocabulary;
+
+    OWLLiteral::Ptr doubleLiteral = OWLLiteral::create("7.3", XSD::resolve("double"));
+    BOOST_REQUIRE_MESSAGE(doubleLiteral->isDouble() && doubleLiteral->getValueType() == OWLLiteral::DOUBLE, "Double literal parsed");
+    BOOST_REQUIRE_CLOSE(doubleLiteral->getDouble(), 7.3, 1E-06);
+    BOOST_REQUIRE_MESSAGE(doubleLiteral->getDatatypeIRI() == XSD::resolve("double"), "Datatype IRI of literal");
+    BOOST_REQUIRE_MESSAGE(doubleLiteral->toString() == "7.3^^" + XSD::resolve("double").toString(), "Literal as string");
+
+    OWLLiteral::Ptr intLiteral = OWLLiteral::create("42^^" + XSD::resolve("int").toString());
+    BOOST_REQUIRE_MESSAGE(intLiteral->getValueType() == OWLLiteral::INTEGER, "Integer literal parsed");
+    BOOST_REQUIRE_MESSAGE(intLiteral->getInteger() == 42 && intLiteral->getDouble() == 42.0, "Integer value of literal");
+
+    OWLLiteral::Ptr booleanLiteral = OWLLiteral::create("true", XSD::boolean());
+    BOOST_REQUIRE_MESSAGE(booleanLiteral->isBoolean() && booleanLiteral->getBoolean(), "Boolean literal parsed");
+
+    OWLLiteral::Ptr plainLiteral = OWLLiteral::create("value");
+    BOOST_REQUIRE_MESSAGE(plainLiteral->isPlainLiteral() && plainLiteral->getValueType() == OWLLiteral::STRING, "Plain literal");
+    BOOST_REQUIRE_THROW(plainLiteral->getBoolean(), std::runtime_error);
+    BOOST_REQUIRE_THROW(OWLLiteral::create("value", XSD::resolve("double")), std::runtime_error);
+
+    BOOST_REQUIRE_MESSAGE(OWLLiteral::getDatatype(XSD::integer().toString()) == OWLLiteral::getDatatype(XSD::integer().toString()),
+            "Datatypes are interned");
+}
+
+BOOST_AUTO_TEST_CASE(object_arena)
+{
+    OWLClass::Ptr klass;
+    {
+        ObjectArena::Ptr arena = owlapi::make_shared<ObjectArena>();
+        for(size_t i = 0; i < 100; ++i)
+        {
+            klass = owlapi::allocate_shared<OWLClass>(ArenaAllocator<OWLClass>(arena),
+                    IRI("http://www.w3.org/2002/07/custom#klass-" + std::to_string(i)));
+        }
+        BOOST_REQUIRE_MESSAGE(arena->getAllocatedBytes() >= 100*sizeof(OWLClass), "Objects allocated from arena");
+        BOOST_REQUIRE_MESSAGE(arena->getNumberOfBlocks() < 100, "Objects share blocks");
+    }
+    BOOST_REQUIRE_MESSAGE(klass->getIRI().toString() == "http://www.w3.org/2002/07/custom#klass-99", "Object outlives the owner of the arena");
+}
+
 BOOST_AUTO_TEST_CASE(property_expressions)
 {
     OWLObjectPropertyExpression::Ptr oProperty( new OWLObjectProperty("http://www.w3.org/2002/07/custom#has"));
@@ -398,9 +441,34 @@ BOOST_AUTO_TEST_CASE(cardinality_restrictions)
         }
 
         {
-
+            std::vector<OWLCardinalityRestriction::Ptr> restrictions = restrictionsA;
+            restrictions.insert(restrictions.end(), restrictionsB.begin(), restrictionsB.end());
+            std::vector<OWLCardinalityRestriction::Ptr> compactRestrictions = OWLCardinalityRestrictionOps::compact(restrictions);
+            BOOST_REQUIRE_MESSAGE(compactRestrictions.size() == 3, "Compact set should reduce to size 3");
+            BOOST_REQUIRE_MESSAGE(compactRestrictions[0]->getCardinality() == 2, "Compacted restrictions for fork should have cardinality 2");
+
+            compactRestrictions = OWLCardinalityRestrictionOps::compact(restrictions, OWLCardinalityRestrictionOps::MAX_OP);
+            BOOST_REQUIRE_MESSAGE(compactRestrictions.size() == 3 && compactRestrictions[0]->getCardinality() == 1,
+                    "Compacted restrictions for fork should have maximum cardinality 1");
         }
 
+        {
+            std::vector<OWLCardinalityRestriction::Ptr> minRestrictions = { OWLObjectCardinalityRestriction::getInstance(
+                    oPropertyPtr, 1, fork, OWLCardinalityRestriction::MIN) };
+            std::vector<OWLCardinalityRestriction::Ptr> maxRestrictions = { OWLObjectCardinalityRestriction::getInstance(
+                    oPropertyPtr, 3, fork, OWLCardinalityRestriction::MAX) };
+            BOOST_REQUIRE_MESSAGE(OWLCardinalityRestrictionOps::intersection(minRestrictions, maxRestrictions).size() == 2,
+                    "Non-overlapping min and max restrictions are kept");
+
+            maxRestrictions[0]->setCardinality(1);
+            std::vector<OWLCardinalityRestriction::Ptr> intersection = OWLCardinalityRestrictionOps::intersection(minRestrictions, maxRestrictions);
+            BOOST_REQUIRE_MESSAGE(intersection.size() == 1
+                    && intersection[0]->getCardinalityRestrictionType() == OWLCardinalityRestriction::EXACT,
+                    "Equal min and max restrictions intersect to exact restriction");
+
+            maxRestrictions[0]->setCardinality(0);
+            BOOST_REQUIRE_THROW(OWLCardinalityRestrictionOps::intersection(minRestrictions, maxRestrictions), std::invalid_argument);
+        }
     }
 }
 
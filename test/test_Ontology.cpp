@@ -5,6 +5,8 @@
 #include <owlapi/io/OWLOntologyIO.hpp>
 #include <owlapi/model/OWLOntologyAsk.hpp>
 #include <owlapi/model/OWLOntologyTell.hpp>
+#include <owlapi/model/OWLOntologyTellBatch.hpp>
+#include <owlapi/model/OWLObjectIntersectionOf.hpp>
 
 using namespace owlapi;
 using namespace owlapi::model;
@@ -237,6 +239,269 @@ BOOST_AUTO_TEST_CASE(retract)
     BOOST_REQUIRE_MESSAGE( ask.allInstancesOf(klass).empty(), "No instances remaining of klass " << klass);
 }
 
+BOOST_AUTO_TEST_CASE(retract_repeated_assertion)
+{
+    OWLOntology::Ptr ontology = make_shared<OWLOntology>();
+    OWLOntologyAsk ask(ontology);
+    OWLOntologyTell tell(ontology);
+
+    IRI klass("http://my-classes#class-0");
+    IRI instance("http://my-classes/#class-0-instance-0");
+
+    tell.klass(klass);
+    OWLClassAssertionAxiom::Ptr axiom = tell.instanceOf(instance, klass);
+    OWLClassAssertionAxiom::Ptr repeatedAxiom = tell.instanceOf(instance, klass);
+    BOOST_REQUIRE_MESSAGE(axiom == repeatedAxiom, "Repeated assertion returns the contained axiom");
+    BOOST_REQUIRE_MESSAGE( ask.allInstancesOf(klass).size() == 1, "One instance of klass type " << klass);
+
+    tell.removeIndividual(instance);
+
+    BOOST_REQUIRE_MESSAGE( ask.allInstancesOf(klass).empty(), "Knowledge base does not entail an instance of klass " << klass);
+}
+
+BOOST_AUTO_TEST_CASE(repeated_axioms)
+{
+    OWLOntology::Ptr ontology = make_shared<OWLOntology>();
+    OWLOntologyTell tell(ontology);
+
+    IRI base("http://my-classes#base");
+    IRI derived("http://my-classes#derived");
+    IRI has("http://my-classes#has");
+    IRI instance("http://my-classes#instance-0");
+    IRI other("http://my-classes#instance-1");
+
+    tell.klass(base);
+    tell.klass(derived);
+    tell.objectProperty(has);
+    tell.instanceOf(instance, base);
+    tell.instanceOf(other, base);
+
+    OWLSubClassOfAxiom::Ptr subClassAxiom = tell.subClassOf(derived, base);
+    BOOST_REQUIRE_MESSAGE(subClassAxiom == tell.subClassOf(derived, base), "Repeated subclass axiom returns the contained axiom");
+    BOOST_REQUIRE_EQUAL(ontology->getReferencingAxioms(OWLEntity::klass(derived), false).size(), 2);
+
+    OWLAxiom::Ptr relation = tell.relatedTo(instance, has, other);
+    BOOST_REQUIRE_MESSAGE(relation == tell.relatedTo(instance, has, other), "Repeated relation returns the contained axiom");
+    BOOST_REQUIRE_THROW(tell.relatedTo(IRI("http://my-classes#unknown"), has, other), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(object_arena)
+{
+    IRI klassIRI("http://my-classes#class-0");
+    IRI superKlassIRI("http://my-classes#class-1");
+    IRI annotation("http://my-classes#annotation");
+    IRI instance("http://my-classes/#class-0-instance-0");
+
+    OWLClass::Ptr klass;
+    {
+        OWLOntology::Ptr ontology = make_shared<OWLOntology>();
+        OWLOntologyTell tell(ontology);
+        const ObjectArena::Ptr& arena = ontology->getObjectArena();
+
+        size_t allocatedBytes = arena->getAllocatedBytes();
+        klass = tell.klass(klassIRI);
+        BOOST_REQUIRE_MESSAGE(arena->getAllocatedBytes() > allocatedBytes, "Class allocated from the arena of the ontology");
+
+        // Retractable assertions do not grow the arena
+        tell.namedIndividual(instance);
+        allocatedBytes = arena->getAllocatedBytes();
+        tell.instanceOf(instance, klassIRI);
+        BOOST_REQUIRE_EQUAL(arena->getAllocatedBytes(), allocatedBytes);
+
+        // Neither do duplicate axioms
+        tell.klass(superKlassIRI);
+        tell.subClassOf(klassIRI, superKlassIRI);
+        allocatedBytes = arena->getAllocatedBytes();
+        tell.subClassOf(klassIRI, superKlassIRI);
+        BOOST_REQUIRE_EQUAL(arena->getAllocatedBytes(), allocatedBytes);
+
+        // nor replaced annotations
+        tell.annotationProperty(annotation);
+        tell.annotationOf(klassIRI, annotation, IRI("http://my-classes#value-0"));
+        allocatedBytes = arena->getAllocatedBytes();
+        tell.annotationOf(klassIRI, annotation, IRI("http://my-classes#value-1"));
+        BOOST_REQUIRE_EQUAL(arena->getAllocatedBytes(), allocatedBytes);
+    }
+    BOOST_REQUIRE_MESSAGE(klass->getIRI() == klassIRI, "Class outlives the ontology");
+}
+
+BOOST_AUTO_TEST_CASE(find)
+{
+    OWLOntology::Ptr ontology = make_shared<OWLOntology>();
+    OWLOntologyAsk ask(ontology);
+    OWLOntologyTell tell(ontology);
+
+    IRI klass("http://my-classes#class-0");
+    IRI instance("http://my-classes/#class-0-instance-0");
+    IRI property("http://my-classes/#property-0");
+    IRI unknown("http://my-classes/#unknown");
+
+    tell.klass(klass);
+    tell.instanceOf(instance, klass);
+    tell.objectProperty(property);
+
+    BOOST_REQUIRE_MESSAGE(ask.findOWLClass(klass), "Find class " << klass);
+    BOOST_REQUIRE_MESSAGE(ask.findOWLClassExpression(klass), "Find class expression " << klass);
+    BOOST_REQUIRE_MESSAGE(ask.findOWLIndividual(instance), "Find individual " << instance);
+    BOOST_REQUIRE_MESSAGE(ask.findOWLObjectProperty(property), "Find object property " << property);
+
+    BOOST_REQUIRE_MESSAGE(!ask.findOWLClass(unknown), "No class " << unknown);
+    BOOST_REQUIRE_MESSAGE(!ask.findOWLClassExpression(unknown), "No class expression " << unknown);
+    BOOST_REQUIRE_MESSAGE(!ask.findOWLIndividual(unknown), "No individual " << unknown);
+    BOOST_REQUIRE_MESSAGE(!ask.findOWLDataProperty(property), "No data property " << property);
+
+    BOOST_REQUIRE_MESSAGE(ask.isObjectProperty(property), "Is object property " << property);
+    BOOST_REQUIRE_MESSAGE(!ask.isDataProperty(property), "Is not a data property " << property);
+    BOOST_REQUIRE_MESSAGE(!ask.isOWLIndividual(unknown), "Is not an individual " << unknown);
+    BOOST_REQUIRE_THROW(ask.getOWLClass(unknown), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(query_cache_invalidation)
+{
+    OWLOntology::Ptr ontology = make_shared<OWLOntology>();
+    OWLOntologyAsk ask(ontology);
+    OWLOntologyTell tell(ontology);
+    QueryCache& cache = ontology->getQueryCache();
+
+    IRI base("http://my-classes#base");
+    IRI derived("http://my-classes#derived");
+    IRI other("http://my-classes#other");
+    IRI fork("http://my-classes#fork");
+    IRI instance("http://my-classes#derived-instance");
+
+    tell.klass(base);
+    tell.klass(derived);
+    tell.klass(other);
+    tell.klass(fork);
+    tell.subClassOf(derived, base);
+
+    OWLObjectProperty::Ptr has = tell.objectProperty(IRI("http://my-classes#has"));
+    OWLObjectProperty::Ptr uses = tell.objectProperty(IRI("http://my-classes#uses"));
+    tell.subClassOf(base, tell.objectCardinalityRestriction(has, 2, tell.klass(fork), OWLCardinalityRestriction::MIN));
+
+    BOOST_REQUIRE_MESSAGE(ask.getCardinalityRestrictions(derived).size() == 1, "Inherited restriction");
+    BOOST_REQUIRE_MESSAGE(ask.getCardinalityRestrictions(other).empty(), "No restriction");
+
+    // Assertions do not affect cached restrictions
+    tell.instanceOf(instance, derived);
+    BOOST_REQUIRE_MESSAGE(cache.getCardinalityRestrictions(derived, IRI()).second, "Restrictions of " << derived << " remain cached");
+    BOOST_REQUIRE_MESSAGE(cache.getCardinalityRestrictions(other, IRI()).second, "Restrictions of " << other << " remain cached");
+
+    // Changing a class invalidates only the results derived from it
+    tell.subClassOf(base, tell.objectCardinalityRestriction(uses, 1, tell.klass(fork), OWLCardinalityRestriction::MAX));
+    BOOST_REQUIRE_MESSAGE(!cache.getCardinalityRestrictions(derived, IRI()).second, "Restrictions of " << derived << " invalidated");
+    BOOST_REQUIRE_MESSAGE(cache.getCardinalityRestrictions(other, IRI()).second, "Restrictions of " << other << " remain cached");
+    BOOST_REQUIRE_MESSAGE(cache.getStatistics().invalidations == 1, "One entry invalidated");
+
+    BOOST_REQUIRE_MESSAGE(ask.getCardinalityRestrictions(derived).size() == 2, "Updated inherited restrictions");
+}
+
+BOOST_AUTO_TEST_CASE(cardinality_bounds)
+{
+    OWLOntology::Ptr ontology = make_shared<OWLOntology>();
+    OWLOntologyAsk ask(ontology);
+    OWLOntologyTell tell(ontology);
+    QueryCache& cache = ontology->getQueryCache();
+
+    IRI base("http://my-classes#base");
+    IRI derived("http://my-classes#derived");
+    IRI other("http://my-classes#other");
+    IRI fork("http://my-classes#fork");
+    IRI has("http://my-classes#has");
+
+    tell.klass(base);
+    tell.klass(derived);
+    tell.klass(other);
+    tell.klass(fork);
+    tell.subClassOf(derived, base);
+
+    OWLObjectProperty::Ptr hasProperty = tell.objectProperty(has);
+    tell.subClassOf(base, tell.objectCardinalityRestriction(hasProperty, 3, tell.klass(fork), OWLCardinalityRestriction::MAX));
+
+    BOOST_REQUIRE_MESSAGE(ask.compileCardinalityBounds() >= 4, "Bounds compiled for all classes");
+    BOOST_REQUIRE_MESSAGE(cache.getCardinalityBounds(derived, has).second, "Bounds of " << derived << " available");
+    BOOST_REQUIRE_MESSAGE(cache.getCardinalityBounds(other, has).second, "Bounds of " << other << " available");
+
+    QueryCache::CardinalityBounds bounds = ask.getCardinalityBounds(derived, has);
+    BOOST_REQUIRE_MESSAGE(bounds.size() == 1 && bounds[fork] == OWLCardinalityRestriction::MinMax(0,3), "Inherited bounds");
+    BOOST_REQUIRE_MESSAGE(ask.getCardinalityBounds(other, has).empty(), "No bounds for " << other);
+
+    // Only the entries derived from a changed class are refreshed
+    tell.subClassOf(derived, tell.objectCardinalityRestriction(hasProperty, 1, tell.klass(fork), OWLCardinalityRestriction::MAX));
+    BOOST_REQUIRE_MESSAGE(!cache.getCardinalityBounds(derived, has).second, "Bounds of " << derived << " outdated");
+    BOOST_REQUIRE_MESSAGE(cache.getCardinalityBounds(other, has).second, "Bounds of " << other << " remain available");
+
+    bounds = ask.getCardinalityBounds(derived, has);
+    BOOST_REQUIRE_MESSAGE(bounds.size() == 1 && bounds[fork] == OWLCardinalityRestriction::MinMax(0,1), "Updated bounds");
+}
+
+BOOST_AUTO_TEST_CASE(hash_consed_class_expressions)
+{
+    OWLOntology::Ptr ontology = make_shared<OWLOntology>();
+    OWLOntologyAsk ask(ontology);
+    OWLOntologyTell tell(ontology);
+
+    IRI car("http://my-classes#car");
+    IRI wheel("http://my-classes#wheel");
+    IRI door("http://my-classes#door");
+    IRI hasPart("http://my-classes#hasPart");
+
+    tell.klass(car);
+    tell.klass(wheel);
+    tell.klass(door);
+    OWLObjectProperty::Ptr hasPartProperty = tell.objectProperty(hasPart);
+
+    OWLCardinalityRestriction::Ptr restriction = tell.objectCardinalityRestriction(hasPartProperty, 2, tell.klass(wheel), OWLCardinalityRestriction::MIN);
+    BOOST_REQUIRE_MESSAGE(restriction == tell.objectCardinalityRestriction(hasPartProperty, 2, tell.klass(wheel), OWLCardinalityRestriction::MIN),
+            "Structurally equal restrictions are the same instance");
+    BOOST_REQUIRE_MESSAGE(restriction != tell.objectCardinalityRestriction(hasPartProperty, 3, tell.klass(wheel), OWLCardinalityRestriction::MIN),
+            "Restrictions with different cardinality are distinct");
+    BOOST_REQUIRE_MESSAGE(restriction->clone() != restriction, "Clones are not interned");
+    BOOST_REQUIRE_MESSAGE(restriction->isShared() && !restriction->clone()->isShared(), "Only interned restrictions are shared");
+    BOOST_REQUIRE_THROW(restriction->setCardinality(3), std::runtime_error);
+    OWLCardinalityRestriction::Ptr modified = restriction->clone();
+    modified->setCardinality(3);
+    BOOST_REQUIRE_MESSAGE(restriction->getCardinality() == 2 && modified->getCardinality() == 3, "Clone can be modified");
+
+    weak_ptr<OWLCardinalityRestriction> transient = tell.objectCardinalityRestriction(hasPartProperty, 5, tell.klass(wheel), OWLCardinalityRestriction::MIN);
+    BOOST_REQUIRE_MESSAGE(transient.expired(), "Pool does not keep restrictions which are no longer in use");
+
+    OWLCardinalityRestriction::Ptr unqualified = tell.objectCardinalityRestriction(hasPartProperty, 2, OWLClassExpression::Ptr(), OWLCardinalityRestriction::MIN);
+    BOOST_REQUIRE_MESSAGE(unqualified == tell.objectCardinalityRestriction(hasPartProperty, 2, OWLClassExpression::Ptr(), OWLCardinalityRestriction::MIN),
+            "Structurally equal unqualified restrictions are the same instance");
+    BOOST_REQUIRE_MESSAGE(unqualified != restriction, "Unqualified and qualified restrictions are distinct");
+
+    IRIList parts = { wheel, door };
+    IRIList reversedParts = { door, wheel };
+    OWLClassExpression::Ptr intersection = tell.objectIntersectionOf(IRI("http://my-classes#intersection-0"), parts);
+    BOOST_REQUIRE_MESSAGE(intersection == tell.objectIntersectionOf(IRI("http://my-classes#intersection-1"), reversedParts),
+            "Structurally equal intersections are the same instance");
+    BOOST_REQUIRE_MESSAGE(intersection != tell.objectUnionOf(IRI("http://my-classes#union-0"), parts),
+            "Union and intersection are distinct");
+    BOOST_REQUIRE_MESSAGE(ask.getOWLClassExpressionIRI(intersection) == IRI("http://my-classes#intersection-0"),
+            "Expression keeps the iri it has been registered with first");
+    OWLClassExpression::Ptr copy = make_shared<OWLObjectIntersectionOf>(
+            OWLClassExpression::PtrList({ ask.getOWLClass(door), ask.getOWLClass(wheel) }));
+    BOOST_REQUIRE_MESSAGE(copy != intersection && ask.getOWLClassExpressionIRI(copy) == IRI("http://my-classes#intersection-0"),
+            "Structurally equal copy is found by its registered iri");
+    OWLCardinalityRestriction::Ptr anonymousFiller = tell.objectCardinalityRestriction(hasPartProperty, 1, intersection, OWLCardinalityRestriction::MIN);
+    BOOST_REQUIRE_MESSAGE(anonymousFiller == tell.objectCardinalityRestriction(hasPartProperty, 1, copy, OWLCardinalityRestriction::MIN),
+            "Restrictions with structurally equal anonymous fillers are the same instance");
+    BOOST_REQUIRE_THROW(ask.getOWLClassExpressionIRI(restriction), std::runtime_error);
+    BOOST_REQUIRE_THROW(ask.getOWLClassExpressionIRI(restriction->clone()), std::runtime_error);
+
+    OWLClassExpression::Ptr complement = tell.objectComplementOf(IRI("http://my-classes#complement-0"), wheel);
+    BOOST_REQUIRE_MESSAGE(complement->getClassExpressionType() == OWLClassExpression::OBJECT_COMPLEMENT_OF, "Complement registered");
+    BOOST_REQUIRE_MESSAGE(complement == tell.objectComplementOf(IRI("http://my-classes#complement-1"), wheel),
+            "Structurally equal complements are the same instance");
+    BOOST_REQUIRE_MESSAGE(complement != tell.objectComplementOf(IRI("http://my-classes#complement-2"), door),
+            "Complements of different classes are distinct");
+
+    OWLAnonymousClassExpression::Ptr anonymous = tell.anonymousClass(IRI("http://my-classes#anonymous-0"));
+    BOOST_REQUIRE_MESSAGE(anonymous == tell.anonymousClass(IRI("http://my-classes#anonymous-0")),
+            "Anonymous class is the registered instance");
+}
+
 BOOST_AUTO_TEST_CASE(equivalence)
 {
     OWLOntology::Ptr ontology = make_shared<OWLOntology>();
@@ -262,6 +527,124 @@ BOOST_AUTO_TEST_CASE(equivalence)
             " is subclass of equivalent class");
 }
 
+BOOST_AUTO_TEST_CASE(equivalence_and_annotation_index)
+{
+    OWLOntology::Ptr ontology = make_shared<OWLOntology>();
+    OWLOntologyAsk ask(ontology);
+    OWLOntologyTell tell(ontology);
+
+    IRI klass0("http://my-classes#class-0");
+    IRI klass1("http://my-classes#class-1");
+    IRI klass2("http://my-classes#class-2");
+    IRI property("http://my-classes#annotation");
+    IRI value("http://my-classes#value");
+
+    tell.klass(klass0);
+    tell.klass(klass1);
+    tell.klass(klass2);
+    tell.equalClasses({klass0, klass1});
+    tell.equalClasses({klass0, klass2});
+
+    BOOST_REQUIRE_EQUAL(ask.allEquivalentClassExpressions(klass0).size(), 2);
+    OWLClassExpression::PtrList equivalentClasses = ask.allEquivalentClassExpressions(klass1);
+    BOOST_REQUIRE_EQUAL(equivalentClasses.size(), 1);
+    BOOST_REQUIRE(equivalentClasses[0] == ask.getOWLClass(klass0));
+
+    tell.annotationProperty(property);
+    size_t referencingAxioms = ontology->getReferencingAxioms(OWLEntity::annotationProperty(property), false).size();
+    tell.annotationOf(klass0, property, value);
+    BOOST_REQUIRE_EQUAL(ask.getAnnotationValue(klass0, property)->asIRI(), value);
+    BOOST_REQUIRE_THROW(ask.getAnnotationValue(klass1, property), std::invalid_argument);
+    BOOST_REQUIRE_EQUAL(ontology->getReferencingAxioms(OWLEntity::annotationProperty(property), false).size(), referencingAxioms + 1);
+
+    tell.removeAnnotationProperty(property);
+    BOOST_REQUIRE(!ask.getAnnotationValue(klass0, property));
+    BOOST_REQUIRE_EQUAL(ontology->getReferencingAxioms(OWLEntity::annotationProperty(property), false).size(), referencingAxioms);
+}
+
+BOOST_AUTO_TEST_CASE(properties_for_domain)
+{
+    OWLOntology::Ptr ontology = make_shared<OWLOntology>();
+    OWLOntologyAsk ask(ontology);
+    OWLOntologyTell tell(ontology);
+
+    IRI base("http://my-classes#base");
+    IRI derived("http://my-classes#derived");
+    IRI other("http://my-classes#other");
+    IRI has("http://my-classes#has");
+    IRI mass("http://my-classes#mass");
+    IRI uses("http://my-classes#uses");
+
+    tell.klass(base);
+    tell.klass(derived);
+    tell.klass(other);
+    tell.subClassOf(derived, base);
+    tell.objectProperty(has);
+    tell.objectPropertyDomainOf(has, base);
+    tell.dataProperty(mass);
+    tell.dataPropertyDomainOf(mass, base);
+    tell.dataPropertyDomainOf(mass, derived);
+
+    IRIList objectProperties = ask.getObjectPropertiesForDomain(derived);
+    BOOST_REQUIRE_MESSAGE(objectProperties.size() == 1 && objectProperties[0] == has,
+            "Object property applies to subclass of its domain");
+    IRIList dataProperties = ask.getDataPropertiesForDomain(derived);
+    BOOST_REQUIRE_MESSAGE(dataProperties.size() == 1 && dataProperties[0] == mass,
+            "Data property applies once to subclass of its domains");
+    BOOST_REQUIRE_MESSAGE(ask.getObjectPropertiesForDomain(other).empty(),
+            "Object property does not apply to unrelated class");
+    BOOST_REQUIRE_MESSAGE(ask.getDataPropertiesForDomain(other).empty(),
+            "Data property does not apply to unrelated class");
+
+    // Changes of the property domains are reflected
+    tell.objectProperty(uses);
+    tell.objectPropertyDomainOf(uses, other);
+    objectProperties = ask.getObjectPropertiesForDomain(other);
+    BOOST_REQUIRE_MESSAGE(objectProperties.size() == 1 && objectProperties[0] == uses,
+            "Object property applies to new domain");
+    BOOST_REQUIRE_MESSAGE(ask.getObjectPropertiesForDomain(derived).size() == 1,
+            "Object property does not apply to other domain");
+}
+
+BOOST_AUTO_TEST_CASE(subclasses_with_distance)
+{
+    OWLOntology::Ptr ontology = make_shared<OWLOntology>();
+    OWLOntologyAsk ask(ontology);
+    OWLOntologyTell tell(ontology);
+
+    IRI root("http://my-classes#root");
+    IRI left("http://my-classes#left");
+    IRI right("http://my-classes#right");
+    IRI joint("http://my-classes#joint");
+    IRI leaf("http://my-classes#leaf");
+
+    // Diamond: leaf is reachable from root through left and right, but also
+    // via the longer path through joint
+    for(const IRI& klass : { root, left, right, joint, leaf })
+    {
+        tell.klass(klass);
+    }
+    tell.subClassOf(left, root);
+    tell.subClassOf(right, root);
+    tell.subClassOf(joint, left);
+    tell.subClassOf(leaf, joint);
+    tell.subClassOf(leaf, right);
+
+    std::vector<IRIList> levels = ask.allSubClassesOfWithDistance(root, true);
+    BOOST_REQUIRE_MESSAGE(levels.size() == 3, "Two levels of subclasses, terminated by empty list, got: " << levels.size());
+    BOOST_REQUIRE_MESSAGE(levels[0].size() == 2, "Direct subclasses: " << levels[0]);
+    BOOST_REQUIRE_MESSAGE(levels[1].size() == 2, "Subclasses at distance 1: " << levels[1]);
+    BOOST_REQUIRE_MESSAGE(levels[2].empty(), "Terminating empty list");
+
+    levels = ask.allSubClassesOfWithDistance(root);
+    BOOST_REQUIRE_MESSAGE(levels.size() == 4, "All paths listed, got: " << levels.size());
+    BOOST_REQUIRE_MESSAGE(levels[2].size() == 1 && levels[2][0] == leaf, "Subclasses at distance 2: " << levels[2]);
+
+    IRIList leaves = ask.allUnderivedSubClassesOf(root);
+    BOOST_REQUIRE_MESSAGE(leaves.size() == 1 && leaves[0] == leaf, "Leaves: " << leaves);
+    BOOST_REQUIRE_MESSAGE(ask.allUnderivedSubClassesOf(leaf).empty(), "Leaf has no underived subclasses");
+}
+
 BOOST_AUTO_TEST_CASE(ancestors)
 {
     OWLOntology::Ptr ontology = make_shared<OWLOntology>();
@@ -331,6 +714,129 @@ BOOST_AUTO_TEST_CASE(ranges)
     BOOST_REQUIRE_NO_THROW( tell.valueOf(instance, subproperty1, value) );
 }
 
+BOOST_AUTO_TEST_CASE(data_values)
+{
+    OWLOntology::Ptr ontology = make_shared<OWLOntology>();
+    OWLOntologyAsk ask(ontology);
+    OWLOntologyTell tell(ontology);
+
+    IRI klass("http://my-classes#class");
+    IRI instance("http://my-classes/#instance");
+    IRI otherInstance("http://my-classes/#otherInstance");
+    IRI property("http://my-classes/#property");
+
+    tell.klass(klass);
+    tell.instanceOf(instance, klass);
+    tell.instanceOf(otherInstance, klass);
+    tell.dataProperty(property);
+    tell.functionalDataProperty(property);
+
+    for(int i = 0; i < 10; ++i)
+    {
+        OWLLiteral::Ptr value = OWLLiteral::create(std::to_string(i), owlapi::vocabulary::XSD::resolve("double"));
+        tell.valueOf(instance, property, value);
+        BOOST_REQUIRE_EQUAL(ask.getDataValue(instance, property)->getValue(), std::to_string(i));
+    }
+    BOOST_REQUIRE_EQUAL(ontology->getAxiomMap().at(OWLAxiom::DataPropertyAssertion).size(), 1);
+
+    IRISet properties = ask.getRelatedDataProperties(instance);
+    BOOST_REQUIRE_MESSAGE(properties.size() == 1 && properties.count(property), "Related data properties: " << IRIList(properties.begin(), properties.end()));
+    BOOST_REQUIRE(ask.getRelatedDataProperties(otherInstance).empty());
+    BOOST_REQUIRE_THROW(ask.getDataValue(otherInstance, property), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(axiom_deduplication)
+{
+    OWLOntology::Ptr ontology = make_shared<OWLOntology>();
+    OWLOntologyTell tell(ontology);
+
+    IRI klass("http://my-classes#class");
+    IRI otherKlass("http://my-classes#otherClass");
+    IRI instance("http://my-classes/#instance");
+
+    OWLClassAssertionAxiom::Ptr axiom = tell.instanceOf(instance, klass);
+    tell.instanceOf(instance, klass);
+    tell.instanceOf(instance, otherKlass);
+    const AxiomIndex<>& assertions = ontology->getAxiomMap().at(OWLAxiom::ClassAssertion);
+    BOOST_REQUIRE_EQUAL(assertions.size(), 2);
+    BOOST_REQUIRE(*assertions.begin() == axiom);
+
+    OWLAxiom::Ptr duplicate = make_shared<OWLClassAssertionAxiom>(make_shared<OWLNamedIndividual>(instance),
+            make_shared<OWLClass>(klass));
+    BOOST_REQUIRE(duplicate->isStructurallyEqual(*axiom));
+    BOOST_REQUIRE_EQUAL(duplicate->getStructuralHash(), axiom->getStructuralHash());
+    BOOST_REQUIRE(tell.addAxiom(duplicate) == axiom);
+    BOOST_REQUIRE_EQUAL(assertions.size(), 2);
+    BOOST_REQUIRE(assertions.find(*duplicate) == axiom);
+}
+
+BOOST_AUTO_TEST_CASE(tell_batch)
+{
+    OWLOntology::Ptr ontology = make_shared<OWLOntology>();
+    OWLOntologyAsk ask(ontology);
+    OWLOntologyTell tell(ontology);
+
+    IRI klass("http://my-classes#class");
+    IRI relation("http://my-classes#relation");
+    IRI property("http://my-classes#property");
+    IRI instance0("http://my-classes/#instance-0");
+    IRI instance1("http://my-classes/#instance-1");
+
+    tell.klass(klass);
+    tell.objectProperty(relation);
+    tell.dataProperty(property);
+    tell.instanceOf(instance0, klass);
+
+    OWLOntologyTellBatch batch(ontology);
+    batch.reserve(6);
+    batch.relatedTo(instance1, relation, instance0);
+    batch.instanceOf(instance0, klass);
+    batch.instanceOf(instance1, klass);
+    batch.instanceOf(instance1, klass);
+    batch.valueOf(instance1, property, OWLLiteral::create("1.0", owlapi::vocabulary::XSD::resolve("double")));
+    batch.valueOf(instance1, property, OWLLiteral::create("2.0", owlapi::vocabulary::XSD::resolve("double")));
+    BOOST_REQUIRE_EQUAL(batch.size(), 6);
+
+    // class assertion of instance-1, relation and the last value
+    OWLAxiom::PtrList axioms = batch.commit();
+    BOOST_REQUIRE_EQUAL(axioms.size(), 3);
+    BOOST_REQUIRE(batch.empty());
+    BOOST_REQUIRE(ask.isInstanceOf(instance1, klass));
+    BOOST_REQUIRE(ask.isRelatedTo(instance1, relation, instance0));
+    BOOST_REQUIRE_EQUAL(ask.getDataValue(instance1, property)->getDouble(), 2.0);
+
+    batch.relatedTo(instance1, IRI("http://my-classes#unknown"), instance0);
+    BOOST_REQUIRE_THROW(batch.commit(), std::invalid_argument);
+    BOOST_REQUIRE_EQUAL(batch.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(referencing_axioms)
+{
+    OWLOntology::Ptr ontology = make_shared<OWLOntology>();
+    OWLOntologyAsk ask(ontology);
+    OWLOntologyTell tell(ontology);
+
+    IRI klass("http://my-classes#class");
+    IRI otherKlass("http://my-classes#otherClass");
+    IRI instance("http://my-classes/#instance");
+    IRI intersection("http://my-classes/#intersection");
+
+    tell.subClassOf(klass, otherKlass);
+    tell.instanceOf(instance, klass);
+
+    // declaration, subclass and class assertion
+    BOOST_REQUIRE_EQUAL(ontology->getReferencingAxioms(OWLEntity::klass(klass), false).size(), 3);
+    BOOST_REQUIRE_EQUAL(ontology->getReferencingAxioms(OWLEntity::klass(otherKlass), false).size(), 2);
+    BOOST_REQUIRE(ontology->getReferencingAxioms(OWLEntity::namedIndividual(klass), false).empty());
+
+    tell.removeIndividual(instance);
+    BOOST_REQUIRE_EQUAL(ontology->getReferencingAxioms(OWLEntity::klass(klass), false).size(), 2);
+
+    OWLClassExpression::Ptr expression = tell.objectIntersectionOf(intersection, { klass, otherKlass });
+    BOOST_REQUIRE_EQUAL(ask.getOWLClassExpressionIRI(expression), intersection);
+    BOOST_REQUIRE_EQUAL(ask.getOWLClassExpressionIRI(ask.getOWLClass(klass)), klass);
+}
+
 BOOST_AUTO_TEST_CASE(turtle_value_types)
 {
     std::string filename =  getRootDir() +
@@ -468,4 +974,88 @@ BOOST_AUTO_TEST_CASE(object_restriction_equivalence)
     }
 }
 
+BOOST_AUTO_TEST_CASE(load_unqualified_restrictions)
+{
+    // Restrictions without a qualification are indexed by their structural
+    // key as well
+    for(const std::string& file : { "test-object-restrictions-components.ttl", "test-object-cardinality.ttl" })
+    {
+        OWLOntology::Ptr ontology;
+        BOOST_REQUIRE_NO_THROW(ontology = OWLOntology::fromFile(getRootDir() + "/test/data/" + file));
+        BOOST_REQUIRE_MESSAGE(!ontology->getAxioms().empty(), "Axioms loaded from " << file);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(query_cache)
+{
+    QueryCache cache(4);
+    IRI klass("http://my-classes#class-0");
+
+    for(size_t i = 0; i < 8; ++i)
+    {
+        IRI otherKlass("http://my-classes#other-class-" + std::to_string(i));
+        BOOST_REQUIRE_MESSAGE(!cache.isSubClassOf(klass, otherKlass).second, "Result not cached yet");
+        cache.cacheIsSubClassOf(klass, otherKlass, i%2 == 0);
+    }
+
+    QueryCache::Statistics statistics = cache.getStatistics();
+    BOOST_REQUIRE_MESSAGE(statistics.misses == 8, "Cache misses: " << statistics.misses);
+    BOOST_REQUIRE_MESSAGE(statistics.entries <= 4, "Cache entries bounded: " << statistics.entries);
+    BOOST_REQUIRE_MESSAGE(statistics.evictions == 8 - statistics.entries, "Cache evictions: " << statistics.evictions);
+
+    cache.cacheIsSubClassOf(klass, klass, true);
+    std::pair<bool,bool> result = cache.isSubClassOf(klass, klass);
+    BOOST_REQUIRE_MESSAGE(result.second && result.first, "Result cached");
+    BOOST_REQUIRE_MESSAGE(cache.getStatistics().hits == 1, "Cache hit");
+
+    cache.clear();
+    BOOST_REQUIRE_MESSAGE(!cache.isSubClassOf(klass, klass).second, "Subclass cache cleared");
+    BOOST_REQUIRE_MESSAGE(cache.getStatistics().entries == 0, "Cache is empty");
+
+    // Entities are only tracked while cached results depend on them
+    IRI otherKlass;
+    for(size_t i = 0; i < 1000; ++i)
+    {
+        otherKlass = IRI("http://my-classes#other-class-" + std::to_string(i));
+        cache.cacheIsSubClassOf(klass, otherKlass, true, QueryCache::Dependencies({ otherKlass }));
+    }
+    BOOST_REQUIRE_MESSAGE(cache.getNumberOfDependencies() <= 64, "Tracked dependencies bounded: " << cache.getNumberOfDependencies());
+    BOOST_REQUIRE_MESSAGE(cache.isSubClassOf(klass, otherKlass).second, "Most recent result cached");
+    cache.invalidate({ otherKlass });
+    BOOST_REQUIRE_MESSAGE(!cache.isSubClassOf(klass, otherKlass).second, "Result invalidated by its dependency");
+    cache.clear();
+
+    {
+        // Least recently used entry is evicted first
+        ShardedLRUCache<int, int> lru(2, 1);
+        int value = 0;
+        lru.put(0, 0);
+        lru.put(1, 1);
+        BOOST_REQUIRE(lru.get(0, value));
+        lru.put(2, 2);
+        BOOST_REQUIRE_MESSAGE(lru.size() == 2, "Cache size bounded: " << lru.size());
+        BOOST_REQUIRE_MESSAGE(!lru.get(1, value), "Least recently used entry evicted");
+        BOOST_REQUIRE(lru.get(0, value) && value == 0);
+        BOOST_REQUIRE(lru.get(2, value) && value == 2);
+        BOOST_REQUIRE(lru.getStatistics().evictions == 1);
+    }
+
+    {
+        // The limit holds even if it is smaller than the number of shards
+        ShardedLRUCache<int, int> lru(4, 16);
+        int value = 0;
+        for(int i = 0; i < 64; ++i)
+        {
+            lru.put(i, i);
+        }
+        BOOST_REQUIRE_MESSAGE(lru.size() == 4, "Cache size bounded: " << lru.size());
+        BOOST_REQUIRE(lru.get(63, value) && value == 63);
+
+        lru.setMaxEntries(2);
+        BOOST_REQUIRE_MESSAGE(lru.size() <= 2, "Cache size bounded: " << lru.size());
+        lru.put(64, 64);
+        BOOST_REQUIRE(lru.get(64, value) && value == 64);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -3,6 +3,8 @@
 #include <owlapi/model/OWLOntology.hpp>
 #include <owlapi/db/rdf/Sparql.hpp>
 #include <owlapi/db/rdf/Redland.hpp>
+#include <owlapi/db/rdf/TripleStore.hpp>
+#include <owlapi/io/RedlandReader.hpp>
 #include "test_utils.hpp"
 #include <boost/mpl/list.hpp>
 
@@ -28,7 +30,7 @@ BOOST_AUTO_TEST_CASE(query_turtle)
             .endWhere();
 
         db::query::Results results = db.query(query.toString(), query.getBindings());
-        BOOST_REQUIRE_MESSAGE(results.rows.size() == 7, "Results retrieved count: " << results.rows.size()
+        BOOST_REQUIRE_MESSAGE(results.size() == 7, "Results retrieved count: " << results.size()
                 << results.toString());
     }
 
@@ -36,7 +38,7 @@ BOOST_AUTO_TEST_CASE(query_turtle)
         db::query::Results results = db.findAll(db::query::Subject(),
                 db::query::Predicate(),
                 db::query::Object());
-        BOOST_REQUIRE_MESSAGE(results.rows.size() == 15, "Results retrieved count: " << results.rows.size()
+        BOOST_REQUIRE_MESSAGE(results.size() == 15, "Results retrieved count: " << results.size()
                 << results.toString());
     }
 }
@@ -54,7 +56,7 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(query_rdfxml, T, dbTypes)
             .endWhere();
 
         db::query::Results results = db.query(query.toString(), query.getBindings());
-        BOOST_REQUIRE_MESSAGE(results.rows.size() == 7, "Results retrieved count: " << results.rows.size()
+        BOOST_REQUIRE_MESSAGE(results.size() == 7, "Results retrieved count: " << results.size()
                 << results.toString());
     }
 
@@ -62,7 +64,7 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(query_rdfxml, T, dbTypes)
         db::query::Results results = db.findAll(db::query::Subject(),
                 db::query::Predicate(),
                 db::query::Object());
-        BOOST_REQUIRE_MESSAGE(results.rows.size() == 15, "Results retrieved count: " << results.rows.size()
+        BOOST_REQUIRE_MESSAGE(results.size() == 15, "Results retrieved count: " << results.size()
                 << results.toString());
     }
 }
@@ -82,7 +84,7 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(query, T, dbTypes)
     //prefix += "PREFIX rdfs: <" + vocabulary::RDFS::BaseUri() + ">\n";
 
     //db::query::Results results = db.query(prefix + " select ?s where { ?s rdf:type owl:Class . }", bindings);
-    //BOOST_REQUIRE_MESSAGE(results.rows.size() != 0, "Results retrieved");
+    //BOOST_REQUIRE_MESSAGE(results.size() != 0, "Results retrieved");
 
 
     { // unsupported query paths
@@ -98,7 +100,7 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(query, T, dbTypes)
     //    query += " SELECT ?subject ?type \n";
     //    query += " WHERE { ?subject rdf:type/rdfs:subClassOf* ?type }" ;
     //    db::query::Results results = db.query(query, bindings);
-    //    BOOST_REQUIRE_MESSAGE(results.rows.size() != 0, "Results retrieved count: " << results.rows.size());
+    //    BOOST_REQUIRE_MESSAGE(results.size() != 0, "Results retrieved count: " << results.size());
     }
 
     { // unsupported query paths
@@ -116,7 +118,7 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(query, T, dbTypes)
     //    query += "     ?subject !rdf:type owl:Class .\n";
     //    query += " }";
     //    db::query::Results results = db.query(query, bindings);
-    //    BOOST_REQUIRE_MESSAGE(results.rows.size() != 0, "Filter results retrieved count: " << results.rows.size());
+    //    BOOST_REQUIRE_MESSAGE(results.size() != 0, "Filter results retrieved count: " << results.size());
     }
 
     {
@@ -130,7 +132,7 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(query, T, dbTypes)
 
         BOOST_TEST_MESSAGE("Display query: " << query.toString() );
         db::query::Results results = db.query(query.toString(), query.getBindings());
-        BOOST_REQUIRE_MESSAGE(results.rows.size() != 0, "Results retrieved count: " << results.rows.size()
+        BOOST_REQUIRE_MESSAGE(results.size() != 0, "Results retrieved count: " << results.size()
                 << results.toString());
     }
 
@@ -143,7 +145,7 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(query, T, dbTypes)
 
         BOOST_TEST_MESSAGE("Display query: " << query.toString() );
         db::query::Results results = db.query(query.toString(), query.getBindings());
-        BOOST_REQUIRE_MESSAGE(results.rows.size() != 0, "NamedIndividuals retrieved count: " << results.rows.size()
+        BOOST_REQUIRE_MESSAGE(results.size() != 0, "NamedIndividuals retrieved count: " << results.size()
                 << results.toString());
 
         db::query::ResultsIterator it(results);
@@ -167,7 +169,7 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(query_anonymous_node, T, dbTypes)
 
         BOOST_TEST_MESSAGE("Display query: " << query.toString() );
         db::query::Results results = db.query(query.toString(), query.getBindings());
-        BOOST_REQUIRE_MESSAGE(results.rows.size() != 0, "NamedIndividuals retrieved count: " << results.rows.size());
+        BOOST_REQUIRE_MESSAGE(results.size() != 0, "NamedIndividuals retrieved count: " << results.size());
 
         db::query::ResultsIterator it(results);
         while(it.next())
@@ -189,7 +191,7 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(query_anonymous_node, T, dbTypes)
 
         BOOST_TEST_MESSAGE("Display query: " << query.toString() );
         db::query::Results results = db.query(query.toString(), query.getBindings());
-        BOOST_REQUIRE_MESSAGE(results.rows.size() != 0, "Result count: " << results.rows.size());
+        BOOST_REQUIRE_MESSAGE(results.size() != 0, "Result count: " << results.size());
 
         db::query::ResultsIterator it(results);
         while(it.next())
@@ -200,5 +202,72 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(query_anonymous_node, T, dbTypes)
     }
 }
 
+BOOST_AUTO_TEST_CASE(triple_store)
+{
+    {
+        db::TripleStore store;
+        io::RedlandReader reader;
+        reader.read(getRootDir() + "test/data/test-turtle-value_types.ttl", store);
+        BOOST_REQUIRE_MESSAGE(store.size() == 15, "Triple store has read model in turtle syntax");
+
+        db::rdf::sparql::Query query;
+        query.select(db::query::Subject()).select(db::query::Any("type")) \
+            .beginWhere() \
+                .triple(db::query::Subject(),vocabulary::RDF::type(), db::query::Any("type")) \
+            .endWhere();
+
+        db::query::Results results = store.query(query);
+        BOOST_REQUIRE_MESSAGE(results.size() == 7, "Results retrieved count: " << results.size()
+                << results.toString());
+
+        results = store.findAll(db::query::Subject(), db::query::Predicate(), db::query::Object());
+        BOOST_REQUIRE_MESSAGE(results.size() == 15, "Results retrieved count: " << results.size()
+                << results.toString());
+    }
+
+    {
+        IRI a("http://www.rock-robotics.org/test#A");
+        IRI b("http://www.rock-robotics.org/test#B");
+        IRI c("http://www.rock-robotics.org/test#C");
+
+        db::TripleStore store;
+        BOOST_REQUIRE(store.add(a, vocabulary::RDFS::subClassOf(), b));
+        BOOST_REQUIRE_MESSAGE(!store.add(a, vocabulary::RDFS::subClassOf(), b), "Duplicate triple is ignored");
+        BOOST_REQUIRE(store.add(b, vocabulary::RDFS::subClassOf(), c));
+        BOOST_REQUIRE_EQUAL(store.size(), 2);
+        BOOST_REQUIRE_EQUAL(store.getNumberOfTerms(), 4);
+
+        db::query::Variable x("x", false);
+        db::query::Variable y("y", false);
+        db::query::Variable z("z", false);
+        db::rdf::sparql::Query query;
+        query.select(x).select(z) \
+            .beginWhere() \
+                .triple(y, vocabulary::RDFS::subClassOf(), z) \
+                .triple(x, vocabulary::RDFS::subClassOf(), y) \
+            .endWhere();
+
+        db::query::Results results = store.query(query);
+        BOOST_REQUIRE_MESSAGE(results.size() == 1, "Results retrieved count: " << results.size()
+                << results.toString());
+        db::query::ResultsIterator it(results);
+        BOOST_REQUIRE(it.next());
+        BOOST_REQUIRE_EQUAL(it[x], a);
+        BOOST_REQUIRE_EQUAL(it[z], c);
+
+        // Terms of existing results remain valid while the store grows
+        const IRI& term = it[x];
+        for(size_t i = 0; i < 1000; ++i)
+        {
+            store.add(IRI("http://www.rock-robotics.org/test#D" + std::to_string(i)), vocabulary::RDFS::subClassOf(), c);
+        }
+        BOOST_REQUIRE_EQUAL(term, a);
+        BOOST_REQUIRE_EQUAL(it[x], a);
+
+        results = store.findAll(c, vocabulary::RDFS::subClassOf(), db::query::Object());
+        BOOST_REQUIRE_MESSAGE(results.empty(), "No superclass for C");
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 